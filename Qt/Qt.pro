@@ -14,6 +14,12 @@ SOURCES += \
 
 HEADERS += \
     ../set.hpp \
+    ../raw_storage.hpp \
+    ../growth_policy.hpp \
+    ../hash.hpp \
+    ../hash_index.hpp \
+    ../cuckoo_filter.hpp \
+    ../simd.hpp \
     mainwindow.h
 
 FORMS += \
@@ -0,0 +1,612 @@
+/**
+ * @file bench.cpp
+ *
+ * @brief Benchmarks of the union and intersection of the templated Set class.
+ *
+ * Compares operator+ and operator- with the nested loop versions they
+ * replaced, which searched every element of one Set in the other one, and
+ * with their parallel counterparts (see parallel.hpp), and contains() of
+ * arithmetic elements and filter_out() of numeric Sets with the scalar loops
+ * the SIMD kernels replace (see simd.hpp), many tiny Sets with SmallSets (see
+ * small_set.hpp), dense integer Sets with BitSets (see bit_set.hpp), and
+ * sparse 32 bit ids with RoaringSets (see roaring_set.hpp), and contains()
+ * lookups that mostly miss with and without the membership filter (see
+ * cuckoo_filter.hpp), and multi-threaded ingest into a HashSet behind a
+ * global mutex and into a ConcurrentSet (see concurrent_set.hpp), and the
+ * algebra of Sets and ShardedSets (see sharded_set.hpp), and lookups in a
+ * HashSet behind a global mutex and in an RcuSet (see rcu_set.hpp) while a
+ * writer keeps publishing new versions, and keeping many versions of a Set,
+ * each one a copy of the previous one plus an element, with PersistentSets
+ * (see persistent_set.hpp), and copies of a Set that are never changed, with
+ * an element by element copy and with the copy on write array of Set.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include "set.hpp"
+#include "parallel.hpp"
+#include "small_set.hpp"
+#include "bit_set.hpp"
+#include "roaring_set.hpp"
+#include "concurrent_set.hpp"
+#include "hash_set.hpp"
+#include "sharded_set.hpp"
+#include "rcu_set.hpp"
+#include "persistent_set.hpp"
+
+typedef Set<int, std::equal_to<int>> intSet;
+typedef Set<std::string, std::equal_to<std::string>> stringSet;
+
+/**
+ * @brief Union computed by searching every element of 'b' in the result.
+*/
+template <typename S>
+S nested_union(const S& a, const S& b) {
+  S new_set = a;
+  for (typename S::const_iterator it = b.begin(); it != b.end(); ++it) {
+    new_set.add(*it);
+  }
+  return new_set;
+}
+
+/**
+ * @brief Intersection computed by searching every element of 'a' in 'b'.
+*/
+template <typename S>
+S nested_intersection(const S& a, const S& b) {
+  S new_set;
+  for (typename S::const_iterator it = a.begin(); it != a.end(); ++it) {
+    if (b.contains(*it)) {
+      new_set.add(*it);
+    }
+  }
+  return new_set;
+}
+
+/**
+ * @brief Runs a function and returns its duration in milliseconds.
+*/
+template <typename Function>
+double time_ms(Function f) {
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+/**
+ * @brief Prints one line of results.
+*/
+void report(const std::string& name, size_t na, size_t nb, double nested, double kernel) {
+  std::cout << std::left << std::setw(14) << name
+            << std::right << std::setw(8) << na << std::setw(8) << nb
+            << std::fixed << std::setprecision(2)
+            << std::setw(12) << nested << std::setw(12) << kernel
+            << std::setw(10) << nested / kernel << "x" << std::endl;
+}
+
+/**
+ * @brief Benchmarks two Sets sharing half of the elements of 'b'.
+*/
+template <typename S, typename Make>
+void bench(const std::string& type, size_t na, size_t nb, Make make) {
+  S a, b;
+  for (size_t i = 0; i < na; ++i) {
+    a.add(make(i * 2));
+  }
+  for (size_t i = 0; i < nb; ++i) {
+    b.add(make(i));
+  }
+
+  S expected, result;
+  double nested = time_ms([&]() { expected = nested_union(a, b); });
+  double kernel = time_ms([&]() { result = a + b; });
+  assert(result == expected);
+  report(type + " union", na, nb, nested, kernel);
+
+  nested = time_ms([&]() { expected = nested_intersection(a, b); });
+  kernel = time_ms([&]() { result = a - b; });
+  assert(result == expected);
+  report(type + " inter", na, nb, nested, kernel);
+}
+
+/**
+ * @brief Benchmarks the parallel algorithms against the sequential ones.
+*/
+template <typename S, typename Make>
+void bench_parallel(const std::string& type, size_t n, Make make) {
+  S a, b;
+  for (size_t i = 0; i < n; ++i) {
+    a.add_unchecked(make(i * 2));
+    b.add_unchecked(make(i));
+  }
+
+  ParallelPolicy policy;
+  S expected, result;
+  double sequential = time_ms([&]() { expected = a + b; });
+  double parallel = time_ms([&]() { result = unite(policy, a, b); });
+  assert(equals(policy, result, expected));
+  report(type + " union", n, n, sequential, parallel);
+
+  sequential = time_ms([&]() { expected = a - b; });
+  parallel = time_ms([&]() { result = intersection(policy, a, b); });
+  assert(equals(policy, result, expected));
+  report(type + " inter", n, n, sequential, parallel);
+}
+
+/**
+ * @brief Equality functor that keeps the Sets on the scalar loop.
+*/
+struct PlainEqual {
+  bool operator()(int a, int b) const { return a == b; }
+};
+
+/**
+ * @brief Benchmarks contains() with the scalar loop and the SIMD kernels.
+*/
+void bench_contains(size_t n) {
+  Set<int, PlainEqual> scalar;
+  intSet simd;
+  for (size_t i = 0; i < n; ++i) {
+    scalar.add_unchecked(static_cast<int>(i));
+    simd.add_unchecked(static_cast<int>(i));
+  }
+
+  const size_t lookups = 20000000 / n + 1;
+  size_t found_scalar = 0, found_simd = 0;
+  double plain = time_ms([&]() {
+    for (size_t i = 0; i < lookups; ++i) found_scalar += scalar.contains(static_cast<int>(i % (2 * n)));
+  });
+  double kernel = time_ms([&]() {
+    for (size_t i = 0; i < lookups; ++i) found_simd += simd.contains(static_cast<int>(i % (2 * n)));
+  });
+  assert(found_scalar == found_simd);
+  report("int contains", n, lookups, plain, kernel);
+}
+
+/**
+ * @brief Benchmarks filter_out() with a lambda and with the equivalent
+ * predicate of simd.hpp, on elements in a random order.
+*/
+void bench_filter(size_t n) {
+  intSet set;
+  unsigned state = 12345;
+  for (size_t i = 0; i < n; ++i) {
+    state = state * 1103515245u + 12345u; // Distinct values: full period LCG
+    set.add_unchecked(static_cast<int>(state));
+  }
+
+  intSet expected, result;
+  double plain = time_ms([&]() { expected = filter_out(set, [](int x) { return -1000000000 <= x && x <= 1000000000; }); });
+  double kernel = time_ms([&]() { result = filter_out(set, InRange<int>(-1000000000, 1000000000)); });
+  assert(result.getNumElements() == expected.getNumElements() &&
+         std::equal(result.begin(), result.end(), expected.begin()));
+  report("int range", n, result.getNumElements(), plain, kernel);
+
+  plain = time_ms([&]() { expected = filter_out(set, [](int x) { return x % 3 == 1; }); });
+  kernel = time_ms([&]() { result = filter_out(set, Modulo<int>(3, 1)); });
+  assert(result.getNumElements() == expected.getNumElements() &&
+         std::equal(result.begin(), result.end(), expected.begin()));
+  report("int modulo", n, result.getNumElements(), plain, kernel);
+}
+
+/**
+ * @brief Benchmarks building, searching and destroying many tiny Sets and
+ * SmallSets.
+*/
+template <typename S>
+double bench_tiny(size_t count, size_t n) {
+  return time_ms([&]() {
+    std::vector<S> sets(count);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        sets[i].add(static_cast<int>(i + j));
+      }
+    }
+    size_t found = 0;
+    for (size_t i = 0; i < count; ++i) {
+      found += sets[i].contains(static_cast<int>(i + n - 1));
+    }
+    assert(found == count);
+  });
+}
+
+/**
+ * @brief Benchmarks the algebra of Sets and BitSets holding half of the
+ * domain [0, 65536) each.
+*/
+void bench_bits() {
+  const size_t DOMAIN = 65536;
+  intSet a, b;
+  BitSet<DOMAIN> bits_a, bits_b;
+  for (size_t i = 0; i < DOMAIN / 2; ++i) {
+    a.add_unchecked(static_cast<int>(i * 2));
+    b.add_unchecked(static_cast<int>(i * 3 % DOMAIN));
+    bits_a.add(static_cast<int>(i * 2));
+    bits_b.add(static_cast<int>(i * 3 % DOMAIN));
+  }
+
+  intSet result;
+  BitSet<DOMAIN> bits;
+  double set = time_ms([&]() { result = a + b; });
+  double bitset = time_ms([&]() { bits = bits_a + bits_b; });
+  assert(result.getNumElements() == bits.getNumElements());
+  report("int union", a.getNumElements(), b.getNumElements(), set, bitset);
+
+  set = time_ms([&]() { result = a - b; });
+  bitset = time_ms([&]() { bits = bits_a - bits_b; });
+  assert(result.getNumElements() == bits.getNumElements());
+  report("int inter", a.getNumElements(), b.getNumElements(), set, bitset);
+}
+
+/**
+ * @brief Benchmarks the algebra of Sets and RoaringSets of 'n' ids scattered
+ * over the 32 bit space, half of them in common, and reports the bytes per
+ * id of the RoaringSet next to the size of an element of the Set.
+*/
+void bench_roaring(size_t n) {
+  Set<unsigned, std::equal_to<unsigned>> a, b;
+  RoaringSet<unsigned> roaring_a, roaring_b;
+  unsigned state = 12345;
+  for (size_t i = 0; i < n; ++i) {
+    state = state * 1103515245u + 12345u;
+    unsigned id = state % (1u << 28); // About 250 ids per 64K chunk at n = 1M
+    if (roaring_a.add(id)) a.add_unchecked(id);
+    unsigned other = i % 2 == 0 ? id : id ^ (1u << 28);
+    if (roaring_b.add(other)) b.add_unchecked(other);
+  }
+
+  Set<unsigned, std::equal_to<unsigned>> result;
+  RoaringSet<unsigned> roaring;
+  double set = time_ms([&]() { result = a + b; });
+  double compressed = time_ms([&]() { roaring = roaring_a + roaring_b; });
+  assert(result.getNumElements() == roaring.getNumElements());
+  report("id union", a.getNumElements(), b.getNumElements(), set, compressed);
+
+  set = time_ms([&]() { result = a - b; });
+  compressed = time_ms([&]() { roaring = roaring_a - roaring_b; });
+  assert(result.getNumElements() == roaring.getNumElements());
+  report("id inter", a.getNumElements(), b.getNumElements(), set, compressed);
+
+  std::cout << std::left << std::setw(14) << "id bytes/id"
+            << std::right << std::setw(16) << ""
+            << std::setw(12) << static_cast<double>(sizeof(unsigned))
+            << std::setw(12) << static_cast<double>(roaring_a.memory_usage()) / roaring_a.getNumElements()
+            << std::endl;
+}
+
+/**
+ * @brief Benchmarks contains() on a Set of 'n' strings, 95% of the lookups
+ * missing, without and with the membership filter.
+*/
+void bench_filtered(size_t n) {
+  stringSet plain;
+  for (size_t i = 0; i < n; ++i) {
+    plain.add_unchecked("key" + std::to_string(i));
+  }
+  stringSet filtered(plain);
+  filtered.enable_filter();
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 2000; ++i) {
+    keys.push_back("key" + std::to_string(i % 20 == 0 ? i * 7 % n : n + i));
+  }
+  const size_t rounds = 20000000 / n / keys.size() + 1;
+  size_t found_plain = 0, found_filtered = 0;
+  double scan = time_ms([&]() {
+    for (size_t r = 0; r < rounds; ++r)
+      for (size_t i = 0; i < keys.size(); ++i) found_plain += plain.contains(keys[i]);
+  });
+  double filter = time_ms([&]() {
+    for (size_t r = 0; r < rounds; ++r)
+      for (size_t i = 0; i < keys.size(); ++i) found_filtered += filtered.contains(keys[i]);
+  });
+  assert(found_plain == found_filtered);
+  report("str contains", n, rounds * keys.size(), scan, filter);
+}
+
+/**
+ * @brief Runs a function on a number of threads, each one with its index.
+*/
+template <typename Function>
+double time_threads(size_t threads, Function f) {
+  return time_ms([&]() {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      workers.push_back(std::thread(f, t));
+    }
+    for (size_t t = 0; t < threads; ++t) {
+      workers[t].join();
+    }
+  });
+}
+
+/**
+ * @brief Benchmarks 'threads' threads adding 'n' integers each, then looking
+ * them up, into a HashSet behind a global mutex and into a ConcurrentSet.
+*/
+void bench_concurrent(size_t threads, size_t n) {
+  HashSet<int, std::equal_to<int>> locked;
+  std::mutex lock;
+  ConcurrentSet<int, std::equal_to<int>> striped;
+
+  double global = time_threads(threads, [&](size_t t) {
+    for (size_t i = 0; i < n; ++i) {
+      std::lock_guard<std::mutex> guard(lock);
+      locked.add(static_cast<int>(t * n + i));
+    }
+    for (size_t i = 0; i < n; ++i) {
+      std::lock_guard<std::mutex> guard(lock);
+      locked.contains(static_cast<int>(i * threads + t));
+    }
+  });
+  double concurrent = time_threads(threads, [&](size_t t) {
+    for (size_t i = 0; i < n; ++i) {
+      striped.add(static_cast<int>(t * n + i));
+    }
+    for (size_t i = 0; i < n; ++i) {
+      striped.contains(static_cast<int>(i * threads + t));
+    }
+  });
+  assert(locked.getNumElements() == striped.getNumElements());
+  report("int ingest", threads, n, global, concurrent);
+}
+
+/**
+ * @brief Benchmarks the algebra of Sets and ShardedSets of 'n' integers each,
+ * half of them in common.
+*/
+void bench_sharded(size_t n, size_t shards) {
+  intSet a, b;
+  for (size_t i = 0; i < n; ++i) {
+    a.add_unchecked(static_cast<int>(i * 2));
+    b.add_unchecked(static_cast<int>(i));
+  }
+  ShardedSet<int, std::equal_to<int>> sharded_a(a, shards), sharded_b(b, shards);
+
+  intSet result;
+  ShardedSet<int, std::equal_to<int>> sharded;
+  double set = time_ms([&]() { result = a + b; });
+  double shard = time_ms([&]() { sharded = sharded_a + sharded_b; });
+  assert(result.getNumElements() == sharded.getNumElements());
+  report("int union/" + std::to_string(shards), n, n, set, shard);
+
+  set = time_ms([&]() { result = a - b; });
+  shard = time_ms([&]() { sharded = sharded_a - sharded_b; });
+  assert(result.getNumElements() == sharded.getNumElements());
+  report("int inter/" + std::to_string(shards), n, n, set, shard);
+}
+
+/**
+ * @brief Benchmarks 'lookups' lookups in a set of 'n' integers, 95% of them
+ * hits, while a writer thread replaces 'updates' elements, one at a time.
+ * The HashSet is guarded by a global mutex, which the writer holds while it
+ * updates it; the RcuSet writer copies and publishes a whole new version.
+*/
+void bench_rcu(size_t n, size_t lookups, size_t updates) {
+  HashSet<int, std::equal_to<int>> locked;
+  std::mutex lock;
+  RcuSet<int, std::equal_to<int>> rcu;
+  rcu.update([&](RcuSet<int, std::equal_to<int>>::version_type& next) {
+    for (size_t i = 0; i < n; ++i) next.add(static_cast<int>(i));
+  });
+  for (size_t i = 0; i < n; ++i) locked.add(static_cast<int>(i));
+
+  size_t found_locked = 0, found_rcu = 0;
+  std::atomic<bool> done(false);
+  double global = time_ms([&]() {
+    std::thread writer([&]() {
+      for (size_t u = 0; u < updates && !done.load(); ++u) {
+        std::lock_guard<std::mutex> guard(lock);
+        locked.remove(static_cast<int>(u % n));
+        locked.add(static_cast<int>(u % n));
+      }
+    });
+    for (size_t i = 0; i < lookups; ++i) {
+      std::lock_guard<std::mutex> guard(lock);
+      found_locked += locked.contains(static_cast<int>(i * 19 % (n + n / 19)));
+    }
+    done.store(true);
+    writer.join();
+  });
+  done.store(false);
+  double readers = time_ms([&]() {
+    std::thread writer([&]() {
+      for (size_t u = 0; u < updates && !done.load(); ++u) {
+        rcu.update([&](RcuSet<int, std::equal_to<int>>::version_type& next) {
+          next.remove(static_cast<int>(u % n));
+          next.add(static_cast<int>(u % n));
+        });
+      }
+    });
+    RcuSet<int, std::equal_to<int>>::Reader reader(rcu);
+    for (size_t i = 0; i < lookups; ++i) {
+      found_rcu += reader.contains(static_cast<int>(i * 19 % (n + n / 19)));
+    }
+    done.store(true);
+    writer.join();
+  });
+  assert(found_locked == found_rcu);
+  report("int lookups", n, lookups, global, readers);
+}
+
+/**
+ * @brief Benchmarks keeping 'versions' versions of a set of 'n' integers,
+ * each one the previous version plus an element: a Set is copied and then
+ * changed, a PersistentSet shares all but a path of its trie. Then builds a
+ * set of 'n' integers by PersistentSet::add() and by a Builder.
+*/
+void bench_persistent(size_t n, size_t versions) {
+  typedef PersistentSet<int, std::equal_to<int>> Persistent;
+  intSet base;
+  for (size_t i = 0; i < n; ++i) base.add(static_cast<int>(i));
+  Persistent persistent_base(base);
+
+  std::vector<intSet> copies;
+  std::vector<Persistent> shared;
+  double copied = time_ms([&]() {
+    copies.push_back(base);
+    for (size_t v = 0; v < versions; ++v) {
+      copies.push_back(copies.back());
+      copies.back().add(static_cast<int>(n + v));
+    }
+  });
+  double persistent = time_ms([&]() {
+    shared.push_back(persistent_base);
+    for (size_t v = 0; v < versions; ++v) {
+      shared.push_back(shared.back().add(static_cast<int>(n + v)));
+    }
+  });
+  assert(copies.back().getNumElements() == shared.back().getNumElements());
+  report("int versions", n, versions, copied, persistent);
+
+  Persistent added;
+  double one_by_one = time_ms([&]() {
+    for (size_t i = 0; i < n; ++i) added = added.add(static_cast<int>(i));
+  });
+  Persistent built;
+  double batched = time_ms([&]() {
+    Persistent::Builder builder;
+    for (size_t i = 0; i < n; ++i) builder.add(static_cast<int>(i));
+    built = builder.persistent();
+  });
+  assert(added == built);
+  report("int builder", n, n, one_by_one, batched);
+}
+
+/**
+ * @brief Benchmarks 'copies' copies of a set of 'n' integers, which are only
+ * read: copied element by element, as the copy constructor did before the
+ * array was shared, and by the copy constructor.
+*/
+void bench_copy(size_t n, size_t copies) {
+  intSet base;
+  for (size_t i = 0; i < n; ++i) base.add(static_cast<int>(i));
+
+  size_t found_deep = 0, found_shared = 0;
+  double deep = time_ms([&]() {
+    for (size_t c = 0; c < copies; ++c) {
+      intSet copy = intSet::from_unique_range(base.begin(), base.end());
+      found_deep += copy.contains(static_cast<int>(c));
+    }
+  });
+  double shared = time_ms([&]() {
+    for (size_t c = 0; c < copies; ++c) {
+      intSet copy(base);
+      found_shared += copy.contains(static_cast<int>(c));
+    }
+  });
+  assert(found_deep == found_shared);
+  report("int copies", n, copies, deep, shared);
+}
+
+int main() {
+  std::cout << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|a|" << std::setw(8) << "|b|"
+            << std::setw(12) << "nested ms" << std::setw(12) << "kernel ms"
+            << std::setw(11) << "speedup" << std::endl;
+
+  size_t sizes[][2] = {{16, 16}, {1000, 1000}, {10000, 10000}, {40000, 40000}, {40000, 100}};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    bench<intSet>("int", sizes[i][0], sizes[i][1], [](size_t x) { return static_cast<int>(x); });
+    bench<stringSet>("string", sizes[i][0], sizes[i][1], [](size_t x) { return "key" + std::to_string(x); });
+  }
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|a|" << std::setw(8) << "|b|"
+            << std::setw(12) << "seq ms" << std::setw(12) << "par ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_parallel<intSet>("int", 2000000, [](size_t x) { return static_cast<int>(x); });
+  bench_parallel<stringSet>("string", 1000000, [](size_t x) { return "key" + std::to_string(x); });
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "finds"
+            << std::setw(12) << "scalar ms" << std::setw(12) << "simd ms"
+            << std::setw(11) << "speedup" << std::endl;
+  size_t lengths[] = {16, 64, 256, 1024, 4096};
+  for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+    bench_contains(lengths[i]);
+  }
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "kept"
+            << std::setw(12) << "scalar ms" << std::setw(12) << "simd ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_filter(4000000);
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "sets" << std::setw(8) << "size"
+            << std::setw(12) << "Set ms" << std::setw(12) << "Small ms"
+            << std::setw(11) << "speedup" << std::endl;
+  size_t tiny[] = {1, 4, 8, 16};
+  for (size_t i = 0; i < sizeof(tiny) / sizeof(tiny[0]); ++i) {
+    double set = bench_tiny<intSet>(1000000, tiny[i]);
+    double small = bench_tiny<SmallSet<int, std::equal_to<int>>>(1000000, tiny[i]);
+    report("int tiny", 1000000, tiny[i], set, small);
+  }
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|a|" << std::setw(8) << "|b|"
+            << std::setw(12) << "Set ms" << std::setw(12) << "BitSet ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_bits();
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|a|" << std::setw(8) << "|b|"
+            << std::setw(12) << "Set ms" << std::setw(12) << "Roaring ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_roaring(1000000);
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "finds"
+            << std::setw(12) << "scan ms" << std::setw(12) << "filter ms"
+            << std::setw(11) << "speedup" << std::endl;
+  size_t filtered[] = {16, 256, 4096};
+  for (size_t i = 0; i < sizeof(filtered) / sizeof(filtered[0]); ++i) {
+    bench_filtered(filtered[i]);
+  }
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "threads" << std::setw(8) << "adds"
+            << std::setw(12) << "mutex ms" << std::setw(12) << "striped ms"
+            << std::setw(11) << "speedup" << std::endl;
+  size_t threads[] = {1, 4, 24};
+  for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+    bench_concurrent(threads[i], 2400000 / threads[i]);
+  }
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|a|" << std::setw(8) << "|b|"
+            << std::setw(12) << "Set ms" << std::setw(12) << "shards ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_sharded(4000000, 16);
+  bench_sharded(4000000, 256);
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "finds"
+            << std::setw(12) << "mutex ms" << std::setw(12) << "rcu ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_rcu(100000, 4000000, 20);
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "count"
+            << std::setw(12) << "copy ms" << std::setw(12) << "shared ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_persistent(100000, 1000);
+
+  std::cout << std::endl << std::left << std::setw(14) << "operation"
+            << std::right << std::setw(8) << "|set|" << std::setw(8) << "count"
+            << std::setw(12) << "deep ms" << std::setw(12) << "shared ms"
+            << std::setw(11) << "speedup" << std::endl;
+  bench_copy(100000, 1000);
+
+  return 0;
+}
@@ -0,0 +1,766 @@
+/**
+ * @file bit_set.hpp
+ *
+ * @brief Header file for the templated BitSet class.
+ *
+ * Declaration/Definition of the templated BitSet class, a sibling of Set for
+ * the integers of a bounded domain [0, Max).
+*/
+
+#ifndef BIT_SET_HPP
+#define BIT_SET_HPP
+
+#include <iostream>
+#include <algorithm> // std::swap
+#include <ostream> // std::ostream
+#include <stdexcept> // std::out_of_range
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <cstdint> // std::uint64_t
+#include <fstream> // std::ofstream
+#include <string> // std::string
+#include <type_traits> // std::is_integral
+#include <utility> // std::forward
+
+namespace detail {
+
+/**
+ * @brief Number of bits set in a word.
+*/
+inline size_t popcount64(std::uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_popcountll(word));
+#else
+  size_t count = 0;
+  for (; word != 0; word &= word - 1) ++count;
+  return count;
+#endif
+}
+
+/**
+ * @brief Position of the lowest bit set in a word.
+ *
+ * @pre word != 0
+*/
+inline size_t ctz64(std::uint64_t word) {
+#if defined(__GNUC__)
+  return static_cast<size_t>(__builtin_ctzll(word));
+#else
+  size_t pos = 0;
+  for (; (word & 1) == 0; word >>= 1) ++pos;
+  return pos;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief BitSet Class
+ *
+ * Set of the integers of the domain [0, Max), with the same interface of
+ * Set. Each value of the domain is one bit of an array of 64 bit words, so:
+ * - add, remove and contains take constant time;
+ * - operator+, operator-, difference, symmetric_difference and operator==
+ *   combine the two arrays word by word (OR, AND, AND NOT, XOR), in
+ *   O(Max / 64) whatever the number of elements;
+ * - iteration, operator<< and save list the elements in ascending order,
+ *   skipping from a bit set to the next with count trailing zeros.
+ * The array of Max / 64 words is allocated by the first add and released by
+ * empty(), so the memory used depends on Max, not on the number of elements:
+ * BitSet pays off for domains that are dense, or not much larger than the
+ * Sets.
+ *
+ * @tparam Max Size of the domain: the elements are in [0, Max).
+ * @tparam T Integral type of the elements.
+*/
+template <size_t Max, typename T = int>
+class BitSet {
+  static_assert(std::is_integral<T>::value, "BitSet requires an integral type");
+  static_assert(Max > 0, "BitSet requires a non empty domain");
+
+public:
+  static const size_t WORDS = (Max + 63) / 64; ///< Number of words of the array
+
+private:
+  std::uint64_t* _words; ///< Pointer to the array of words (nullptr until the first add)
+  size_t _num_elements; ///< Number of elements currently in the BitSet
+
+  /**
+   * @brief Tells if a value belongs to the domain.
+   *
+   * Negative values convert to huge unsigned values, beyond any Max.
+  */
+  static bool in_domain(T value) {
+    return static_cast<unsigned long long>(value) < Max;
+  }
+
+  /**
+   * @brief Allocates the array of words, all cleared, if not done yet.
+   *
+   * @throw Allocation exception.
+  */
+  void allocate() {
+    if (_words == nullptr) {
+      _words = new std::uint64_t[WORDS]();
+    }
+  }
+
+  /**
+   * @brief Recounts the elements from the words.
+  */
+  void recount() {
+    _num_elements = 0;
+    for (size_t i = 0; i < WORDS; ++i) {
+      _num_elements += detail::popcount64(_words[i]);
+    }
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty BitSet. No memory is allocated.
+   *
+   * @post _words == nullptr
+   * @post _num_elements == 0
+  */
+  BitSet() : _words(nullptr), _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Creates a new BitSet by copying the words of another BitSet.
+   *
+   * @param other BitSet from which to copy the elements.
+   *
+   * @throw Allocation exception.
+  */
+  BitSet(const BitSet& other) : _words(nullptr), _num_elements(0) {
+    if (other._words != nullptr) {
+      try {
+        allocate();
+        std::copy(other._words, other._words + WORDS, _words);
+        _num_elements = other._num_elements;
+      } catch(const std::exception& e) {
+        std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
+        throw;
+      }
+    }
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * Assigns the content of the specified 'other' BitSet to this BitSet. It
+   * creates a copy of the 'other' BitSet and then swaps its contents with
+   * this BitSet.
+   *
+   * @param other The BitSet object to be copied.
+   *
+   * @return A reference to this BitSet after the assignment.
+   *
+   * @throw Allocation exception.
+  */
+  BitSet& operator=(const BitSet& other) {
+    if (&other != this) {
+      BitSet tmp(other);
+      this->swap(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new BitSet by taking over the words of another BitSet.
+   *
+   * @param other BitSet from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  BitSet(BitSet&& other) noexcept : _words(nullptr), _num_elements(0) {
+    this->swap(other);
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the elements of this BitSet and takes over the words of
+   * 'other'.
+   *
+   * @param other The BitSet from which to take the elements.
+   *
+   * @return A reference to this BitSet after the assignment.
+   *
+   * @post other is empty.
+  */
+  BitSet& operator=(BitSet&& other) noexcept {
+    if (&other != this) {
+      empty();
+      this->swap(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   *
+   * Safely deallocates the dynamic memory used by the BitSet. Utilizes the
+   * empty() function to do so.
+   *
+   * @post The internal memory has been deallocated.
+  */
+  ~BitSet() {
+    empty();
+  }
+
+  /**
+   * @brief Empties the BitSet.
+   *
+   * Safely deallocates the array of words.
+   *
+   * @post The internal memory has been deallocated.
+   * @post _words == nullptr
+   * @post _num_elements = 0
+  */
+  void empty(void) {
+    delete[] _words;
+    _words = nullptr;
+    _num_elements = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * Swaps the state between the current instance of BitSet and the instance
+   * provided as a parameter.
+   *
+   * @param other The BitSet instance to swap states with the current
+   * instance.
+  */
+  void swap(BitSet& other) noexcept {
+    std::swap(_words, other._words);
+    std::swap(_num_elements, other._num_elements);
+  }
+
+  /**
+   * @brief Adds a new element to the BitSet.
+   *
+   * Sets the bit of the value, allocating the array of words first if
+   * needed.
+   *
+   * @param value The element of type T to be added to the BitSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @throw std::out_of_range If the value is not in [0, Max).
+   * @throw Allocation exception. The BitSet is unchanged in that case.
+  */
+  bool add(const T& value) {
+    if (!in_domain(value)) {
+      throw std::out_of_range("Value out of range");
+    }
+    allocate();
+
+    size_t bit = static_cast<size_t>(value);
+    std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+    if (_words[bit / 64] & mask) {
+      return false;
+    }
+    _words[bit / 64] |= mask;
+    ++_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the
+   * BitSet.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @throw std::out_of_range If the value is not in [0, Max).
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    return add(T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Removes an element from the BitSet.
+   *
+   * Clears the bit of the value. The array of words is kept, even when the
+   * BitSet becomes empty: use empty() to release it.
+   *
+   * @param value The element of type T to be removed from the BitSet.
+   *
+   * @return true if the element was removed, false if it is not contained
+   * (which includes the values outside the domain).
+  */
+  bool remove(const T& value) {
+    if (!contains(value)) {
+      return false;
+    }
+    size_t bit = static_cast<size_t>(value);
+    _words[bit / 64] &= ~(std::uint64_t(1) << (bit % 64));
+    --_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Accesses the element at the specified index.
+   *
+   * Provides read-only access to the element at the given index, in
+   * ascending order. The words are scanned up to the one holding the
+   * element, counting their bits, so the access takes O(Max / 64).
+   *
+   * @param index The index of the element to access.
+   *
+   * @return The element at the specified index.
+   *
+   * @throw std::out_of_range If the index is out of the bounds of the BitSet.
+  */
+  T operator[](int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= _num_elements) {
+      throw std::out_of_range("Index out of range");
+    }
+
+    size_t rank = static_cast<size_t>(index);
+    size_t i = 0;
+    for (size_t count = detail::popcount64(_words[i]); rank >= count; count = detail::popcount64(_words[++i])) {
+      rank -= count;
+    }
+    std::uint64_t word = _words[i];
+    for (; rank > 0; --rank) {
+      word &= word - 1; // Clear the lowest bit set
+    }
+    return static_cast<T>(i * 64 + detail::ctz64(word));
+  }
+
+  /**
+   * @brief Checks if the BitSet contains a specific element.
+   *
+   * Tests the bit of the value.
+   *
+   * @param value The element to search for in the BitSet.
+   *
+   * @return true if the element is found in the BitSet, false otherwise
+   * (which includes the values outside the domain).
+  */
+  bool contains(const T& value) const {
+    if (_words == nullptr || !in_domain(value)) {
+      return false;
+    }
+    size_t bit = static_cast<size_t>(value);
+    return (_words[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  /**
+   * Returns the number of elements stored inside of the BitSet
+   *
+   * @return number of elements stored inside of the BitSet
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Returns the array of words.
+   *
+   * Bit b of word w is set when the BitSet contains w * 64 + b.
+   *
+   * @return A pointer to the WORDS words, nullptr if the BitSet has never
+   * been added an element (since its construction or the last empty()).
+  */
+  const std::uint64_t* words() const {
+    return _words;
+  }
+
+  /**
+   * @brief Constant input iterator for the BitSet class.
+   *
+   * This iterator provides read-only access to the elements of the BitSet,
+   * in ascending order. It holds the bits of the current word still to
+   * visit, and computes the current element from them: there is no stored
+   * element to refer to, so it is dereferenced by value, and declared an
+   * input iterator (although it can be copied and traversed again).
+  */
+  class const_iterator {
+  public:
+    typedef std::input_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef void pointer; ///< No pointer to the elements, which are computed
+    typedef T reference; ///< Elements are returned by value
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes the iterator to the end of an empty BitSet.
+    */
+    const_iterator() : _words(nullptr), _word(WORDS), _bits(0) {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return The current element.
+    */
+    reference operator*() const {
+      return static_cast<T>(_word * 64 + detail::ctz64(_bits));
+    }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator++() {
+      _bits &= _bits - 1; // Clear the bit of the current element
+      next();
+      return *this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return Copy of the original iterator.
+    */
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if both iterators point to same element, false otherwise.
+    */
+    bool operator==(const const_iterator &other) const {
+      return _word == other._word && _bits == other._bits;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if iterators point to different element, false otherwise.
+    */
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    const std::uint64_t* _words; ///< Words of the BitSet
+    size_t _word; ///< Index of the current word (WORDS at the end)
+    std::uint64_t _bits; ///< Bits of the current word not visited yet, current one included
+
+    friend class BitSet; ///< Allow BitSet class to access private constructor.
+
+    /**
+     * @brief Constructor for internal use by the BitSet class.
+     *
+     * @param words Words of the BitSet, or nullptr for the end.
+    */
+    explicit const_iterator(const std::uint64_t* words)
+      : _words(words), _word(0), _bits(words != nullptr ? words[0] : 0) {
+      if (words == nullptr) {
+        _word = WORDS;
+      } else {
+        next();
+      }
+    }
+
+    /**
+     * @brief Moves to the lowest bit left, in the current word or the
+     * following ones.
+    */
+    void next() {
+      while (_bits == 0) {
+        if (++_word >= WORDS) {
+          _word = WORDS;
+          return;
+        }
+        _bits = _words[_word];
+      }
+    }
+
+  }; //const_iterator class
+
+  /**
+   * @brief Returns an iterator to the beginning of the BitSet.
+   *
+   * @return A const_iterator to the lowest element of the BitSet.
+  */
+  const_iterator begin() const {
+    return const_iterator(_words);
+  }
+
+  /**
+   * @brief Returns an iterator to the end of the BitSet.
+   *
+   * @return A const_iterator to the element following the highest element of
+   * the BitSet.
+  */
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  /**
+   * Constructor that creates a BitSet from a range defined by two iterators.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+   *
+   * @throw std::out_of_range If a value is not in [0, Max).
+  */
+  template <typename IteratorQ>
+  BitSet(IteratorQ begin, IteratorQ end) : _words(nullptr), _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        add(*it);
+      }
+    } catch (const std::exception& e) {
+      empty();
+      std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Builds a BitSet from the words of two BitSets.
+   *
+   * @param a The first BitSet.
+   * @param b The second BitSet.
+   * @param op Functor combining a word of 'a' with the word of 'b' at the
+   * same position (a missing array counts as all zeros).
+   *
+   * @return The new BitSet.
+   *
+   * @throw Allocation exception.
+  */
+  template <typename Op>
+  static BitSet combine(const BitSet& a, const BitSet& b, Op op) {
+    BitSet new_set;
+    if (a._words == nullptr && b._words == nullptr) {
+      return new_set;
+    }
+    static const std::uint64_t zeros[WORDS] = {};
+    const std::uint64_t* x = a._words != nullptr ? a._words : zeros;
+    const std::uint64_t* y = b._words != nullptr ? b._words : zeros;
+    new_set.allocate();
+    for (size_t i = 0; i < WORDS; ++i) {
+      new_set._words[i] = op(x[i], y[i]);
+    }
+    new_set.recount();
+    return new_set;
+  }
+
+  /**
+   * @brief Stream operator for the BitSet class.
+   *
+   * The output format is the same of Set: the number of elements followed by
+   * each element between round brackets, in ascending order.
+   *
+   * @param os The output stream to which the BitSet data will be sent.
+   * @param set The BitSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the BitSet data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const BitSet& set) {
+    os << set._num_elements;
+    for (const_iterator it = set.begin(); it != set.end(); ++it) {
+      os << " (" << *it << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for BitSet.
+   *
+   * Two BitSets are considered equal if they contain the same elements, i.e.
+   * if their words are equal.
+   *
+   * @param other The BitSet to compare with.
+   *
+   * @return True if the BitSets contain the same elements, false otherwise.
+  */
+  bool operator==(const BitSet& other) const {
+    if (_num_elements != other._num_elements) return false;
+    if (_num_elements == 0) return true;
+
+    for (size_t i = 0; i < WORDS; ++i) {
+      if (_words[i] != other._words[i]) return false;
+    }
+
+    return true;
+  }
+};
+
+template <size_t Max, typename T>
+const size_t BitSet<Max, T>::WORDS;
+
+/**
+ * @brief Filters elements of a BitSet, based on a predicate.
+ *
+ * This function creates a new BitSet containing elements from the original
+ * BitSet that satisfy the given predicate.
+ *
+ * @param S The original BitSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new BitSet. It is called in ascending order.
+ *
+ * @return A new BitSet containing elements that satisfy the predicate P.
+*/
+template <size_t Max, typename T, typename Predicate>
+BitSet<Max, T> filter_out(const BitSet<Max, T>& S, Predicate P) {
+  BitSet<Max, T> new_set;
+  try {
+    for (typename BitSet<Max, T>::const_iterator it = S.begin(); it != S.end(); ++it) {
+      if (P(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the addition operator to concatenate two BitSets.
+ *
+ * Creates a new BitSet that represents the union of 'a' and 'b': the OR of
+ * their words.
+ *
+ * @param a The first BitSet to be concatenated.
+ * @param b The second BitSet to be concatenated.
+ *
+ * @return A new BitSet containing all elements from both 'a' and 'b'.
+*/
+template <size_t Max, typename T>
+BitSet<Max, T> operator+(const BitSet<Max, T>& a, const BitSet<Max, T>& b) {
+  try {
+    return BitSet<Max, T>::combine(a, b, [](std::uint64_t x, std::uint64_t y) { return x | y; });
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in operator+: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Computes the intersection of two BitSets.
+ *
+ * Creates a new BitSet containing the elements of 'a' that are also present
+ * in 'b': the AND of their words.
+ *
+ * @param a The first BitSet to intersect.
+ * @param b The second BitSet to intersect.
+ *
+ * @return A new BitSet containing the intersection of 'a' and 'b'.
+*/
+template <size_t Max, typename T>
+BitSet<Max, T> intersection(const BitSet<Max, T>& a, const BitSet<Max, T>& b) {
+  try {
+    return BitSet<Max, T>::combine(a, b, [](std::uint64_t x, std::uint64_t y) { return x & y; });
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of
+ * two BitSets.
+ *
+ * Same as intersection(a, b).
+ *
+ * @param a The first BitSet to intersect.
+ * @param b The second BitSet to intersect.
+ *
+ * @return A new BitSet containing the intersection of 'a' and 'b'.
+ *
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <size_t Max, typename T>
+BitSet<Max, T> operator-(const BitSet<Max, T>& a, const BitSet<Max, T>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two BitSets.
+ *
+ * Creates a new BitSet with the elements of 'a' that are not contained in
+ * 'b': the AND NOT of their words.
+ *
+ * @param a The BitSet whose elements are kept.
+ * @param b The BitSet whose elements are removed.
+ *
+ * @return A new BitSet containing a \ b.
+*/
+template <size_t Max, typename T>
+BitSet<Max, T> difference(const BitSet<Max, T>& a, const BitSet<Max, T>& b) {
+  try {
+    return BitSet<Max, T>::combine(a, b, [](std::uint64_t x, std::uint64_t y) { return x & ~y; });
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Computes the symmetric difference of two BitSets.
+ *
+ * Creates a new BitSet with the elements contained in exactly one of 'a' and
+ * 'b': the XOR of their words.
+ *
+ * @param a The first BitSet.
+ * @param b The second BitSet.
+ *
+ * @return A new BitSet containing (a \ b) U (b \ a).
+*/
+template <size_t Max, typename T>
+BitSet<Max, T> symmetric_difference(const BitSet<Max, T>& a, const BitSet<Max, T>& b) {
+  try {
+    return BitSet<Max, T>::combine(a, b, [](std::uint64_t x, std::uint64_t y) { return x ^ y; });
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Saves the contents of a BitSet to a file.
+ *
+ * This function writes the contents of a given BitSet to a file specified by
+ * 'filename'. The BitSet is output using the overriden 'operator<<'.
+ *
+ * @param set The BitSet to be saved to the file.
+ * @param filename The name of the file to which the BitSet's contents will be
+ *                 saved.
+ *
+ * @note The function does not return a value or throw exceptions, but it
+ * reports to stderr if the file cannot be opened.
+*/
+template <size_t Max, typename T>
+void save(const BitSet<Max, T>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+#endif // BIT_SET_HPP
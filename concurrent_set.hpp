@@ -0,0 +1,316 @@
+/**
+ * @file concurrent_set.hpp
+ *
+ * @brief Header file for the templated ConcurrentSet class.
+ *
+ * Declaration/Definition of the templated ConcurrentSet class, a lock striped
+ * sibling of HashSet that can be shared by many threads, and of its
+ * conversions to and from Set.
+ *
+ * Link with -pthread.
+*/
+
+#ifndef CONCURRENT_SET_HPP
+#define CONCURRENT_SET_HPP
+
+#include <mutex> // std::mutex, std::lock_guard
+#include <atomic> // std::atomic
+#include <memory> // std::unique_ptr
+#include <vector> // std::vector
+#include <cstddef> // size_t
+#include <utility> // std::move
+#include "set.hpp"
+#include "hash_set.hpp"
+
+/**
+ * @brief ConcurrentSet Class
+ *
+ * Set of type T elements that can be modified and searched by many threads
+ * at the same time. The elements are partitioned by hash value into stripes,
+ * each one a HashSet guarded by its own mutex: add, remove and contains lock
+ * only the stripe of their element, so threads working on different stripes
+ * never wait for each other, and a stripe resizing its array blocks only the
+ * operations on that stripe.
+ *
+ * The stripe of an element is selected by the mixed hash value (see
+ * hash_mix()), so that it does not depend on the bits selecting the bucket
+ * inside the HashSet of the stripe.
+ *
+ * There are no iterators, since they would be invalidated by other threads:
+ * snapshot() copies the elements into a plain Set with every stripe locked,
+ * and for_each() visits them one stripe at a time.
+ *
+ * @tparam T Type of the elements in the ConcurrentSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam Hash Functor used for hashing an element. Two elements that are
+ * equal according to Equal must have the same hash value.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T> >
+class ConcurrentSet {
+public:
+  typedef Set<T, Equal> set_type; ///< Type of the snapshots
+
+  enum {
+    DEFAULT_STRIPES = 64 ///< Number of stripes of a default constructed ConcurrentSet
+  };
+
+private:
+  /**
+   * @brief A partition of the elements and its lock.
+  */
+  struct Stripe {
+    mutable std::mutex lock; ///< Guards 'set'
+    HashSet<T, Equal, Hash> set; ///< Elements of the stripe
+  };
+
+  std::unique_ptr<Stripe[]> _stripes; ///< Stripes of the elements
+  size_t _stripe_count; ///< Number of stripes (power of two)
+  std::atomic<size_t> _num_elements; ///< Number of elements in all the stripes
+  Hash _hash; ///< Instance of the Hash functor
+
+  ConcurrentSet(const ConcurrentSet&); // not copyable: see snapshot()
+  ConcurrentSet& operator=(const ConcurrentSet&);
+
+  /**
+   * @brief Returns the stripe of an element.
+  */
+  Stripe& stripe_of(const T& value) const {
+    return _stripes[hash_mix(_hash(value)) & (_stripe_count - 1)];
+  }
+
+  /**
+   * @brief Locks every stripe, in increasing order, so that two threads
+   * locking them all never deadlock.
+  */
+  void lock_all() const {
+    for (size_t s = 0; s < _stripe_count; ++s) {
+      _stripes[s].lock.lock();
+    }
+  }
+
+  /**
+   * @brief Unlocks every stripe.
+  */
+  void unlock_all() const {
+    for (size_t s = 0; s < _stripe_count; ++s) {
+      _stripes[s].lock.unlock();
+    }
+  }
+
+  /**
+   * @brief Rounds a number of stripes up to a power of two.
+  */
+  static size_t stripe_count(size_t stripes) {
+    size_t count = 1;
+    while (count < stripes) {
+      count *= 2;
+    }
+    return count;
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty ConcurrentSet.
+   *
+   * @param stripes Number of stripes, rounded up to a power of two. More
+   * stripes than threads make two threads rarely wait for the same stripe.
+   *
+   * @throw Allocation exception.
+  */
+  explicit ConcurrentSet(size_t stripes = DEFAULT_STRIPES)
+    : _stripes(new Stripe[stripe_count(stripes)]), _stripe_count(stripe_count(stripes)),
+      _num_elements(0) {}
+
+  /**
+   * @brief Conversion constructor from a Set.
+   *
+   * @param set The Set whose elements are copied.
+   * @param stripes Number of stripes, rounded up to a power of two.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  template <typename Policy, typename Allocator>
+  explicit ConcurrentSet(const Set<T, Equal, Policy, Allocator>& set, size_t stripes = DEFAULT_STRIPES)
+    : _stripes(new Stripe[stripe_count(stripes)]), _stripe_count(stripe_count(stripes)),
+      _num_elements(0) {
+    for (typename Set<T, Equal, Policy, Allocator>::const_iterator it = set.begin(); it != set.end(); ++it) {
+      stripe_of(*it).set.add(*it);
+    }
+    _num_elements = set.getNumElements();
+  }
+
+  /**
+   * @brief Adds a new element to the ConcurrentSet.
+   *
+   * Can be called by many threads at the same time.
+   *
+   * @param value The element of type T to be added.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @throw Allocation exception. The ConcurrentSet is unchanged in that case.
+  */
+  bool add(const T& value) {
+    Stripe& stripe = stripe_of(value);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    if (!stripe.set.add(value)) return false;
+    ++_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Adds a new element to the ConcurrentSet, moving it.
+   *
+   * @param value The element of type T to be moved into the ConcurrentSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    Stripe& stripe = stripe_of(value);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    if (!stripe.set.add(std::move(value))) return false;
+    ++_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Removes an element from the ConcurrentSet.
+   *
+   * Can be called by many threads at the same time.
+   *
+   * @param value The element of type T to be removed.
+   *
+   * @return true if the element was removed, false if it is not contained.
+  */
+  bool remove(const T& value) {
+    Stripe& stripe = stripe_of(value);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    if (!stripe.set.remove(value)) return false;
+    --_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Checks if the ConcurrentSet contains a specific element.
+   *
+   * Can be called by many threads at the same time.
+   *
+   * @param value The element to search for.
+   *
+   * @return true if the element is contained when its stripe is searched.
+  */
+  bool contains(const T& value) const {
+    Stripe& stripe = stripe_of(value);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    return stripe.set.contains(value);
+  }
+
+  /**
+   * @brief Returns the number of elements.
+   *
+   * @return number of elements stored inside of the ConcurrentSet, which may
+   * already be out of date if other threads are modifying it.
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Returns the number of stripes.
+  */
+  size_t stripes() const {
+    return _stripe_count;
+  }
+
+  /**
+   * @brief Empties the ConcurrentSet.
+   *
+   * Every stripe is locked at the same time, so no thread can observe a
+   * partially emptied ConcurrentSet.
+  */
+  void empty(void) {
+    lock_all();
+    for (size_t s = 0; s < _stripe_count; ++s) {
+      _stripes[s].set.empty();
+    }
+    _num_elements = 0;
+    unlock_all();
+  }
+
+  /**
+   * @brief Copies the elements into a plain Set.
+   *
+   * Every stripe is locked at the same time while the elements are copied:
+   * the snapshot holds the elements of the ConcurrentSet at a single moment,
+   * and can then be iterated and combined with the Set algorithms freely.
+   *
+   * @return A Set with the elements, grouped by stripe.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  set_type snapshot() const {
+    set_type set;
+    lock_all();
+    try {
+      set.reserve(_num_elements);
+      for (size_t s = 0; s < _stripe_count; ++s) {
+        const HashSet<T, Equal, Hash>& stripe = _stripes[s].set;
+        for (typename HashSet<T, Equal, Hash>::const_iterator it = stripe.begin(); it != stripe.end(); ++it) {
+          set.add_unchecked(*it);
+        }
+      }
+    } catch (const std::exception& e) {
+      unlock_all();
+      std::cerr << "Exception caught in snapshot: " << e.what() << '\n';
+      throw;
+    }
+    unlock_all();
+    return set;
+  }
+
+  /**
+   * @brief Calls a function on every element, one stripe at a time.
+   *
+   * Only the stripe being visited is locked, so the other threads can keep
+   * working on the other stripes: every element contained during the whole
+   * call is visited exactly once, while the elements added or removed during
+   * the call may or may not be. Use snapshot() for a consistent view.
+   *
+   * @param f Functor called as f(const T&). It must not call the methods of
+   * this ConcurrentSet.
+   *
+   * @throw Any exception thrown by 'f'.
+  */
+  template <typename Function>
+  void for_each(Function f) const {
+    for (size_t s = 0; s < _stripe_count; ++s) {
+      std::lock_guard<std::mutex> guard(_stripes[s].lock);
+      const HashSet<T, Equal, Hash>& stripe = _stripes[s].set;
+      for (typename HashSet<T, Equal, Hash>::const_iterator it = stripe.begin(); it != stripe.end(); ++it) {
+        f(*it);
+      }
+    }
+  }
+
+  /**
+   * @brief Stream operator for the ConcurrentSet class.
+   *
+   * Prints a snapshot(), in the format of Set.
+   *
+   * @param os The output stream to which the ConcurrentSet data will be sent.
+   * @param set The ConcurrentSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the ConcurrentSet
+   * data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const ConcurrentSet& set) {
+    return os << set.snapshot();
+  }
+};
+
+#endif // CONCURRENT_SET_HPP
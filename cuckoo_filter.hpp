@@ -0,0 +1,306 @@
+/**
+ * @file cuckoo_filter.hpp
+ *
+ * @brief Header file for the approximate membership filter of the Set.
+ *
+ * Declaration/Definition of CuckooFilter. Like the index engines of
+ * hash_index.hpp, the filter does not store the elements of a Set: it stores
+ * a 16 bit fingerprint of the hash value of each element, and answers
+ * "definitely not present" for most of the absent elements without touching
+ * the array of the Set. Unlike a Bloom filter, a fingerprint can be erased
+ * again, so the filter follows remove() without being rebuilt.
+*/
+
+#ifndef CUCKOO_FILTER_HPP
+#define CUCKOO_FILTER_HPP
+
+#include <algorithm> // std::swap, std::max
+#include <cmath> // std::pow
+#include <cstddef> // size_t
+#include <cstdint> // std::uint16_t
+#include "hash.hpp" // hash_mix
+
+/**
+ * @brief Cuckoo filter over hash values.
+ *
+ * Every hash value has a fingerprint (its 16 highest bits, never 0) and two
+ * candidate buckets of 4 slots: the one selected by its lowest bits, and the
+ * one obtained by xoring it with the hash of the fingerprint, so that either
+ * bucket can be computed from the other one and the fingerprint alone. A
+ * lookup compares the fingerprint with the 8 slots of the two buckets. An
+ * insertion into two full buckets evicts a fingerprint to its other bucket,
+ * and so on, up to MAX_KICKS times.
+ *
+ * The number of buckets is the smallest power of two such that at most 3 of
+ * the 4 slots of a bucket are used when the dense array of the Set is full.
+ * A lookup of an absent element passes the filter with probability about
+ * 8 * load / 65535, i.e. less than 0.01%.
+ *
+ * More than 8 equal hash values never fit, whatever the number of buckets:
+ * a hasher ignoring part of the key can produce them. The filter then
+ * saturates, letting every hash value pass until it is rebuilt.
+*/
+class CuckooFilter {
+public:
+  enum {
+    SLOTS = 4, ///< Slots per bucket
+    MAX_KICKS = 500, ///< Evictions tried by insert() before giving up
+    MAX_GROWTH = 8 ///< Growth of the buckets tried by rebuild() before saturating
+  };
+
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty filter without buckets, which lets every hash
+   * value pass.
+  */
+  CuckooFilter() : _slots(nullptr), _bucket_count(0), _count(0), _saturated(false) {}
+
+  /**
+   * @brief Destructor.
+   *
+   * Deallocates the buckets.
+  */
+  ~CuckooFilter() {
+    clear();
+  }
+
+  /**
+   * @brief Empties the filter.
+   *
+   * @post The buckets have been deallocated: every hash value passes the
+   * filter until the next rebuild(), and insert() fails.
+  */
+  void clear(void) {
+    delete[] _slots;
+    _slots = nullptr;
+    _bucket_count = 0;
+    _count = 0;
+    _saturated = false;
+  }
+
+  /**
+   * @brief Saturates the filter.
+   *
+   * @post The buckets have been deallocated: every hash value passes the
+   * filter until the next rebuild(), and insert() succeeds without storing
+   * anything.
+  */
+  void saturate(void) {
+    clear();
+    _saturated = true;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The filter to swap states with the current instance.
+  */
+  void swap(CuckooFilter& other) {
+    std::swap(_slots, other._slots);
+    std::swap(_bucket_count, other._bucket_count);
+    std::swap(_count, other._count);
+    std::swap(_saturated, other._saturated);
+  }
+
+  /**
+   * @brief Rebuilds the filter for a dense array of a given capacity.
+   *
+   * The number of buckets is doubled until every hash value fits, up to
+   * MAX_GROWTH times the initial number, or 2 buckets (8 slots) per hash
+   * value if more: beyond that, the hash values are assumed to collide, and
+   * the filter saturates.
+   *
+   * @param hashes Hash values of the elements, by position.
+   * @param n Number of elements in the dense array.
+   * @param capacity Capacity of the dense array.
+   *
+   * @throw Allocation exception. The filter is left without buckets in that
+   * case, letting every hash value pass.
+  */
+  void rebuild(const size_t* hashes, size_t n, size_t capacity) {
+    size_t count = 1;
+    while (count * (SLOTS - 1) < capacity) {
+      count *= 2;
+    }
+
+    size_t max_count = std::max(count * MAX_GROWTH, 2 * n);
+
+    for (;;) {
+      clear();
+      _slots = new std::uint16_t[count * SLOTS](); // 0 marks an empty slot
+      _bucket_count = count;
+
+      size_t i = 0;
+      while (i < n && insert(hashes[i])) {
+        ++i;
+      }
+      if (i == n) return;
+      if (count >= max_count) break;
+      count *= 2;
+    }
+    saturate();
+  }
+
+  /**
+   * @brief Tells if a hash value may have been inserted.
+   *
+   * @param hash Hash value of the searched element.
+   *
+   * @return false if no element with this hash value has been inserted, true
+   * if one probably has.
+  */
+  bool may_contain(size_t hash) const {
+    if (_bucket_count == 0) return true;
+
+    std::uint16_t fp = fingerprint(hash);
+    size_t bucket = hash & (_bucket_count - 1);
+    return find(bucket, fp) != SLOTS || find(alternate(bucket, fp), fp) != SLOTS;
+  }
+
+  /**
+   * @brief Inserts a hash value.
+   *
+   * @param hash Hash value of the element.
+   *
+   * @return true if the hash value was inserted, or if the filter is
+   * saturated. false if the filter is full, or has no buckets: some hash
+   * value inserted before may have been dropped then, so the filter must be
+   * rebuilt before it is used again.
+  */
+  bool insert(size_t hash) {
+    if (_bucket_count == 0) return _saturated;
+
+    std::uint16_t fp = fingerprint(hash);
+    size_t bucket = hash & (_bucket_count - 1);
+    if (put(bucket, fp) || put(alternate(bucket, fp), fp)) {
+      ++_count;
+      return true;
+    }
+
+    // Evict a fingerprint of a full bucket to its other bucket
+    for (size_t kick = 0; kick < MAX_KICKS; ++kick) {
+      std::swap(fp, _slots[bucket * SLOTS + (hash_mix(kick ^ hash) & (SLOTS - 1))]);
+      bucket = alternate(bucket, fp);
+      if (put(bucket, fp)) {
+        ++_count;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Removes a hash value.
+   *
+   * @param hash Hash value of an inserted element.
+   *
+   * @return true if a matching fingerprint was removed.
+  */
+  bool erase(size_t hash) {
+    if (_bucket_count == 0) return false;
+
+    std::uint16_t fp = fingerprint(hash);
+    size_t bucket = hash & (_bucket_count - 1);
+    size_t slot = find(bucket, fp);
+    if (slot == SLOTS) {
+      bucket = alternate(bucket, fp);
+      slot = find(bucket, fp);
+      if (slot == SLOTS) return false;
+    }
+    _slots[bucket * SLOTS + slot] = 0;
+    --_count;
+    return true;
+  }
+
+  /**
+   * @brief Estimates the false positive rate of the filter.
+   *
+   * @return The probability that an absent hash value passes the filter: 1
+   * without buckets, otherwise the probability that one of the occupied
+   * slots of its two buckets holds the same fingerprint.
+  */
+  double false_positive_rate() const {
+    if (_bucket_count == 0) return 1.0;
+
+    double load = static_cast<double>(_count) / (_bucket_count * SLOTS);
+    return 1.0 - std::pow(1.0 - 1.0 / 65535.0, 2.0 * SLOTS * load);
+  }
+
+  /**
+   * @brief Tells if the filter is saturated (see saturate()).
+  */
+  bool saturated() const {
+    return _saturated;
+  }
+
+  /**
+   * @brief Returns the number of inserted hash values.
+  */
+  size_t size() const {
+    return _count;
+  }
+
+  /**
+   * @brief Returns the number of bytes of the buckets.
+  */
+  size_t memory_usage() const {
+    return _bucket_count * SLOTS * sizeof(std::uint16_t);
+  }
+
+private:
+  std::uint16_t* _slots; ///< Fingerprints, SLOTS per bucket (0 if empty)
+  size_t _bucket_count; ///< Number of buckets (power of two)
+  size_t _count; ///< Number of inserted hash values
+  bool _saturated; ///< Every hash value passes, and insert() succeeds, until the next rebuild()
+
+  CuckooFilter(const CuckooFilter&); // not copyable, rebuilt from the hashes
+  CuckooFilter& operator=(const CuckooFilter&);
+
+  /**
+   * @brief Computes the fingerprint of a hash value: its 16 highest bits,
+   * with 0 (the empty slot) replaced by 1.
+  */
+  static std::uint16_t fingerprint(size_t hash) {
+    std::uint16_t fp = static_cast<std::uint16_t>(hash >> (sizeof(size_t) * 8 - 16));
+    return fp == 0 ? 1 : fp;
+  }
+
+  /**
+   * @brief Computes the other candidate bucket of a fingerprint.
+  */
+  size_t alternate(size_t bucket, std::uint16_t fp) const {
+    return (bucket ^ hash_mix(fp)) & (_bucket_count - 1);
+  }
+
+  /**
+   * @brief Finds a fingerprint in a bucket.
+   *
+   * @return The slot holding the fingerprint, or SLOTS if there is none.
+  */
+  size_t find(size_t bucket, std::uint16_t fp) const {
+    const std::uint16_t* slots = _slots + bucket * SLOTS;
+    for (size_t s = 0; s < SLOTS; ++s) {
+      if (slots[s] == fp) return s;
+    }
+    return SLOTS;
+  }
+
+  /**
+   * @brief Stores a fingerprint in the first empty slot of a bucket.
+   *
+   * @return false if the bucket is full.
+  */
+  bool put(size_t bucket, std::uint16_t fp) {
+    std::uint16_t* slots = _slots + bucket * SLOTS;
+    for (size_t s = 0; s < SLOTS; ++s) {
+      if (slots[s] == 0) {
+        slots[s] = fp;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+#endif // CUCKOO_FILTER_HPP
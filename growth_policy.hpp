@@ -0,0 +1,79 @@
+/**
+ * @file growth_policy.hpp
+ *
+ * @brief Header file for the growth policies of the Set array.
+ *
+ * Declaration/Definition of the GrowthPolicy template, deciding how the
+ * capacity of the array of a Set changes when it gets full and when it
+ * becomes underutilized.
+*/
+
+#ifndef GROWTH_POLICY_HPP
+#define GROWTH_POLICY_HPP
+
+#include <cstddef> // size_t
+
+/**
+ * @brief Growth policy of the Set array.
+ *
+ * When the array is full its capacity is multiplied by GrowNum / GrowDen
+ * (at least by one element, and never below MinCapacity). When the number of
+ * elements drops to 1 / ShrinkDiv of the capacity or less, the capacity is
+ * divided by the same factor (never below MinCapacity); a ShrinkDiv of 0
+ * disables shrinking altogether.
+ *
+ * @tparam GrowNum Numerator of the growth factor.
+ * @tparam GrowDen Denominator of the growth factor.
+ * @tparam ShrinkDiv Occupancy divisor triggering a shrink, 0 to never shrink.
+ * @tparam MinCapacity Capacity of the first allocation, and lower bound of
+ * the capacity after a shrink.
+*/
+template <size_t GrowNum = 2, size_t GrowDen = 1, size_t ShrinkDiv = 4, size_t MinCapacity = 1>
+struct GrowthPolicy {
+  static_assert(GrowNum > GrowDen && GrowDen > 0, "The growth factor must be greater than 1");
+  static_assert(ShrinkDiv == 0 || ShrinkDiv * GrowDen >= GrowNum,
+                "Shrinking must leave room for the remaining elements");
+
+  /**
+   * @brief Computes the capacity of a full array after growing.
+   *
+   * @param capacity The current capacity.
+   *
+   * @return The new capacity, greater than the current one.
+  */
+  static size_t grow(size_t capacity) {
+    size_t new_capacity = capacity / GrowDen * GrowNum + capacity % GrowDen * GrowNum / GrowDen;
+    if (new_capacity <= capacity) new_capacity = capacity + 1;
+    return new_capacity < MinCapacity ? MinCapacity : new_capacity;
+  }
+
+  /**
+   * @brief Tells if the array should shrink.
+   *
+   * @param num_elements The number of elements in the array.
+   * @param capacity The current capacity.
+   *
+   * @return true if the array is underutilized and can shrink.
+  */
+  static bool should_shrink(size_t num_elements, size_t capacity) {
+    return ShrinkDiv != 0 && capacity > MinCapacity && num_elements <= capacity / ShrinkDiv;
+  }
+
+  /**
+   * @brief Computes the capacity of an underutilized array after shrinking.
+   *
+   * @param capacity The current capacity.
+   *
+   * @return The new capacity.
+  */
+  static size_t shrink(size_t capacity) {
+    size_t new_capacity = capacity / GrowNum * GrowDen + capacity % GrowNum * GrowDen / GrowNum;
+    return new_capacity < MinCapacity ? MinCapacity : new_capacity;
+  }
+};
+
+typedef GrowthPolicy<> DefaultGrowthPolicy; ///< Doubles when full, halves at 1/4 occupancy
+typedef GrowthPolicy<2, 1, 0> NoShrinkPolicy; ///< Doubles when full, never shrinks
+typedef GrowthPolicy<3, 2> CompactGrowthPolicy; ///< Grows and shrinks by 1.5x
+
+#endif // GROWTH_POLICY_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file hash.hpp
+ *
+ * @brief Header file for the hash functors used by the hashed Sets.
+ *
+ * Declaration/Definition of ready-made hashers for std::string and the
+ * arithmetic types, together with a hash_combine helper that can be used to
+ * write hashers for user defined records.
+*/
+
+#ifndef HASH_HPP
+#define HASH_HPP
+
+#include <string> // std::string
+#include <cstring> // std::memcpy
+#include <cstddef> // size_t
+#include <functional> // std::hash
+#include <type_traits> // std::is_arithmetic, std::is_pointer, std::enable_if
+
+/**
+ * @brief Mixes the bits of a hash value.
+ *
+ * Finalizer of the MurmurHash3 64 bit hash. Every bit of the input affects
+ * every bit of the output, so that the low bits of the result (the ones used
+ * to select a bucket) are well distributed even for inputs such as small
+ * consecutive integers.
+ *
+ * @param h The value to be mixed.
+ *
+ * @return The mixed value.
+*/
+inline size_t hash_mix(unsigned long long h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+/**
+ * @brief Hasher for std::string.
+ *
+ * Computes the 64 bit FNV-1a hash of the characters of the string, followed
+ * by a final mix of the bits.
+*/
+struct StringHash {
+  /**
+   * @brief Computes the hash of a string.
+   *
+   * @param s The string to be hashed.
+   *
+   * @return The hash value of the string.
+  */
+  size_t operator()(const std::string& s) const {
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < s.size(); ++i) {
+      h ^= static_cast<unsigned char>(s[i]);
+      h *= 0x100000001b3ULL;
+    }
+    return hash_mix(h);
+  }
+};
+
+/**
+ * @brief Hasher for the arithmetic types.
+ *
+ * The bit pattern of the value is mixed with hash_mix(). Floating point zeros
+ * are normalized first, so that 0.0 and -0.0 (that are equal) share the same
+ * hash value.
+ *
+ * @tparam T Arithmetic type to be hashed.
+*/
+template <typename T>
+struct ArithmeticHash {
+  /**
+   * @brief Computes the hash of an arithmetic value.
+   *
+   * @param value The value to be hashed.
+   *
+   * @return The hash value of the value.
+  */
+  size_t operator()(T value) const {
+    if (value == T(0)) {
+      value = T(0); // -0.0 == 0.0, they must hash to the same value
+    }
+    unsigned long long bits = 0;
+    std::memcpy(&bits, &value, sizeof(T) < sizeof(bits) ? sizeof(T) : sizeof(bits));
+    return hash_mix(bits);
+  }
+};
+
+/**
+ * @brief Default hasher.
+ *
+ * Picks StringHash for std::string, ArithmeticHash for the arithmetic types and
+ * falls back to std::hash for every other type.
+ *
+ * @tparam T Type to be hashed.
+*/
+template <typename T, typename Enable = void>
+struct DefaultHash : std::hash<T> {};
+
+/**
+ * @brief Default hasher for the arithmetic types.
+*/
+template <typename T>
+struct DefaultHash<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  : ArithmeticHash<T> {};
+
+/**
+ * @brief Default hasher for std::string.
+*/
+template <>
+struct DefaultHash<std::string> : StringHash {};
+
+/**
+ * @brief Hasher consistent with an equality functor.
+ *
+ * Tells the algorithms of Set that need hashing (such as Set::add_range())
+ * whether a hasher returning equal values for the elements that Equal
+ * considers equal is known. If 'enabled' is true, 'hasher' is that hasher;
+ * otherwise the algorithms fall back to linear scans.
+ *
+ * Enabled for std::equal_to over the arithmetic types, the pointers and
+ * std::string. Specialize it to enable hashing for other types, e.g.:
+ * @code
+ * template <>
+ * struct HashTraits<Person, EqualPerson> {
+ *   static const bool enabled = true;
+ *   typedef HashPerson hasher;
+ * };
+ * @endcode
+ *
+ * @tparam T Type of the elements.
+ * @tparam Equal Equality functor of the elements.
+*/
+template <typename T, typename Equal, typename Enable = void>
+struct HashTraits {
+  static const bool enabled = false; ///< No hasher is known
+};
+
+/**
+ * @brief HashTraits of the arithmetic types and the pointers.
+*/
+template <typename T>
+struct HashTraits<T, std::equal_to<T>,
+                  typename std::enable_if<std::is_arithmetic<T>::value || std::is_pointer<T>::value>::type> {
+  static const bool enabled = true; ///< DefaultHash is consistent with ==
+  typedef DefaultHash<T> hasher; ///< Hasher consistent with ==
+};
+
+/**
+ * @brief HashTraits of std::string.
+*/
+template <>
+struct HashTraits<std::string, std::equal_to<std::string> > {
+  static const bool enabled = true; ///< DefaultHash is consistent with ==
+  typedef DefaultHash<std::string> hasher; ///< Hasher consistent with ==
+};
+
+/**
+ * @brief Hashes a value and combines it into a seed.
+ *
+ * Used to compute the hash of records made of multiple fields, by combining
+ * the hashes of every field that takes part in the equality comparison.
+ *
+ * @tparam V Type of the value, hashed with DefaultHash.
+ *
+ * @param seed The hash accumulated so far, updated in place.
+ * @param value The value to be hashed and combined into the seed.
+*/
+template <typename V>
+void hash_combine(size_t& seed, const V& value) {
+  size_t h = DefaultHash<V>()(value);
+  seed ^= h + static_cast<size_t>(0x9e3779b97f4a7c15ULL) + (seed << 6) + (seed >> 2);
+}
+
+#endif // HASH_HPP
@@ -0,0 +1,584 @@
+/**
+ * @file hash_index.hpp
+ *
+ * @brief Header file for the index engines used by the hashed Sets.
+ *
+ * Declaration/Definition of the index engines. An index engine does not store
+ * the elements of a Set: it maps hash values to positions inside the dense
+ * array of elements owned by the Set, so that the Set can keep iterating over
+ * a contiguous array while looking elements up in expected constant time.
+ *
+ * Every engine exposes the same interface:
+ * - rebuild(hashes, n, capacity): discards the index and re-inserts the n
+ *   positions whose hash values are stored in 'hashes', sizing the index for
+ *   a dense array of 'capacity' elements;
+ * - find(hash, match): returns the first position p with the given hash value
+ *   for which match(p) is true, or npos;
+ * - insert(hash, pos), erase(hash, pos): add/remove a position;
+ * - move(hash, from, to): a position has been moved inside the dense array;
+ * - needs_rebuild(): true if the index must be rebuilt before the next insert;
+ * - stats(hashes): load factor and probe length statistics;
+ * - clear(), swap(other).
+*/
+
+#ifndef HASH_INDEX_HPP
+#define HASH_INDEX_HPP
+
+#include <algorithm> // std::swap
+#include <cstddef> // size_t
+
+#ifdef __SSE2__
+#include <emmintrin.h> // _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
+
+/**
+ * @brief Statistics of an index engine.
+ *
+ * The probe length of an element is the number of buckets (ChainedIndex
+ * chain links, or SwissIndex groups of 16 slots) visited by find() before the
+ * element is reached.
+*/
+struct IndexStats {
+  size_t slots; ///< Number of buckets or slots
+  size_t entries; ///< Number of indexed positions
+  size_t tombstones; ///< Number of slots marked as deleted
+  double load_factor; ///< entries / slots
+  double mean_probe_length; ///< Mean probe length of the indexed positions
+  size_t max_probe_length; ///< Maximum probe length of the indexed positions
+};
+
+/**
+ * @brief Separate chaining index engine.
+ *
+ * Each bucket stores the position of the first element of its chain, and
+ * each element stores the position of the next element of the same chain.
+ * The number of buckets is the smallest power of two not lower than the
+ * capacity of the dense array, so the load factor never exceeds 1.
+*/
+class ChainedIndex {
+public:
+  static const size_t npos = static_cast<size_t>(-1); ///< Position not found
+
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty index without buckets.
+  */
+  ChainedIndex() : _buckets(nullptr), _next(nullptr), _bucket_count(0), _count(0) {}
+
+  /**
+   * @brief Destructor.
+   *
+   * Deallocates the buckets and the chains.
+  */
+  ~ChainedIndex() {
+    clear();
+  }
+
+  /**
+   * @brief Empties the index.
+   *
+   * @post The buckets and the chains have been deallocated.
+  */
+  void clear(void) {
+    delete[] _buckets;
+    delete[] _next;
+    _buckets = nullptr;
+    _next = nullptr;
+    _bucket_count = 0;
+    _count = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The index to swap states with the current instance.
+  */
+  void swap(ChainedIndex& other) {
+    std::swap(_buckets, other._buckets);
+    std::swap(_next, other._next);
+    std::swap(_bucket_count, other._bucket_count);
+    std::swap(_count, other._count);
+  }
+
+  /**
+   * @brief Rebuilds the index for a dense array of a given capacity.
+   *
+   * @param hashes Hash values of the elements, by position.
+   * @param n Number of elements in the dense array.
+   * @param capacity Capacity of the dense array.
+   *
+   * @throw Allocation exception. The index is unchanged in that case.
+  */
+  void rebuild(const size_t* hashes, size_t n, size_t capacity) {
+    size_t count = 1;
+    while (count < capacity) {
+      count *= 2;
+    }
+
+    size_t* buckets = new size_t[count];
+    size_t* next = nullptr;
+    try {
+      next = new size_t[capacity > 0 ? capacity : 1];
+    } catch (...) {
+      delete[] buckets;
+      throw;
+    }
+
+    clear();
+    _buckets = buckets;
+    _next = next;
+    _bucket_count = count;
+
+    for (size_t i = 0; i < _bucket_count; ++i) {
+      _buckets[i] = npos;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      insert(hashes[i], i);
+    }
+  }
+
+  /**
+   * @brief Looks a position up.
+   *
+   * @param hash Hash value of the searched element.
+   * @param match Functor called with a candidate position, returns true if
+   * the element at that position is the searched one.
+   *
+   * @return The position of the element, or npos if it is not indexed.
+  */
+  template <typename Match>
+  size_t find(size_t hash, Match match) const {
+    if (_bucket_count == 0) return npos;
+
+    for (size_t p = _buckets[hash & (_bucket_count - 1)]; p != npos; p = _next[p]) {
+      if (match(p)) return p;
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Inserts a position in the index.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element in the dense array.
+  */
+  void insert(size_t hash, size_t pos) {
+    size_t& head = _buckets[hash & (_bucket_count - 1)];
+    _next[pos] = head;
+    head = pos;
+    ++_count;
+  }
+
+  /**
+   * @brief Removes a position from the index.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element in the dense array.
+  */
+  void erase(size_t hash, size_t pos) {
+    *link_to(hash, pos) = _next[pos];
+    --_count;
+  }
+
+  /**
+   * @brief Updates the index after an element has been moved.
+   *
+   * @param hash Hash value of the moved element.
+   * @param from Old position of the element in the dense array.
+   * @param to New position of the element in the dense array.
+  */
+  void move(size_t hash, size_t from, size_t to) {
+    *link_to(hash, from) = to;
+    _next[to] = _next[from];
+  }
+
+  /**
+   * @brief Tells if the index must be rebuilt before the next insert.
+   *
+   * @return Always false: chains never run out of room.
+  */
+  bool needs_rebuild() const {
+    return false;
+  }
+
+  /**
+   * @brief Computes the statistics of the index.
+   *
+   * The probe length of an element is its position (starting from 1) in its
+   * chain.
+   *
+   * @param hashes Hash values of the elements, by position (unused).
+   *
+   * @return The statistics of the index.
+  */
+  IndexStats stats(const size_t* hashes) const {
+    (void)hashes;
+    IndexStats s = { _bucket_count, _count, 0, 0.0, 0.0, 0 };
+    size_t total = 0;
+    for (size_t b = 0; b < _bucket_count; ++b) {
+      size_t length = 0;
+      for (size_t p = _buckets[b]; p != npos; p = _next[p]) {
+        ++length;
+        total += length;
+      }
+      if (length > s.max_probe_length) s.max_probe_length = length;
+    }
+    if (_bucket_count > 0) s.load_factor = static_cast<double>(_count) / _bucket_count;
+    if (_count > 0) s.mean_probe_length = static_cast<double>(total) / _count;
+    return s;
+  }
+
+private:
+  size_t* _buckets; ///< First position of each chain
+  size_t* _next; ///< Next position of the chain, by position
+  size_t _bucket_count; ///< Number of buckets (power of two)
+  size_t _count; ///< Number of indexed positions
+
+  ChainedIndex(const ChainedIndex&); // not copyable, rebuilt from the hashes
+  ChainedIndex& operator=(const ChainedIndex&);
+
+  /**
+   * @brief Finds the link pointing to a position.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element, which must be indexed.
+   *
+   * @return The bucket head or the chain link containing pos.
+  */
+  size_t* link_to(size_t hash, size_t pos) {
+    size_t* link = &_buckets[hash & (_bucket_count - 1)];
+    while (*link != pos) {
+      link = &_next[*link];
+    }
+    return link;
+  }
+};
+
+/**
+ * @brief Open addressing index engine in the style of Swiss tables.
+ *
+ * Positions are stored in a flat table of slots. Each slot has a control
+ * byte: EMPTY, DELETED, or the 7 lowest bits of the hash value (H2) when the
+ * slot is full. Slots are probed in groups of 16: a single SSE2 comparison
+ * of the 16 control bytes of a group against H2 returns the candidate slots,
+ * so a lookup miss usually costs one group of control bytes (a quarter of a
+ * cache line) and no comparison of elements at all. The remaining bits of the
+ * hash value (H1) select the first group; further groups are visited with a
+ * triangular (quadratic) probe sequence until a group with an EMPTY slot.
+ *
+ * The table is sized so that at most 7/8 of the slots are used. Removed
+ * positions leave DELETED tombstones, which are dropped on rebuild; the index
+ * reports through needs_rebuild() when tombstones have used up every EMPTY
+ * slot that can be given away.
+ *
+ * Without SSE2 the same groups are matched with a portable scalar loop.
+*/
+class SwissIndex {
+public:
+  static const size_t npos = static_cast<size_t>(-1); ///< Position not found
+  static const size_t GROUP = 16; ///< Number of slots probed at once
+
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty index without slots.
+  */
+  SwissIndex()
+    : _ctrl(nullptr), _slots(nullptr), _group_count(0), _count(0),
+      _tombstones(0), _growth_left(0) {}
+
+  /**
+   * @brief Destructor.
+   *
+   * Deallocates the control bytes and the slots.
+  */
+  ~SwissIndex() {
+    clear();
+  }
+
+  /**
+   * @brief Empties the index.
+   *
+   * @post The control bytes and the slots have been deallocated.
+  */
+  void clear(void) {
+    delete[] _ctrl;
+    delete[] _slots;
+    _ctrl = nullptr;
+    _slots = nullptr;
+    _group_count = 0;
+    _count = 0;
+    _tombstones = 0;
+    _growth_left = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The index to swap states with the current instance.
+  */
+  void swap(SwissIndex& other) {
+    std::swap(_ctrl, other._ctrl);
+    std::swap(_slots, other._slots);
+    std::swap(_group_count, other._group_count);
+    std::swap(_count, other._count);
+    std::swap(_tombstones, other._tombstones);
+    std::swap(_growth_left, other._growth_left);
+  }
+
+  /**
+   * @brief Rebuilds the index for a dense array of a given capacity.
+   *
+   * The number of slots is the smallest power of two (and multiple of 16)
+   * that keeps the load factor within 7/8 when the dense array is full.
+   *
+   * @param hashes Hash values of the elements, by position.
+   * @param n Number of elements in the dense array.
+   * @param capacity Capacity of the dense array.
+   *
+   * @throw Allocation exception. The index is unchanged in that case.
+  */
+  void rebuild(const size_t* hashes, size_t n, size_t capacity) {
+    size_t groups = 1;
+    while (groups * GROUP * 7 / 8 < capacity + 1) {
+      groups *= 2;
+    }
+
+    signed char* ctrl = new signed char[groups * GROUP];
+    size_t* slots = nullptr;
+    try {
+      slots = new size_t[groups * GROUP];
+    } catch (...) {
+      delete[] ctrl;
+      throw;
+    }
+
+    clear();
+    _ctrl = ctrl;
+    _slots = slots;
+    _group_count = groups;
+    _growth_left = groups * GROUP * 7 / 8;
+
+    for (size_t i = 0; i < groups * GROUP; ++i) {
+      _ctrl[i] = EMPTY;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      insert(hashes[i], i);
+    }
+  }
+
+  /**
+   * @brief Looks a position up.
+   *
+   * @param hash Hash value of the searched element.
+   * @param match Functor called with a candidate position, returns true if
+   * the element at that position is the searched one.
+   *
+   * @return The position of the element, or npos if it is not indexed.
+  */
+  template <typename Match>
+  size_t find(size_t hash, Match match) const {
+    if (_group_count == 0) return npos;
+
+    size_t g = h1(hash) & (_group_count - 1);
+    for (size_t i = 1; i <= _group_count; ++i) {
+      const signed char* ctrl = _ctrl + g * GROUP;
+      for (unsigned bits = match_byte(ctrl, h2(hash)); bits != 0; bits &= bits - 1) {
+        size_t pos = _slots[g * GROUP + lowest_bit(bits)];
+        if (match(pos)) return pos;
+      }
+      if (match_byte(ctrl, EMPTY) != 0) return npos;
+      g = (g + i) & (_group_count - 1);
+    }
+    return npos;
+  }
+
+  /**
+   * @brief Inserts a position in the index.
+   *
+   * The position is stored in the first EMPTY or DELETED slot of the probe
+   * sequence.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element in the dense array.
+   *
+   * @pre needs_rebuild() is false.
+  */
+  void insert(size_t hash, size_t pos) {
+    size_t g = h1(hash) & (_group_count - 1);
+    for (size_t i = 1; ; ++i) {
+      const signed char* ctrl = _ctrl + g * GROUP;
+      unsigned bits = match_byte(ctrl, EMPTY) | match_byte(ctrl, DELETED);
+      if (bits != 0) {
+        size_t slot = g * GROUP + lowest_bit(bits);
+        if (_ctrl[slot] == DELETED) {
+          --_tombstones;
+        } else {
+          --_growth_left;
+        }
+        _ctrl[slot] = static_cast<signed char>(h2(hash));
+        _slots[slot] = pos;
+        ++_count;
+        return;
+      }
+      g = (g + i) & (_group_count - 1);
+    }
+  }
+
+  /**
+   * @brief Removes a position from the index.
+   *
+   * The slot becomes EMPTY if its group still has an EMPTY slot (so no probe
+   * sequence ever went past it), DELETED otherwise.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element in the dense array.
+  */
+  void erase(size_t hash, size_t pos) {
+    size_t slot = slot_of(hash, pos);
+    if (match_byte(_ctrl + (slot / GROUP) * GROUP, EMPTY) != 0) {
+      _ctrl[slot] = EMPTY;
+      ++_growth_left;
+    } else {
+      _ctrl[slot] = DELETED;
+      ++_tombstones;
+    }
+    --_count;
+  }
+
+  /**
+   * @brief Updates the index after an element has been moved.
+   *
+   * @param hash Hash value of the moved element.
+   * @param from Old position of the element in the dense array.
+   * @param to New position of the element in the dense array.
+  */
+  void move(size_t hash, size_t from, size_t to) {
+    _slots[slot_of(hash, from)] = to;
+  }
+
+  /**
+   * @brief Tells if the index must be rebuilt before the next insert.
+   *
+   * @return true if tombstones have used up the EMPTY slots that could be
+   * given away without exceeding the maximum load factor.
+  */
+  bool needs_rebuild() const {
+    return _group_count > 0 && _growth_left == 0;
+  }
+
+  /**
+   * @brief Computes the statistics of the index.
+   *
+   * The probe length of an element is the number of groups visited to reach
+   * it (1 if it is in the group selected by its hash value).
+   *
+   * @param hashes Hash values of the elements, by position.
+   *
+   * @return The statistics of the index.
+  */
+  IndexStats stats(const size_t* hashes) const {
+    IndexStats s = { _group_count * GROUP, _count, _tombstones, 0.0, 0.0, 0 };
+    size_t total = 0;
+    for (size_t slot = 0; slot < _group_count * GROUP; ++slot) {
+      if (_ctrl[slot] < 0) continue;
+
+      // Walk the probe sequence of the element until the group of the slot
+      size_t g = h1(hashes[_slots[slot]]) & (_group_count - 1);
+      size_t length = 1;
+      while (g != slot / GROUP) {
+        g = (g + length) & (_group_count - 1);
+        ++length;
+      }
+      total += length;
+      if (length > s.max_probe_length) s.max_probe_length = length;
+    }
+    if (_group_count > 0) s.load_factor = static_cast<double>(_count) / (_group_count * GROUP);
+    if (_count > 0) s.mean_probe_length = static_cast<double>(total) / _count;
+    return s;
+  }
+
+private:
+  static const signed char EMPTY = -128; ///< Control byte of an empty slot
+  static const signed char DELETED = -2; ///< Control byte of a tombstone
+
+  signed char* _ctrl; ///< Control byte of each slot
+  size_t* _slots; ///< Position stored in each slot
+  size_t _group_count; ///< Number of groups of slots (power of two)
+  size_t _count; ///< Number of indexed positions
+  size_t _tombstones; ///< Number of DELETED slots
+  size_t _growth_left; ///< EMPTY slots that can still be filled
+
+  SwissIndex(const SwissIndex&); // not copyable, rebuilt from the hashes
+  SwissIndex& operator=(const SwissIndex&);
+
+  /**
+   * @brief Bits of the hash value selecting the first group.
+  */
+  static size_t h1(size_t hash) { return hash >> 7; }
+
+  /**
+   * @brief Bits of the hash value stored in the control byte.
+  */
+  static size_t h2(size_t hash) { return hash & 0x7F; }
+
+  /**
+   * @brief Index of the lowest set bit of a non zero mask.
+  */
+  static unsigned lowest_bit(unsigned bits) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctz(bits));
+#else
+    unsigned i = 0;
+    while (!(bits & 1u)) {
+      bits >>= 1;
+      ++i;
+    }
+    return i;
+#endif
+  }
+
+  /**
+   * @brief Matches the control bytes of a group against a value.
+   *
+   * @param ctrl Pointer to the first control byte of the group.
+   * @param value Control byte to be matched.
+   *
+   * @return A mask whose bit i is set if ctrl[i] == value.
+  */
+  static unsigned match_byte(const signed char* ctrl, signed char value) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<unsigned>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(value))));
+#else
+    unsigned bits = 0;
+    for (size_t i = 0; i < GROUP; ++i) {
+      if (ctrl[i] == value) bits |= 1u << i;
+    }
+    return bits;
+#endif
+  }
+
+  /**
+   * @brief Finds the slot storing a position.
+   *
+   * @param hash Hash value of the element.
+   * @param pos Position of the element, which must be indexed.
+   *
+   * @return The slot storing pos.
+  */
+  size_t slot_of(size_t hash, size_t pos) const {
+    size_t g = h1(hash) & (_group_count - 1);
+    for (size_t i = 1; ; ++i) {
+      for (unsigned bits = match_byte(_ctrl + g * GROUP, h2(hash)); bits != 0; bits &= bits - 1) {
+        size_t slot = g * GROUP + lowest_bit(bits);
+        if (_slots[slot] == pos) return slot;
+      }
+      g = (g + i) & (_group_count - 1);
+    }
+  }
+};
+
+#endif // HASH_INDEX_HPP
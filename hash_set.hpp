@@ -0,0 +1,858 @@
+/**
+ * @file hash_set.hpp
+ *
+ * @brief Header file for the templated HashSet class.
+ *
+ * Declaration/Definition of the templated HashSet class, a hash indexed
+ * sibling of Set.
+*/
+
+#ifndef HASH_SET_HPP
+#define HASH_SET_HPP
+
+#include <iostream>
+#include <algorithm> // std::swap
+#include <ostream> // std::ostream
+#include <stdexcept> // std::out_of_range
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <fstream> // std::ofstream
+#include <utility> // std::move, std::forward
+#include <new> // placement new
+#include "raw_storage.hpp"
+#include "hash.hpp"
+#include "hash_index.hpp"
+
+/**
+ * @brief HashSet Class
+ *
+ * Generic Set of type T elements, with the same interface of Set. The
+ * elements are stored in a dynamic array exactly like in Set (so iteration
+ * and operator[] work in the same way), but every element is also registered
+ * in an index engine by its hash value. This makes add, remove and contains
+ * take expected constant time instead of scanning the whole array.
+ * The array is doubled in size when full and halved when only one quarter or
+ * less of its capacity is being used; the index is rebuilt on every resize.
+ *
+ * @tparam T Type of the elements in the HashSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam Hash Functor used for hashing an element. Two elements that are
+ * equal according to Equal must have the same hash value.
+ * @tparam Index Index engine mapping hash values to array positions.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T>,
+          typename Index = ChainedIndex>
+class HashSet {
+private:
+  T* _array; ///< Pointer to the array (raw storage beyond _num_elements)
+  size_t* _hashes; ///< Hash value of each element of the array
+  size_t _size; ///< Capacity of the array (at a given moment)
+  size_t _num_elements; ///< Number of elements currently in the HashSet
+  Equal _equal; ///< Instance of the Equal functor
+  Hash _hash; ///< Instance of the Hash functor
+  Index _index; ///< Index from hash values to positions in the array
+
+  /**
+   * @brief Functor matching an array position against a value.
+  */
+  struct Match {
+    const HashSet* set; ///< HashSet being searched
+    const T* value; ///< Value being searched
+    size_t hash; ///< Hash value of the value being searched
+
+    bool operator()(size_t pos) const {
+      return set->_hashes[pos] == hash && set->_equal(set->_array[pos], *value);
+    }
+  };
+
+  /**
+   * @brief Finds the position of an element.
+   *
+   * @param value The element to search for.
+   * @param hash The hash value of the element.
+   *
+   * @return The position of the element in the array, or Index::npos.
+  */
+  size_t find(const T& value, size_t hash) const {
+    Match match = { this, &value, hash };
+    return _index.find(hash, match);
+  }
+
+  /**
+   * @brief Resizes the dynamic array used by the HashSet.
+   *
+   * This function resizes the internal array of the HashSet and rebuilds the
+   * index for the new capacity. The new index is built aside and the elements
+   * are relocated last (see detail::relocate), so that if anything throws the
+   * HashSet is left unchanged.
+   *
+   * @param increase A boolean indicating whether to increase (true) or
+   * decrease (false) the array size.
+   *
+   * @throw Allocation exception.
+  */
+  void resize(bool increase) {
+    size_t new_size;
+    if (increase) {
+      new_size = _size > 0 ? _size * 2 : 1;
+    } else {
+      new_size = _size / 2;
+    }
+
+    size_t* new_hashes = nullptr;
+
+    try {
+      new_hashes = new size_t[new_size > 0 ? new_size : 1];
+      for (size_t i = 0; i < _num_elements; ++i) {
+        new_hashes[i] = _hashes[i];
+      }
+
+      Index new_index;
+      new_index.rebuild(new_hashes, _num_elements, new_size);
+
+      _array = detail::relocate(_array, _num_elements, _size, new_size);
+      delete[] _hashes;
+      _hashes = new_hashes;
+      _index.swap(new_index);
+      _size = new_size;
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in resize: " << e.what() << '\n';
+      delete[] new_hashes; // Clean up new hashes in case of exception
+      throw; // Re-throw the exception
+    }
+  }
+
+  /**
+   * @brief Adds a new element to the HashSet, copying or moving it.
+   *
+   * @param value The element to be added, forwarded to the array.
+   * @param hash The hash value of the element.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename U>
+  bool insert(U&& value, size_t hash) {
+    if (find(value, hash) != Index::npos) {
+      return false;
+    }
+
+    if (_num_elements == _size) {
+      resize(true);
+    } else if (_index.needs_rebuild()) {
+      _index.rebuild(_hashes, _num_elements, _size); // Drop the tombstones
+    }
+
+    ::new (static_cast<void*>(_array + _num_elements)) T(std::forward<U>(value));
+    _hashes[_num_elements] = hash;
+    _index.insert(hash, _num_elements);
+    ++_num_elements;
+    return true;
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty HashSet.
+   *
+   * @post _array == nullptr
+   * @post _size == 0
+   * @post _num_elements == 0
+  */
+  HashSet() : _array(nullptr), _hashes(nullptr), _size(0), _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Creates a new HashSet by copying the elements from another HashSet. The
+   * stored hash values are copied as well, so the elements are not rehashed.
+   *
+   * @param other HashSet from which to copy the elements.
+   *
+   * @throw Allocation exception.
+  */
+  HashSet(const HashSet& other)
+    : _array(nullptr), _hashes(nullptr), _size(0), _num_elements(0),
+      _equal(other._equal), _hash(other._hash) {
+    try {
+      _array = detail::allocate<T>(other._size);
+      _size = other._size;
+      _hashes = new size_t[_size > 0 ? _size : 1];
+
+      detail::copy_construct(other._array, other._array + other._num_elements, _array);
+      _num_elements = other._num_elements;
+      for (size_t i = 0; i < _num_elements; ++i) {
+        _hashes[i] = other._hashes[i];
+      }
+
+      _index.rebuild(_hashes, _num_elements, _size);
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
+      empty(); // Clean up arrays in case of exception
+      throw;
+    }
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * Assigns the content of the specified 'other' HashSet to this HashSet. It
+   * creates a copy of the 'other' HashSet and then swaps its contents with
+   * this HashSet.
+   *
+   * @param other The HashSet object to be copied.
+   *
+   * @return A reference to this HashSet after the assignment.
+   *
+   * @throw Allocation exception.
+  */
+  HashSet& operator=(const HashSet& other) {
+    if (&other != this) {
+      HashSet tmp(other);
+      this->swap(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new HashSet by taking over the array and the index of another
+   * HashSet, without copying any element.
+   *
+   * @param other HashSet from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  HashSet(HashSet&& other) noexcept
+    : _array(nullptr), _hashes(nullptr), _size(0), _num_elements(0),
+      _equal(other._equal), _hash(other._hash) {
+    this->swap(other);
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the elements of this HashSet and takes over the array and the
+   * index of 'other', without copying any element.
+   *
+   * @param other The HashSet from which to take the elements.
+   *
+   * @return A reference to this HashSet after the assignment.
+   *
+   * @post other is empty.
+  */
+  HashSet& operator=(HashSet&& other) noexcept {
+    if (&other != this) {
+      empty();
+      this->swap(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   *
+   * Safely deallocates the dynamic memory used by the HashSet. Utilizes the
+   * empty() function to do so.
+   *
+   * @post The internal memory has been deallocated.
+  */
+  ~HashSet() {
+    empty();
+  }
+
+  /**
+   * @brief Empties the HashSet.
+   *
+   * Safely deallocates the dynamic memory used by the HashSet.
+   *
+   * @post The internal memory has been deallocated.
+   * @post _array == nullptr
+   * @post _num_elements = 0
+   * @post _size = 0
+  */
+  void empty(void) {
+    detail::destroy(_array, _array + _num_elements);
+    detail::deallocate(_array, _size);
+    delete[] _hashes;
+    _index.clear();
+    _array = nullptr;
+    _hashes = nullptr;
+    _num_elements = 0;
+    _size = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * Swaps the state between the current instance of HashSet and the instance
+   * provided as a parameter.
+   *
+   * @param other The HashSet instance to swap states with the current
+   * instance.
+  */
+  void swap(HashSet& other) {
+    std::swap(_num_elements, other._num_elements);
+    std::swap(_size, other._size);
+    std::swap(_array, other._array);
+    std::swap(_hashes, other._hashes);
+    std::swap(_equal, other._equal);
+    std::swap(_hash, other._hash);
+    _index.swap(other._index);
+  }
+
+  /**
+   * @brief Adds a new element to the HashSet.
+   *
+   * Inserts the value into the HashSet if it is not already present.
+   * If the HashSet gets full, the _array gets resized (doubled in size).
+   *
+   * @param value The element of type T to be added to the HashSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @note If an exception is thrown during resizing, the state of HashSet
+   * hasn't been changed yet, mantaining the HashSet in a consistent state.
+  */
+  bool add(const T& value) {
+    return insert(value, _hash(value));
+  }
+
+  /**
+   * @brief Adds a new element to the HashSet, moving it.
+   *
+   * Same as add(const T&), but the value is moved into the array instead of
+   * being copied. If the value is already contained, it is left untouched.
+   *
+   * @param value The element of type T to be moved into the HashSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    size_t hash = _hash(value);
+    return insert(std::move(value), hash);
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the
+   * HashSet.
+   *
+   * The element is constructed once, hashed and then moved into the array.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    size_t hash = _hash(value);
+    return insert(std::move(value), hash);
+  }
+
+  /**
+   * @brief Removes an element from the HashSet.
+   *
+   * If the value is present in the HashSet, it is removed. If the element is
+   * not found, the HashSet remains unchanged. The HashSet is resized if it
+   * becomes significantly underutilized as a result of the removal.
+   *
+   * @param value The element of type T to be removed from the HashSet.
+   *
+   * @return true if the element was removed, false if it is not contained.
+   *
+   * @note If an exception is thrown during resizing, the element will still
+   * be removed, but the internal array may not be resized. By doing this, the
+   * HashSet will mantain a consistent state.
+  */
+  bool remove(const T& value) {
+    size_t hash = _hash(value);
+    size_t pos = find(value, hash);
+    if (pos == Index::npos) {
+      return false;
+    }
+
+    size_t last = _num_elements - 1;
+    _index.erase(hash, pos);
+    if (pos != last) {
+      // Overwrite the removed element with the last element in the array
+      _index.move(_hashes[last], last, pos);
+      _array[pos] = std::move(_array[last]);
+      _hashes[pos] = _hashes[last];
+    }
+    _array[last].~T();
+    --_num_elements;
+
+    if (_num_elements <= _size / 4) {
+      resize(false);
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Accesses the element at the specified index.
+   *
+   * Provides read-only access to the element at the given index.
+   *
+   * @param index The index of the element to access.
+   *
+   * @return A const reference to the element at the specified index.
+   *
+   * @throw std::out_of_range If the index is out of the bounds of the HashSet.
+  */
+  const T& operator[](int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= _num_elements) {
+      throw std::out_of_range("Index out of range");
+    }
+    return _array[index];
+  }
+
+  /**
+   * @brief Checks if the HashSet contains a specific element.
+   *
+   * Looks the hash value of the element up in the index, and compares only
+   * the elements with the same hash value using the custom equality functor.
+   *
+   * @param value The element to search for in the HashSet.
+   *
+   * @return true if the element is found in the HashSet, false otherwise.
+  */
+  bool contains(const T& value) const {
+    return find(value, _hash(value)) != Index::npos;
+  }
+
+  /**
+   * Returns the number of elements stored inside of the HashSet
+   *
+   * @return number of elements stored inside of the HashSet
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Returns the index engine of the HashSet.
+   *
+   * @return A const reference to the index engine.
+  */
+  const Index& index() const {
+    return _index;
+  }
+
+  /**
+   * @brief Computes the load factor and probe length statistics of the index.
+   *
+   * Meant for tuning: the statistics are computed by walking the whole index.
+   *
+   * @return The statistics of the index engine.
+  */
+  IndexStats index_stats() const {
+    return _index.stats(_hashes);
+  }
+
+  /**
+   * @brief Constant forward iterator for the HashSet class.
+   *
+   * This iterator provides read-only access to the elements of the HashSet,
+   * in the order in which they are stored in the dense array.
+  */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef const T* pointer; ///< Pointer to the constant element type
+    typedef const T& reference; ///< Reference to the constant element type
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes the iterator to a null pointer.
+    */
+    const_iterator() : _ptr(nullptr) {}
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @param other Another const_iterator to be copied.
+    */
+    const_iterator(const const_iterator &other) : _ptr(other._ptr) {}
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @param other Another const_iterator to be assigned from.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator=(const const_iterator &other) {
+      _ptr = other._ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Destructor.
+    */
+    ~const_iterator() {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return A reference to the element pointed to by the iterator.
+    */
+    reference operator*() const { return *_ptr; }
+
+    /**
+     * @brief Arrow operator.
+     *
+     * @return A pointer to the element pointed to by the iterator.
+    */
+    pointer operator->() const { return _ptr; }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator++() {
+      ++_ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return Copy of the original iterator.
+    */
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if both iterators point to same element, false otherwise.
+    */
+    bool operator==(const const_iterator &other) const {
+      return _ptr == other._ptr;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if iterators point to different element, false otherwise.
+    */
+    bool operator!=(const const_iterator &other) const {
+      return _ptr != other._ptr;
+    }
+
+  private:
+    pointer _ptr; ///< Pointer to the current element in the HashSet.
+
+    friend class HashSet; ///< Allow HashSet class to access private constructor.
+
+    /**
+     * @brief Constructor for internal use by the HashSet class.
+     *
+     * @param ptr Pointer to the current element in the HashSet.
+    */
+    const_iterator(pointer ptr) : _ptr(ptr) {}
+
+  }; //const_iterator class
+
+  /**
+   * @brief Returns an iterator to the beginning of the HashSet.
+   *
+   * @return A const_iterator to the first element of the HashSet.
+  */
+  const_iterator begin() const {
+    return const_iterator(_array);
+  }
+
+  /**
+   * @brief Returns an iterator to the end of the HashSet.
+   *
+   * @return A const_iterator to the element following the last element of the
+   * HashSet.
+  */
+  const_iterator end() const {
+    return const_iterator(_array + _num_elements);
+  }
+
+  /**
+   * Constructor that creates a HashSet from a range defined by two iterators.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+  */
+  template <typename IteratorQ>
+  HashSet(IteratorQ begin, IteratorQ end)
+    : _array(nullptr), _hashes(nullptr), _size(0), _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        add(*it);
+      }
+    } catch (const std::exception& e) {
+      empty();
+      std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Stream operator for the HashSet class.
+   *
+   * The output format is the same of Set: the number of elements followed by
+   * each element between round brackets.
+   *
+   * @param os The output stream to which the HashSet data will be sent.
+   * @param set The HashSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the HashSet data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const HashSet& set) {
+    os << set._num_elements;
+    for (size_t i = 0; i < set._num_elements; ++i) {
+      os << " (" << set._array[i] << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for HashSet.
+   *
+   * Two HashSets are considered equal if they contain the same elements.
+   * Each element of the other HashSet is looked up in this one, so the
+   * comparison takes expected linear time.
+   *
+   * @param other The HashSet to compare with.
+   *
+   * @return True if the HashSets contain the same elements, false otherwise.
+  */
+  bool operator==(const HashSet& other) const {
+    if (_num_elements != other._num_elements) return false;
+
+    for (size_t i = 0; i < other._num_elements; ++i) {
+      if (find(other._array[i], other._hashes[i]) == Index::npos) return false;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a HashSet, based on a predicate.
+ *
+ * This function creates a new HashSet containing elements from the original
+ * HashSet that satisfy the given predicate.
+ *
+ * @param S The original HashSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new HashSet.
+ *
+ * @return A new HashSet containing elements that satisfy the predicate P.
+*/
+template <typename T, typename Equal, typename Hash, typename Index, typename Predicate>
+HashSet<T, Equal, Hash, Index> filter_out(const HashSet<T, Equal, Hash, Index>& S, Predicate P) {
+  HashSet<T, Equal, Hash, Index> new_set;
+  try {
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = S.begin(); it != S.end(); ++it) {
+      if (P(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the addition operator to concatenate two HashSets.
+ *
+ * Creates a new HashSet that represents the union of 'a' and 'b': a copy of
+ * 'a' followed by the elements of 'b' that are not in 'a'.
+ *
+ * @param a The first HashSet to be concatenated.
+ * @param b The second HashSet to be concatenated.
+ *
+ * @return A new HashSet containing all elements from both 'a' and 'b', with
+ * duplicates removed.
+*/
+template <typename T, typename Equal, typename Hash, typename Index>
+HashSet<T, Equal, Hash, Index> operator+(const HashSet<T, Equal, Hash, Index>& a,
+                                         const HashSet<T, Equal, Hash, Index>& b) {
+  HashSet<T, Equal, Hash, Index> new_set = a;
+  try {
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = b.begin(); it != b.end(); ++it) {
+      new_set.add(*it);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in operator+: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the intersection of two HashSets.
+ *
+ * This function creates a new HashSet containing the elements of 'a' that are
+ * also present in 'b', in the order in which they are stored in 'a'.
+ *
+ * @param a The first HashSet to intersect.
+ * @param b The second HashSet to intersect.
+ *
+ * @return A new HashSet containing the intersection of 'a' and 'b'.
+*/
+template <typename T, typename Equal, typename Hash, typename Index>
+HashSet<T, Equal, Hash, Index> intersection(const HashSet<T, Equal, Hash, Index>& a,
+                                            const HashSet<T, Equal, Hash, Index>& b) {
+  HashSet<T, Equal, Hash, Index> new_set;
+  try {
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of
+ * two HashSets.
+ *
+ * Same as intersection(a, b).
+ *
+ * @param a The first HashSet to intersect.
+ * @param b The second HashSet to intersect.
+ *
+ * @return A new HashSet containing the intersection of 'a' and 'b'.
+ *
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <typename T, typename Equal, typename Hash, typename Index>
+HashSet<T, Equal, Hash, Index> operator-(const HashSet<T, Equal, Hash, Index>& a,
+                                         const HashSet<T, Equal, Hash, Index>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two HashSets.
+ *
+ * Creates a new HashSet with the elements of 'a' that are not contained in
+ * 'b', in the order in which they are stored in 'a'.
+ *
+ * @param a The HashSet whose elements are kept.
+ * @param b The HashSet whose elements are removed.
+ *
+ * @return A new HashSet containing a \ b.
+*/
+template <typename T, typename Equal, typename Hash, typename Index>
+HashSet<T, Equal, Hash, Index> difference(const HashSet<T, Equal, Hash, Index>& a,
+                                          const HashSet<T, Equal, Hash, Index>& b) {
+  HashSet<T, Equal, Hash, Index> new_set;
+  try {
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (!b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the symmetric difference of two HashSets.
+ *
+ * Creates a new HashSet with the elements of 'a' not contained in 'b',
+ * followed by the elements of 'b' not contained in 'a'.
+ *
+ * @param a The first HashSet.
+ * @param b The second HashSet.
+ *
+ * @return A new HashSet containing (a \ b) U (b \ a).
+*/
+template <typename T, typename Equal, typename Hash, typename Index>
+HashSet<T, Equal, Hash, Index> symmetric_difference(const HashSet<T, Equal, Hash, Index>& a,
+                                                    const HashSet<T, Equal, Hash, Index>& b) {
+  HashSet<T, Equal, Hash, Index> new_set;
+  try {
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (!b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+    for (typename HashSet<T, Equal, Hash, Index>::const_iterator it = b.begin(); it != b.end(); ++it) {
+      if (!a.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Saves the contents of a HashSet to a file.
+ *
+ * This function writes the contents of a given HashSet to a file specified by
+ * 'filename'. The HashSet is output using the overriden 'operator<<'.
+ *
+ * @param set The HashSet to be saved to the file.
+ * @param filename The name of the file to which the HashSet's contents will be
+ *                 saved.
+ *
+ * @note The function does not return a value or throw exceptions, but it
+ * reports to stderr if the file cannot be opened.
+*/
+template <typename Equal, typename Hash, typename Index>
+void save(const HashSet<std::string, Equal, Hash, Index>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+/**
+ * @brief HashSet using the SwissIndex open addressing engine.
+ *
+ * @tparam T Type of the elements in the SwissSet.
+ * @tparam Equal Functor used for comparing two elements for equality.
+ * @tparam Hash Functor used for hashing an element.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T> >
+using SwissSet = HashSet<T, Equal, Hash, SwissIndex>;
+
+#endif // HASH_SET_HPP
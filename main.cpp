@@ -9,14 +9,28 @@
 #include <sstream>
 #include <fstream>
 #include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <set>
 #include "set.hpp"
+#include "hash_set.hpp"
+#include "sorted_set.hpp"
+#include "small_set.hpp"
+#include "bit_set.hpp"
+#include "roaring_set.hpp"
+#include "parallel.hpp"
+#include "concurrent_set.hpp"
+#include "sharded_set.hpp"
+#include "rcu_set.hpp"
+#include "persistent_set.hpp"
 
 class Person {
 public:
   std::string name;
   int age;
 
-  Person() : name(""), age(-1) {}
   Person(std::string name, int age) : name(name), age(age) {}
 
   friend std::ostream& operator<<(std::ostream& os, const Person& person);
@@ -33,9 +47,167 @@ struct EqualPerson {
   }
 };
 
+struct HashPerson {
+  size_t operator()(const Person& p) const {
+    size_t seed = 0;
+    hash_combine(seed, p.name);
+    hash_combine(seed, p.age);
+    return seed;
+  }
+};
+
+template <>
+struct HashTraits<Person, EqualPerson> {
+  static const bool enabled = true;
+  typedef HashPerson hasher;
+};
+
+// Same equality as EqualPerson, hashed by name only: namesakes collide
+struct EqualNamesake {
+  bool operator()(const Person& a, const Person& b) const {
+    return EqualPerson()(a, b);
+  }
+};
+
+struct HashName {
+  size_t operator()(const Person& p) const {
+    return DefaultHash<std::string>()(p.name);
+  }
+};
+
+template <>
+struct HashTraits<Person, EqualNamesake> {
+  static const bool enabled = true;
+  typedef HashName hasher;
+};
+
+struct LessPerson {
+  bool operator()(const Person& a, const Person& b) const {
+    return a.name < b.name || (a.name == b.name && a.age < b.age);
+  }
+};
+
+struct EqualPointee {
+  bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const {
+    return *a == *b;
+  }
+  bool operator()(const std::unique_ptr<int>& a, int b) const {
+    return *a == b;
+  }
+};
+
+class Tracked {
+public:
+  static int live; ///< Number of Tracked objects currently alive
+
+  int value;
+
+  explicit Tracked(int value) : value(value) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked& operator=(const Tracked&) = default;
+  ~Tracked() { --live; }
+
+  bool operator==(const Tracked& other) const { return value == other.value; }
+};
+
+int Tracked::live = 0;
+
+/**
+ * Stateful allocator counting the elements it currently holds. Two instances
+ * are equal when they share the same counter; they never propagate.
+*/
+template <typename T>
+class CountingAllocator {
+public:
+  typedef T value_type;
+
+  int* held; ///< Number of elements currently allocated through the counter
+
+  explicit CountingAllocator(int* held) : held(held) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& other) : held(other.held) {}
+
+  T* allocate(size_t n) {
+    *held += static_cast<int>(n);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) {
+    *held -= static_cast<int>(n);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  bool operator==(const CountingAllocator& other) const { return held == other.held; }
+  bool operator!=(const CountingAllocator& other) const { return held != other.held; }
+};
+
+#if __cplusplus >= 201703L
+/**
+ * Memory resource forwarding to another one, counting the allocations.
+*/
+class CountingResource : public std::pmr::memory_resource {
+public:
+  std::pmr::memory_resource* upstream;
+  int allocations;
+
+  explicit CountingResource(std::pmr::memory_resource* upstream)
+    : upstream(upstream), allocations(0) {}
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    return upstream->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    upstream->deallocate(p, bytes, alignment);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+#endif
+
 typedef Set<int, std::equal_to<int>> intSet;
 typedef Set<std::string, std::equal_to<std::string>> stringSet;
 typedef Set<Person, EqualPerson> personSet;
+typedef Set<std::unique_ptr<int>, EqualPointee> uniquePtrSet;
+typedef HashSet<int, std::equal_to<int>> intHashSet;
+typedef HashSet<std::string, std::equal_to<std::string>> stringHashSet;
+typedef HashSet<Person, EqualPerson, HashPerson> personHashSet;
+typedef SwissSet<int, std::equal_to<int>> intSwissSet;
+typedef SwissSet<std::string, std::equal_to<std::string>> stringSwissSet;
+typedef SortedSet<int> intSortedSet;
+typedef SortedSet<std::string> stringSortedSet;
+typedef SortedSet<Person, LessPerson> personSortedSet;
+
+typedef SmallSet<int, std::equal_to<int>> intSmallSet;
+typedef SmallSet<std::string, std::equal_to<std::string>, 4> stringSmallSet;
+typedef SmallSet<Person, EqualPerson, 2> personSmallSet;
+
+typedef BitSet<1000> intBitSet;
+
+typedef RoaringSet<unsigned> idRoaringSet;
+
+typedef ConcurrentSet<int, std::equal_to<int>> intConcurrentSet;
+typedef ConcurrentSet<std::string, std::equal_to<std::string>> stringConcurrentSet;
+
+typedef ShardedSet<int, std::equal_to<int>> intShardedSet;
+typedef ShardedSet<std::string, std::equal_to<std::string>> stringShardedSet;
+
+typedef RcuSet<int, std::equal_to<int>> intRcuSet;
+
+/**
+ * @brief Hash functor with only 4 distinct values, to exercise the collision
+ * nodes of PersistentSet.
+*/
+struct CollidingHash {
+  size_t operator()(int value) const {
+    return static_cast<size_t>(value & 3);
+  }
+};
+
+typedef PersistentSet<int, std::equal_to<int>> intPersistentSet;
+typedef PersistentSet<std::string, std::equal_to<std::string>> stringPersistentSet;
+typedef PersistentSet<int, std::equal_to<int>, CollidingHash> collidingPersistentSet;
 
 void testCopyConstructorInt() {
   intSet originalSet;
@@ -68,6 +240,105 @@ void testAssignmentOperatorInt() {
   std::cout << "testAssignmentOperatorInt() passed" << std::endl;
 }
 
+void testCopyOnWriteInt() {
+  intSet original;
+  for (int i = 0; i < 100; ++i) {
+    original.add(i);
+  }
+
+  // Copies and assignments share the array
+  intSet copy(original);
+  intSet assigned;
+  assigned = original;
+  assert(copy.data() == original.data() && assigned.data() == original.data());
+  assert(copy == original && assigned.capacity() == original.capacity());
+
+  // The first change clones it, leaving the other Sets untouched
+  assert(copy.add(100) && copy.data() != original.data());
+  assert(copy.getNumElements() == 101 && original.getNumElements() == 100 && !original.contains(100));
+  assert(!assigned.remove(-1) && assigned.data() == original.data());
+  assert(assigned.remove(0) && !assigned.contains(0) && original.contains(0));
+
+  intSet emptied(original);
+  emptied.empty();
+  assert(emptied.getNumElements() == 0 && original.getNumElements() == 100 && original.contains(99));
+
+  // Every changing method clones first
+  intSet removed(original);
+  assert(removed.remove_if([](int v) { return v % 2 == 0; }) == 50 && original.contains(0));
+  intSet emplaced(original);
+  assert(emplaced.emplace(200) && emplaced.try_emplace(201, 201) && !original.contains(200));
+  std::vector<int> range = {300, 301, 5};
+  intSet ranged(original);
+  assert(ranged.add_range(range.begin(), range.end()) == 2 && !original.contains(300));
+  intSet reserved(original);
+  reserved.reserve(1000);
+  assert(reserved.capacity() == 1000 && original.capacity() < 1000 && reserved == original);
+  intSet compound(original);
+  compound += copy;
+  compound -= assigned;
+  assert(compound.getNumElements() == 99 && !compound.contains(0) && original.getNumElements() == 100);
+
+  // A full shared array is cloned directly into the grown capacity
+  intSet full;
+  for (int i = 0; i < 16; ++i) {
+    full.add(i);
+  }
+  intSet grown(full);
+  assert(grown.add(16) && grown.capacity() == 32 && full.capacity() == 16);
+  assert(!grown.emplace(3) && !full.emplace(3) && full.data() != grown.data());
+
+  // A shared array is cloned with room for the element being removed, even
+  // when the Policy shrinks just to the remaining elements
+  typedef Set<long, std::equal_to<long>, GrowthPolicy<4, 1, 4> > TightSet;
+  TightSet tight;
+  for (long i = 0; i < 5; ++i) {
+    tight.add(i);
+  }
+  assert(tight.capacity() == 16);
+  TightSet shrunk(tight);
+  assert(shrunk.remove(4) && shrunk.getNumElements() == 4 && shrunk.capacity() >= 4);
+  assert(!shrunk.contains(4) && shrunk.contains(0) && shrunk.contains(3));
+  assert(tight.getNumElements() == 5 && tight.contains(4) && tight.capacity() == 16);
+
+  // The last Set sharing an array changes it in place again
+  intSet last(original);
+  original.empty();
+  const int* shared = last.data();
+  assert(last.add(-1) && last.data() == shared);
+
+  std::cout << "testCopyOnWriteInt() passed" << std::endl;
+}
+
+void testCopyOnWriteThreads() {
+  stringSet original;
+  for (int i = 0; i < 200; ++i) {
+    original.add(std::to_string(i));
+  }
+
+  // Threads copying the same Set and changing or dropping their copies
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.push_back(std::thread([&original, t]() {
+      for (int round = 0; round < 50; ++round) {
+        stringSet copy(original);
+        if (round % 2 == 0) {
+          copy.add("thread " + std::to_string(t));
+          copy.remove(std::to_string(round));
+          assert(copy.getNumElements() == 200 && !copy.contains(std::to_string(round)));
+        }
+        stringSet second;
+        second = copy;
+        assert(second == copy);
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t) threads[t].join();
+  assert(original.getNumElements() == 200 && original.contains("0") && !original.contains("thread 0"));
+
+  std::cout << "testCopyOnWriteThreads() passed" << std::endl;
+}
+
 void testDestructorInt() {
   intSet* dynamicSet = new intSet();
   dynamicSet->add(10);
@@ -882,79 +1153,2157 @@ void testSaveFunction() {
   std::cout << "testSaveFunction() passed" << std::endl;
 }
 
-int main() {
-  // copy constructor
-  testCopyConstructorInt();
+void testHashers() {
+  assert(ArithmeticHash<double>()(0.0) == ArithmeticHash<double>()(-0.0));
+  assert(DefaultHash<int>()(42) == ArithmeticHash<int>()(42));
+  assert(DefaultHash<std::string>()("Aidds") == StringHash()("Aidds"));
+  assert(StringHash()("Aidds") != StringHash()("Deleits"));
+  assert(HashPerson()(Person("Ruben", 30)) == HashPerson()(Person("Ruben", 30)));
+  assert(HashPerson()(Person("Ruben", 30)) != HashPerson()(Person("Ruben", 31)));
 
-  // assignment operator
-  testAssignmentOperatorInt();
+  std::cout << "testHashers() passed" << std::endl;
+}
 
-  // destructor
-  testDestructorInt();
+void testHashSetInt() {
+  intHashSet set;
 
-  // empty
-  testEmptyInt();
+  for (int i = 0; i < 1000; ++i) {
+    assert(set.add(i));
+  }
+  assert(!set.add(500));
+  assert(set.getNumElements() == 1000);
 
-  // swap
-  testSwapInt();
+  for (int i = 0; i < 1000; i += 2) {
+    assert(set.remove(i));
+  }
+  assert(!set.remove(0));
+  assert(set.getNumElements() == 500);
 
-  // tests add
-  testAddInt();
-  testAddString();
-  testAddPerson();
+  for (int i = 0; i < 1000; ++i) {
+    assert(set.contains(i) == (i % 2 == 1));
+  }
 
-  // tests remove
-  testRemoveInt();
-  testRemoveString();
-  testRemovePerson();
+  int count = 0;
+  for (intHashSet::const_iterator it = set.begin(); it != set.end(); ++it) {
+    assert(*it % 2 == 1);
+    ++count;
+  }
+  assert(count == 500);
 
-  // tests operator[]
-  testBracketOperatorInt();
-  testBracketOperatorString();
-  testBracketOperatorPerson();
+  intHashSet copiedSet(set);
+  assert(copiedSet == set);
+  copiedSet.empty();
+  assert(copiedSet.getNumElements() == 0 && !copiedSet.contains(1));
 
-  // tests contains
-  testContainsInt();
-  testContainsString();
-  testContainsPerson();
+  std::cout << "testHashSetInt() passed" << std::endl;
+}
 
-  // tests const iterator
-  testConstIteratorInt();
-  testConstIteratorString();
-  testConstIteratorPerson();
+void testHashSetString() {
+  stringHashSet set;
 
-  // tests constructor with iterators
-  testIteratorConstructorInt();
-  testIteratorConstructorString();
-  testIteratorConstructorPerson();
+  assert(set.add("Deleits"));
+  assert(set.add("Aidds"));
+  assert(set.add("Cuncatenaits"));
+  assert(!set.add("Aidds"));
 
-  // tests operator<<
-  testPrintOperatorInt();
-  testPrintOperatorString();
-  testPrintOperatorPerson();
+  assert(set[0] == "Deleits" && set[1] == "Aidds" && set[2] == "Cuncatenaits");
 
-  // tests operator==
-  testEqualityOperatorInt();
-  testEqualityOperatorString();
-  testEqualityOperatorPerson();
+  assert(set.remove("Deleits"));
+  assert(!set.contains("Deleits") && set.contains("Aidds") && set.contains("Cuncatenaits"));
+  assert(set.getNumElements() == 2);
 
-  // tests filter_out
-  testFilterOutInt();
-  testFilterOutString();
-  testFilterOutPerson();
+  try {
+    std::string value = set[2];
+    assert(false);
+  } catch (const std::out_of_range& e) {
+    // Expected exception
+  }
 
-  // tests operator+
-  testConcatenationOperatorInt();
-  testConcatenationOperatorString();
-  testConcatenationOperatorPerson();
+  std::cout << "testHashSetString() passed" << std::endl;
+}
 
-  // tests operator-
-  testDifferenceOperatorInt();
-  testDifferenceOperatorString();
-  testDifferenceOperatorPerson();
+void testHashSetPerson() {
+  std::vector<Person> testData;
+  testData.push_back(Person("Ruben", 99));
+  testData.push_back(Person("Youness", 13));
+  testData.push_back(Person("Ruben", 99));
 
-  // tests save
-  testSaveFunction();
+  personHashSet set(testData.begin(), testData.end());
+
+  assert(set.getNumElements() == 2);
+  assert(set.contains(Person("Ruben", 99)));
+  assert(set.contains(Person("Youness", 13)));
+  assert(!set.contains(Person("Youness", 14)));
+
+  std::cout << "testHashSetPerson() passed" << std::endl;
+}
+
+void testHashSetOperators() {
+  intHashSet set1;
+  set1.add(1);
+  set1.add(2);
+  set1.add(3);
+
+  intHashSet set2;
+  set2.add(3);
+  set2.add(4);
+  set2.add(5);
+
+  std::stringstream buffer;
+  buffer << set1 + set2 << " " << set1 - set2;
+  assert(buffer.str() == "5 (1) (2) (3) (4) (5) 1 (3)");
+
+  auto isOdd = [](int x) { return x % 2 == 1; };
+  intHashSet filteredSet = filter_out(set1 + set2, isOdd);
+  assert(filteredSet.getNumElements() == 3);
+  assert(filteredSet.contains(1) && filteredSet.contains(3) && filteredSet.contains(5));
+
+  intHashSet set3;
+  set3.add(3);
+  set3.add(2);
+  set3.add(1);
+  assert(set1 == set3);
+  assert(!(set1 == set2));
+
+  stringHashSet strings;
+  strings.add("Hello");
+  strings.add("World");
+
+  std::string filename = "test_save_hash.txt";
+  save(strings, filename);
+
+  std::ifstream inFile(filename);
+  assert(inFile.is_open());
+  std::stringstream fileContents;
+  fileContents << inFile.rdbuf();
+  inFile.close();
+  assert(fileContents.str() == "2 (Hello) (World)");
+  std::remove(filename.c_str());
+
+  std::cout << "testHashSetOperators() passed" << std::endl;
+}
+
+void testSwissSetInt() {
+  intSwissSet set;
+
+  // Repeated add/remove cycles leave tombstones behind, forcing rebuilds
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 300; ++i) {
+      assert(set.add(round * 1000 + i));
+    }
+    for (int i = 0; i < 300; i += 3) {
+      assert(set.remove(round * 1000 + i));
+    }
+  }
+  assert(set.getNumElements() == 2000);
+
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 300; ++i) {
+      assert(set.contains(round * 1000 + i) == (i % 3 != 0));
+    }
+  }
+  assert(!set.contains(-1) && !set.contains(300));
+
+  intSwissSet copiedSet(set);
+  assert(copiedSet == set);
+  assert((copiedSet - set).getNumElements() == 2000);
+
+  std::cout << "testSwissSetInt() passed" << std::endl;
+}
+
+void testSwissSetString() {
+  stringSwissSet set;
+  set.add("Deleits");
+  set.add("Aidds");
+  set.add("Cuncatenaits");
+
+  assert(!set.add("Aidds"));
+  assert(set.remove("Deleits"));
+  assert(!set.contains("Deleits") && set.contains("Aidds") && set.contains("Cuncatenaits"));
+
+  std::stringstream buffer;
+  buffer << set;
+  assert(buffer.str() == "2 (Cuncatenaits) (Aidds)");
+
+  std::cout << "testSwissSetString() passed" << std::endl;
+}
+
+void testIndexStats() {
+  intHashSet hashSet;
+  intSwissSet swissSet;
+  for (int i = 0; i < 1000; ++i) {
+    hashSet.add(i);
+    swissSet.add(i);
+  }
+
+  IndexStats chained = hashSet.index_stats();
+  assert(chained.entries == 1000 && chained.slots == 1024);
+  assert(chained.load_factor > 0.9 && chained.load_factor <= 1.0);
+  assert(chained.mean_probe_length >= 1.0 && chained.max_probe_length >= 1);
+
+  IndexStats swiss = swissSet.index_stats();
+  assert(swiss.entries == 1000 && swiss.tombstones == 0);
+  assert(swiss.slots % 16 == 0 && swiss.load_factor <= 7.0 / 8.0);
+  assert(swiss.mean_probe_length >= 1.0 && swiss.mean_probe_length < 2.0);
+
+  std::cout << "testIndexStats() passed" << std::endl;
+}
+
+void testSortedSetInt() {
+  intSortedSet set;
+
+  assert(set.add(30));
+  assert(set.add(10));
+  assert(set.add(20));
+  assert(set.add(40));
+  assert(!set.add(20));
+  assert(set.getNumElements() == 4);
+
+  assert(set[0] == 10 && set[1] == 20 && set[2] == 30 && set[3] == 40);
+
+  assert(set.remove(20));
+  assert(!set.remove(20));
+  assert(!set.contains(20) && set.contains(10) && set.contains(30) && set.contains(40));
+
+  int expectedOrder[] = {10, 30, 40};
+  int index = 0;
+  for (intSortedSet::const_iterator it = set.begin(); it != set.end(); ++it) {
+    assert(*it == expectedOrder[index++]);
+  }
+  assert(index == 3);
+
+  std::vector<int> testData;
+  for (int i = 100; i > 0; --i) {
+    testData.push_back(i % 50);
+  }
+  intSortedSet rangeSet(testData.begin(), testData.end());
+  assert(rangeSet.getNumElements() == 50);
+  for (int i = 0; i < 50; ++i) {
+    assert(rangeSet[i] == i);
+  }
+
+  std::cout << "testSortedSetInt() passed" << std::endl;
+}
+
+void testSortedSetPerson() {
+  personSortedSet set;
+  set.add(Person("Youness", 25));
+  set.add(Person("Quack", 35));
+  set.add(Person("Ruben", 30));
+  set.add(Person("Quack", 21));
+
+  assert(!set.add(Person("Ruben", 30)));
+  assert(set.contains(Person("Quack", 21)) && !set.contains(Person("Quack", 22)));
+
+  std::stringstream buffer;
+  buffer << set;
+  assert(buffer.str() == "4 (Name: Quack, Age: 21) (Name: Quack, Age: 35) (Name: Ruben, Age: 30) (Name: Youness, Age: 25)");
+
+  std::cout << "testSortedSetPerson() passed" << std::endl;
+}
+
+void testSortedSetOperators() {
+  intSortedSet set1;
+  set1.add(5);
+  set1.add(1);
+  set1.add(3);
+
+  intSortedSet set2;
+  set2.add(4);
+  set2.add(3);
+  set2.add(2);
+
+  std::stringstream buffer;
+  buffer << set1 + set2 << " " << set1 - set2 << " " << set2 - set1;
+  assert(buffer.str() == "5 (1) (2) (3) (4) (5) 1 (3) 1 (3)");
+
+  intSortedSet set3;
+  set3.add(3);
+  set3.add(5);
+  set3.add(1);
+  assert(set1 == set3);
+  assert(!(set1 == set2));
+
+  auto isOdd = [](int x) { return x % 2 == 1; };
+  assert(filter_out(set1 + set2, isOdd) == set1);
+
+  // The saved file only depends on the content, not on the insertion order
+  stringSortedSet strings1;
+  strings1.add("World");
+  strings1.add("Hello");
+  strings1.add("Test");
+  strings1.remove("Hello");
+  stringSortedSet strings2;
+  strings2.add("Test");
+  strings2.add("World");
+
+  std::string filename1 = "test_save_sorted1.txt";
+  std::string filename2 = "test_save_sorted2.txt";
+  save(strings1, filename1);
+  save(strings2, filename2);
+
+  std::ifstream inFile1(filename1), inFile2(filename2);
+  assert(inFile1.is_open() && inFile2.is_open());
+  std::stringstream contents1, contents2;
+  contents1 << inFile1.rdbuf();
+  contents2 << inFile2.rdbuf();
+  inFile1.close();
+  inFile2.close();
+  assert(contents1.str() == "2 (Test) (World)");
+  assert(contents1.str() == contents2.str());
+  std::remove(filename1.c_str());
+  std::remove(filename2.c_str());
+
+  std::cout << "testSortedSetOperators() passed" << std::endl;
+}
+
+void testMoveConstructorString() {
+  stringSet set;
+  set.add("Deleits");
+  set.add("Aidds");
+  const std::string* first = &set[0];
+
+  stringSet movedSet(std::move(set));
+  assert(movedSet.getNumElements() == 2);
+  assert(&movedSet[0] == first); // The array has been taken over, not copied
+  assert(set.getNumElements() == 0 && !set.contains("Deleits"));
+
+  stringSet assignedSet;
+  assignedSet.add("Cuncatenaits");
+  assignedSet = std::move(movedSet);
+  assert(assignedSet.getNumElements() == 2 && &assignedSet[0] == first);
+  assert(!assignedSet.contains("Cuncatenaits"));
+  assert(movedSet.getNumElements() == 0);
+
+  movedSet.add("Divaids"); // A moved-from Set is still usable
+  assert(movedSet.contains("Divaids"));
+
+  std::cout << "testMoveConstructorString() passed" << std::endl;
+}
+
+void testAddMoveString() {
+  stringSet set;
+  std::string value(100, 'x');
+
+  assert(set.add(std::move(value)));
+  assert(set.contains(std::string(100, 'x')));
+
+  std::string duplicate(100, 'x');
+  assert(!set.add(std::move(duplicate)));
+  assert(duplicate.size() == 100); // Not consumed, since it was not added
+
+  assert(set.emplace(3, 'y'));
+  assert(!set.emplace(3, 'y'));
+  assert(set.contains("yyy") && set.getNumElements() == 2);
+
+  assert(set.try_emplace(std::string("zz"), 2, 'z'));
+  assert(!set.try_emplace(std::string("zz"), 2, 'z'));
+  assert(set.contains("zz") && set.getNumElements() == 3);
+
+  // Arguments referring to elements of a full or shared array
+  intSet full;
+  for (int i = 0; i < 16; ++i) {
+    full.add(i);
+  }
+  assert(full.capacity() == full.getNumElements());
+  assert(!full.emplace(full[0]) && full.try_emplace(100, full[0] + 100));
+  stringSet strings;
+  for (int i = 0; i < 16; ++i) {
+    strings.add("s" + std::to_string(i));
+  }
+  assert(strings.capacity() == strings.getNumElements());
+  assert(strings.emplace(strings[10], 1) && strings.contains("10"));
+  stringSet shared(strings);
+  assert(shared.emplace(shared[11], 1) && shared.contains("11") && !strings.contains("11"));
+  assert(shared.try_emplace(std::string("s1x"), shared[1] + "x") && shared.contains("s1x"));
+
+  std::cout << "testAddMoveString() passed" << std::endl;
+}
+
+void testMoveOnlyElements() {
+  uniquePtrSet set;
+
+  for (int i = 0; i < 10; ++i) {
+    assert(set.add(std::unique_ptr<int>(new int(i))));
+  }
+  assert(!set.add(std::unique_ptr<int>(new int(3))));
+  assert(set.emplace(new int(10)));
+
+  // try_emplace does not build the element when the key is already present
+  assert(set.try_emplace(11, new int(11)));
+  assert(!set.try_emplace(11, static_cast<int*>(nullptr)));
+  assert(set.getNumElements() == 12);
+
+  assert(set.remove(std::unique_ptr<int>(new int(0))));
+  assert(!set.contains(std::unique_ptr<int>(new int(0))));
+  assert(set.contains(std::unique_ptr<int>(new int(9))));
+
+  uniquePtrSet movedSet(std::move(set));
+  assert(movedSet.getNumElements() == 11 && set.getNumElements() == 0);
+
+  HashSet<std::string, std::equal_to<std::string>> hashSet;
+  assert(hashSet.emplace(5, 'h') && !hashSet.add(std::string(5, 'h')));
+  HashSet<std::string, std::equal_to<std::string>> movedHashSet(std::move(hashSet));
+  assert(movedHashSet.contains("hhhhh") && !hashSet.contains("hhhhh"));
+
+  SortedSet<std::string> sortedSet;
+  assert(sortedSet.emplace(3, 'b') && sortedSet.emplace(3, 'a') && !sortedSet.add(std::string("aaa")));
+  SortedSet<std::string> movedSortedSet;
+  movedSortedSet = std::move(sortedSet);
+  assert(movedSortedSet[0] == "aaa" && movedSortedSet[1] == "bbb");
+
+  std::cout << "testMoveOnlyElements() passed" << std::endl;
+}
+
+void testRawStorage() {
+  {
+    Set<Tracked, std::equal_to<Tracked>> set;
+    for (int i = 0; i < 5; ++i) {
+      set.add(Tracked(i));
+    }
+    // The capacity is 8, but only the 5 live elements are constructed
+    assert(Tracked::live == 5);
+
+    set.remove(Tracked(0));
+    set.remove(Tracked(1));
+    set.remove(Tracked(2));
+    assert(Tracked::live == 2);
+    assert(set.contains(Tracked(3)) && set.contains(Tracked(4)));
+
+    // The copy shares the array until one of the Sets is changed
+    Set<Tracked, std::equal_to<Tracked>> copiedSet(set);
+    assert(Tracked::live == 2 && copiedSet.data() == set.data());
+    copiedSet.add(Tracked(5));
+    assert(Tracked::live == 5 && copiedSet.data() != set.data());
+
+  }
+  assert(Tracked::live == 0);
+
+  // Person is no longer default constructible
+  personSet set;
+  for (int i = 0; i < 100; ++i) {
+    set.add(Person("Ruben", i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    set.remove(Person("Ruben", i));
+  }
+  assert(set.getNumElements() == 50 && set.contains(Person("Ruben", 99)));
+
+  personHashSet hashSet;
+  personSortedSet sortedSet;
+  for (int i = 0; i < 100; ++i) {
+    hashSet.add(Person("Quack", i));
+    sortedSet.add(Person("Quack", 99 - i));
+  }
+  for (int i = 0; i < 90; ++i) {
+    hashSet.remove(Person("Quack", i));
+    sortedSet.remove(Person("Quack", i));
+  }
+  assert(hashSet.getNumElements() == 10 && hashSet.contains(Person("Quack", 95)));
+  assert(sortedSet.getNumElements() == 10 && sortedSet[0].age == 90);
+
+  std::cout << "testRawStorage() passed" << std::endl;
+}
+
+void testReserveInt() {
+  intSet set;
+  assert(set.capacity() == 0);
+
+  set.reserve(1000);
+  assert(set.capacity() == 1000);
+  set.add(0);
+  const int* first = &set[0];
+  for (int i = 1; i < 1000; ++i) {
+    set.add(i);
+  }
+  assert(set.capacity() == 1000 && &set[0] == first); // No reallocation
+
+  set.reserve(10); // Never shrinks
+  assert(set.capacity() == 1000);
+
+  set.add(1000);
+  assert(set.capacity() == 2000);
+  set.shrink_to_fit();
+  assert(set.capacity() == 1001 && set.getNumElements() == 1001);
+  assert(set.contains(0) && set.contains(1000));
+
+  intSet emptySet;
+  emptySet.reserve(10);
+  emptySet.shrink_to_fit();
+  assert(emptySet.capacity() == 0);
+
+  std::cout << "testReserveInt() passed" << std::endl;
+}
+
+void testGrowthPolicies() {
+  Set<int, std::equal_to<int>, NoShrinkPolicy> noShrinkSet;
+  for (int i = 0; i < 64; ++i) {
+    noShrinkSet.add(i);
+  }
+  for (int i = 0; i < 64; ++i) {
+    noShrinkSet.remove(i);
+  }
+  assert(noShrinkSet.getNumElements() == 0 && noShrinkSet.capacity() == 64);
+
+  Set<int, std::equal_to<int>, CompactGrowthPolicy> compactSet;
+  size_t expectedCapacities[] = {1, 2, 3, 4, 6, 6, 9, 9, 9, 13};
+  for (int i = 0; i < 10; ++i) {
+    compactSet.add(i);
+    assert(compactSet.capacity() == expectedCapacities[i]);
+  }
+  for (int i = 0; i < 7; ++i) {
+    compactSet.remove(i);
+  }
+  assert(compactSet.capacity() == 8); // 3 elements <= 13 / 4, shrunk by 1.5x
+  assert(compactSet.contains(7) && compactSet.contains(8) && compactSet.contains(9));
+
+  typedef GrowthPolicy<2, 1, 4, 16> MinSixteenPolicy;
+  assert(MinSixteenPolicy::grow(0) == 16 && MinSixteenPolicy::grow(16) == 32);
+  assert(!MinSixteenPolicy::should_shrink(0, 16));
+  assert(MinSixteenPolicy::should_shrink(8, 32) && MinSixteenPolicy::shrink(32) == 16);
+
+  intSet defaultSet;
+  for (int i = 0; i < 8; ++i) {
+    defaultSet.add(i);
+  }
+  assert(defaultSet.capacity() == 8);
+  for (int i = 0; i < 6; ++i) {
+    defaultSet.remove(i);
+  }
+  assert(defaultSet.capacity() == 4);
+
+  std::cout << "testGrowthPolicies() passed" << std::endl;
+}
+
+void testStatefulAllocator() {
+  typedef Set<std::string, std::equal_to<std::string>, DefaultGrowthPolicy,
+              CountingAllocator<std::string> > countingSet;
+  int heldA = 0, heldB = 0;
+  {
+    countingSet a((CountingAllocator<std::string>(&heldA)));
+    a.add("one");
+    a.add("two");
+    a.add("three");
+    assert(heldA == 4 && a.get_allocator().held == &heldA);
+
+    // Copies select the same allocator, results of the algebra use the left one
+    countingSet copy(a);
+    assert(copy.get_allocator() == a.get_allocator() && heldA == 4);
+    countingSet b((CountingAllocator<std::string>(&heldB)));
+    b.add("three");
+    b.add("four");
+    countingSet u = a + b;
+    assert(u.getNumElements() == 4 && u.get_allocator().held == &heldA);
+    assert(filter_out(b, [](const std::string&) { return true; }).get_allocator().held == &heldB);
+
+    // Allocators do not propagate: the elements are moved across arrays
+    b = std::move(a);
+    assert(b.get_allocator().held == &heldB && b.getNumElements() == 3);
+    assert(a.getNumElements() == 0 && b.contains("one") && b.contains("three"));
+    b = copy;
+    assert(b.get_allocator().held == &heldB && b == copy);
+
+    // Same allocator: the array is taken over
+    countingSet moved(std::move(copy), copy.get_allocator());
+    assert(copy.getNumElements() == 0 && moved.getNumElements() == 3);
+  }
+  assert(heldA == 0 && heldB == 0);
+
+  std::cout << "testStatefulAllocator() passed" << std::endl;
+}
+
+#if __cplusplus >= 201703L
+void testPmrSet() {
+  typedef PmrSet<std::pmr::string, std::equal_to<std::pmr::string> > pmrStringSet;
+  CountingResource upstream(std::pmr::new_delete_resource());
+  {
+    std::pmr::monotonic_buffer_resource arena(&upstream);
+    // Nothing may escape the arena
+    std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    pmrStringSet a(&arena), b(&arena);
+    for (int i = 0; i < 100; ++i) {
+      std::pmr::string value(100, static_cast<char>('a' + i % 26), &arena);
+      value += std::to_string(i);
+      a.add(std::move(value));
+      if (i % 2 == 0) b.emplace(a[i]);
+    }
+    pmrStringSet u = a + b;
+    pmrStringSet n = a - b;
+    pmrStringSet f = filter_out(u, [](const std::pmr::string& s) { return s[0] == 'a'; });
+    assert(u.getNumElements() == 100 && n.getNumElements() == 50 && f.getNumElements() == 4);
+    assert(u.get_allocator().resource() == &arena && n[0].get_allocator().resource() == &arena);
+
+    std::pmr::set_default_resource(previous);
+  }
+  assert(upstream.allocations > 0);
+
+  std::cout << "testPmrSet() passed" << std::endl;
+}
+#endif
+
+void testAddRange() {
+  intSet set;
+  set.add(1);
+  set.add(2);
+  std::vector<int> batch = {5, 2, 3, 5, 1, 4, 3};
+  assert(set.add_range(batch.begin(), batch.end()) == 3);
+  assert(set.getNumElements() == 5 && set.capacity() == 9);
+  int expected[] = {1, 2, 5, 3, 4};
+  for (int i = 0; i < 5; ++i) {
+    assert(set[i] == expected[i]);
+  }
+  assert(set.add_range(batch.begin(), batch.end()) == 0);
+
+  // Input iterators: the array grows while the range is consumed
+  std::istringstream input("b a c a b d");
+  stringSet strings;
+  strings.add("d");
+  assert(strings.add_range(std::istream_iterator<std::string>(input),
+                           std::istream_iterator<std::string>()) == 3);
+  assert(strings.getNumElements() == 4 && strings[1] == "b" && strings[3] == "c");
+
+  // Hashed through a HashTraits specialization
+  std::vector<Person> people = {Person("Alice", 30), Person("Bob", 25), Person("Alice", 30)};
+  personSet persons;
+  assert(persons.add_range(people.begin(), people.end()) == 2);
+
+  // No hasher for the pointees: elements are moved in, duplicates left behind
+  std::vector<std::unique_ptr<int> > pointers;
+  pointers.emplace_back(new int(1));
+  pointers.emplace_back(new int(2));
+  pointers.emplace_back(new int(1));
+  uniquePtrSet unique;
+  assert(unique.add_range(std::make_move_iterator(pointers.begin()),
+                          std::make_move_iterator(pointers.end())) == 2);
+  assert(!pointers[0] && !pointers[1] && pointers[2]);
+
+  // Large batch with duplicates, quadratic with one add() per element
+  std::vector<int> large;
+  for (int i = 0; i < 400000; ++i) {
+    large.push_back(i % 200000);
+  }
+  intSet largeSet(large.begin(), large.end());
+  assert(largeSet.getNumElements() == 200000 && largeSet[199999] == 199999);
+
+  std::cout << "testAddRange() passed" << std::endl;
+}
+
+void testUniqueFastPath() {
+  std::vector<std::string> words = {"alpha", "beta", "gamma", "delta"};
+  stringSet set = stringSet::from_unique_range(words.begin(), words.end());
+  assert(set.getNumElements() == 4 && set.capacity() == 4);
+  assert(set[0] == "alpha" && set[3] == "delta");
+
+  set.add_unchecked(std::string("epsilon"));
+  assert(set.getNumElements() == 5 && set.contains("epsilon"));
+
+  // filter_out trims the capacity reserved for the whole input
+  intSet numbers;
+  for (int i = 0; i < 1000; ++i) {
+    numbers.add(i);
+  }
+  intSet few = filter_out(numbers, [](int x) { return x % 100 == 0; });
+  assert(few.getNumElements() == 10 && few.capacity() == 10);
+  intSet most = filter_out(numbers, [](int x) { return x % 10 != 0; });
+  assert(most.getNumElements() == 900 && most.capacity() == 1000);
+
+  std::cout << "testUniqueFastPath() passed" << std::endl;
+}
+
+void testBulkRemoval() {
+  intSet set;
+  for (int i = 0; i < 100; ++i) {
+    set.add(i);
+  }
+  assert(set.remove_if([](int x) { return x % 3 == 0; }) == 34);
+  assert(set.getNumElements() == 66 && set.capacity() == 128);
+  for (int i = 0; i < 66; ++i) {
+    assert(set[i] % 3 != 0 && (i == 0 || set[i - 1] < set[i])); // order is kept
+  }
+
+  // One shrink, straight to the capacity reached by repeated halving
+  assert(set.retain([](int x) { return x < 10; }) == 60);
+  assert(set.getNumElements() == 6 && set.capacity() == 16);
+  assert(set.remove_if([](int) { return false; }) == 0 && set.capacity() == 16);
+
+  std::vector<int> purge = {1, 2, 2, 42, 8};
+  assert(set.remove_all(purge.begin(), purge.end()) == 3);
+  assert(set.getNumElements() == 3 && set[0] == 4 && set[1] == 5 && set[2] == 7);
+
+  // Linear lookups when no hasher is known
+  uniquePtrSet pointers;
+  for (int i = 0; i < 5; ++i) {
+    pointers.emplace(new int(i));
+  }
+  int victims[] = {0, 3, 7};
+  assert(pointers.remove_all(victims, victims + 3) == 2);
+  assert(pointers.getNumElements() == 3 && *pointers[0] == 1 && *pointers[2] == 4);
+
+  // A throwing predicate removes what it selected and keeps the rest
+  stringSet strings;
+  strings.add("a");
+  strings.add("b");
+  strings.add("c");
+  strings.add("d");
+  try {
+    strings.remove_if([](const std::string& s) {
+      if (s == "c") throw std::runtime_error("stop");
+      return s == "a";
+    });
+    assert(false);
+  } catch (const std::runtime_error&) {
+    assert(strings.getNumElements() == 3);
+    assert(strings[0] == "b" && strings[1] == "c" && strings[2] == "d");
+  }
+
+  std::cout << "testBulkRemoval() passed" << std::endl;
+}
+
+void testHashJoin() {
+  // Large enough for the hash join, in both build directions
+  intSet a, b, small;
+  for (int i = 0; i < 3000; ++i) {
+    a.add(i * 2);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    b.add(3000 - i * 3);
+  }
+  for (int i = 0; i < 40; ++i) {
+    small.add(i * 5);
+  }
+
+  intSet u = a + b;
+  assert(u.getNumElements() == 3000 + 500);
+  for (int i = 0; i < 3000; ++i) {
+    assert(u[i] == i * 2);
+  }
+  assert(u[3000] == 2997 && u[3001] == 2991 && u[3499] == 3);
+
+  intSet n = a - b;
+  assert(n.getNumElements() == 500 && n[0] == 6 && n[1] == 12 && n[499] == 3000);
+  intSet m = b - a;
+  assert(m.getNumElements() == 500 && m[0] == 3000 && m[499] == 6);
+  assert(n == m);
+
+  intSet s = small - a;
+  assert(s.getNumElements() == 20 && s[1] == 10);
+  intSet t = a - small;
+  assert(t.getNumElements() == 20 && t[19] == 190);
+  assert(s == t && (a + small).getNumElements() == 3020);
+
+  // Strings and a user hasher through HashTraits
+  stringSet words, others;
+  personSet people, more;
+  for (int i = 0; i < 500; ++i) {
+    words.add("w" + std::to_string(i));
+    others.add("w" + std::to_string(i + 250));
+    people.add(Person("p", i));
+    more.add(Person("p", 499 - i));
+  }
+  assert((words - others).getNumElements() == 250 && (words - others)[0] == "w250");
+  assert((words + others).getNumElements() == 750 && (words + others)[500] == "w500");
+  assert((people - more) == people && (people + more).getNumElements() == 500);
+
+  std::cout << "testHashJoin() passed" << std::endl;
+}
+
+void testDifferences() {
+  intSet a, b;
+  for (int i = 0; i < 200; ++i) {
+    a.add(i);
+    b.add(300 - 2 * i); // evens from 300 down to -98
+  }
+  intSet gone = difference(a, b);
+  assert(gone.getNumElements() == 100 && gone[0] == 1 && gone[1] == 3 && gone[99] == 199);
+  intSet added = difference(b, a);
+  assert(added.getNumElements() == 100 && added[0] == 300 && added[50] == 200 && added[99] == -98);
+  intSet delta = symmetric_difference(a, b);
+  assert(delta.getNumElements() == 200 && delta[99] == 199 && delta[100] == 300);
+  assert(intersection(a, b) == a - b && intersection(a, b).getNumElements() == 100);
+  assert(difference(a, intSet()) == a && symmetric_difference(a, a).getNumElements() == 0);
+
+  // Without a hasher: pairs compared, both sides flagged in one pass
+  {
+    Set<Tracked, std::equal_to<Tracked>> p, q;
+    for (int i = 0; i < 4; ++i) {
+      p.emplace(i);
+      q.emplace(i + 2);
+    }
+    Set<Tracked, std::equal_to<Tracked>> pq = symmetric_difference(p, q);
+    assert(pq.getNumElements() == 4 && pq[1].value == 1 && pq[2].value == 4);
+    assert(difference(q, p).getNumElements() == 2 && intersection(p, q)[0].value == 2);
+  }
+
+  stringHashSet ha, hb;
+  ha.add("x"); ha.add("y"); ha.add("z");
+  hb.add("y"); hb.add("w");
+  stringHashSet hd = difference(ha, hb), hs = symmetric_difference(ha, hb);
+  assert(hd.getNumElements() == 2 && hd[0] == "x" && hd[1] == "z");
+  assert(hs.getNumElements() == 3 && hs[2] == "w" && intersection(ha, hb).getNumElements() == 1);
+
+  intSortedSet sa, sb;
+  for (int i = 0; i < 10; ++i) {
+    sa.add(i);
+    sb.add(i * 3);
+  }
+  intSortedSet sd = difference(sa, sb), ss = symmetric_difference(sa, sb);
+  assert(sd.getNumElements() == 6 && sd[0] == 1 && sd[5] == 8);
+  assert(ss.getNumElements() == 12 && ss[11] == 27 && ss[10] == 24);
+  assert(intersection(sa, sb) == sa - sb);
+
+  std::cout << "testDifferences() passed" << std::endl;
+}
+
+void testCompoundOperators() {
+  intSet acc;
+  for (int k = 0; k < 50; ++k) {
+    intSet next;
+    for (int i = 0; i < 100; ++i) {
+      next.add(k * 10 + i);
+    }
+    acc += next;
+  }
+  assert(acc.getNumElements() == 590 && acc.capacity() == 800);
+  for (int i = 0; i < 590; ++i) {
+    assert(acc[i] == i);
+  }
+  acc += acc;
+  assert(acc.getNumElements() == 590);
+
+  intSet evens;
+  for (int i = 0; i < 1000; i += 2) {
+    evens.add(i);
+  }
+  intSet copy = acc;
+  copy &= evens;
+  assert(copy.getNumElements() == 295 && copy[0] == 0 && copy[294] == 588);
+  assert(copy == acc - evens);
+  acc -= evens;
+  assert(acc == copy);
+
+  intSet odds;
+  for (int i = 1; i < 20; i += 2) {
+    odds.add(i);
+  }
+  intSet mixed;
+  for (int i = 0; i < 10; ++i) {
+    mixed.add(i);
+  }
+  intSet x = mixed;
+  x ^= odds;
+  assert(x == symmetric_difference(mixed, odds) && x.getNumElements() == 10);
+  assert(x[0] == 0 && x[4] == 8 && x[5] == 11 && x[9] == 19);
+  x.subtract(odds);
+  assert(x.getNumElements() == 5 && x[4] == 8);
+  x ^= x;
+  assert(x.getNumElements() == 0);
+  mixed.subtract(mixed);
+  assert(mixed.getNumElements() == 0);
+
+  std::cout << "testCompoundOperators() passed" << std::endl;
+}
+
+void testParallelAlgorithms() {
+  ParallelPolicy policy(4, 16);
+  assert(policy.partitions(10) == 1 && policy.partitions(40) == 2 && policy.partitions(1000) == 4);
+  assert(ParallelPolicy().partitions(0) == 1);
+
+  intSet a, b;
+  for (int i = 0; i < 1000; ++i) {
+    a.add(i);
+    b.add(1500 - 3 * i);
+  }
+  intSet evens = filter_out(policy, a, [](int x) { return x % 2 == 0; });
+  assert(evens.getNumElements() == 500 && evens[0] == 0 && evens[499] == 998);
+  assert(evens == filter_out(a, [](int x) { return x % 2 == 0; }));
+
+  intSet u = unite(policy, a, b), n = intersection(policy, a, b), d = difference(policy, a, b);
+  intSet su = a + b, sn = a - b, sd = difference(a, b);
+  assert(u.getNumElements() == su.getNumElements() && n.getNumElements() == sn.getNumElements());
+  for (size_t i = 0; i < su.getNumElements(); ++i) {
+    assert(u[i] == su[i]); // same order as the sequential algorithms
+  }
+  for (size_t i = 0; i < sn.getNumElements(); ++i) {
+    assert(n[i] == sn[i]);
+  }
+  assert(d == sd && d.getNumElements() + n.getNumElements() == 1000);
+  assert(equals(policy, a, a) && !equals(policy, a, b) && equals(policy, u, su));
+
+  // Without a hasher
+  Set<Tracked, std::equal_to<Tracked>> ta, tb;
+  for (int i = 0; i < 100; ++i) {
+    ta.emplace(i);
+    tb.emplace(i * 2);
+  }
+  assert(intersection(policy, ta, tb).getNumElements() == 50);
+  assert(difference(policy, tb, ta).getNumElements() == 50);
+
+  // Exceptions of the workers reach the caller
+  try {
+    filter_out(policy, a, [](int x) {
+      if (x == 900) throw std::runtime_error("predicate failed");
+      return true;
+    });
+    assert(false);
+  } catch (const std::runtime_error& e) {
+    assert(std::string(e.what()) == "predicate failed");
+  }
+
+  std::cout << "testParallelAlgorithms() passed" << std::endl;
+}
+
+template <typename T>
+void checkSimdFind() {
+  std::vector<T> data;
+  for (int n = 0; n < 80; ++n) {
+    for (int i = 0; i < n; ++i) {
+      T value = static_cast<T>(i + 1);
+      assert(detail::simd_find(data.data(), data.size(), value) == static_cast<size_t>(i));
+#ifdef SET_SIMD_X86
+#ifdef __SSE2__
+      assert(detail::sse2_find(data.data(), data.size(), value) == static_cast<size_t>(i));
+#endif
+      if (detail::cpu_has_avx2()) {
+        assert(detail::avx2_find(data.data(), data.size(), value) == static_cast<size_t>(i));
+      }
+#endif
+    }
+    assert(detail::simd_find(data.data(), data.size(), static_cast<T>(0)) == data.size());
+    data.push_back(static_cast<T>(n + 1));
+  }
+
+  Set<T, std::equal_to<T>> set;
+  for (int i = 0; i < 100; ++i) {
+    set.add(static_cast<T>(i));
+  }
+  assert(set.getNumElements() == 100 && set.contains(static_cast<T>(99)) && !set.contains(static_cast<T>(100)));
+  assert(set.remove(static_cast<T>(42)) && !set.contains(static_cast<T>(42)));
+}
+
+void testSimdFind() {
+  assert((SimdEqual<int, std::equal_to<int>>::value && SimdEqual<double, std::equal_to<double>>::value));
+  assert((!SimdEqual<std::string, std::equal_to<std::string>>::value && !SimdEqual<int, EqualPerson>::value));
+
+  checkSimdFind<signed char>();
+  checkSimdFind<unsigned short>();
+  checkSimdFind<int>();
+  checkSimdFind<unsigned>();
+  checkSimdFind<long long>();
+  checkSimdFind<float>();
+  checkSimdFind<double>();
+
+  // Floating point lanes follow ==, not the bits
+  Set<double, std::equal_to<double>> doubles;
+  for (int i = 0; i < 40; ++i) {
+    doubles.add(i + 0.5);
+  }
+  doubles.add(0.0);
+  doubles.add(std::numeric_limits<double>::quiet_NaN());
+  assert(doubles.contains(-0.0) && !doubles.add(-0.0));
+  assert(!doubles.contains(std::numeric_limits<double>::quiet_NaN()));
+
+  // 64 bit lanes match only if both halves do
+  Set<long long, std::equal_to<long long>> wide;
+  for (long long i = 0; i < 40; ++i) {
+    wide.add(i << 32);
+  }
+  assert(!wide.contains(1) && !wide.contains((5LL << 32) + 1) && wide.contains(5LL << 32));
+
+  std::cout << "testSimdFind() passed" << std::endl;
+}
+
+template <typename T, typename Predicate>
+void checkSimdFilter(const Set<T, std::equal_to<T>>& set, Predicate pred) {
+  std::vector<T> expected;
+  for (typename Set<T, std::equal_to<T>>::const_iterator it = set.begin(); it != set.end(); ++it) {
+    if (pred(*it)) expected.push_back(*it);
+  }
+
+  Set<T, std::equal_to<T>> filtered = filter_out(set, pred);
+  assert(filtered.getNumElements() == expected.size());
+  assert(std::equal(expected.begin(), expected.end(), filtered.data()));
+
+  std::vector<T> out(set.getNumElements());
+  assert(detail::scalar_compress(set.data(), set.getNumElements(), pred, out.data()) == expected.size());
+  assert(std::equal(expected.begin(), expected.end(), out.begin()));
+#ifdef SET_SIMD_X86
+  if (detail::cpu_has_avx2()) {
+    assert(detail::avx2_compress(set.data(), set.getNumElements(), pred, out.data()) == expected.size());
+    assert(std::equal(expected.begin(), expected.end(), out.begin()));
+
+    // In place
+    std::vector<T> in_place(set.begin(), set.end());
+    assert(detail::avx2_compress(in_place.data(), in_place.size(), pred, in_place.data()) == expected.size());
+    assert(std::equal(expected.begin(), expected.end(), in_place.begin()));
+  }
+#endif
+}
+
+template <typename T>
+void checkSimdComparisons(T lo, T hi) {
+  for (int n = 0; n < 70; n += 3) {
+    Set<T, std::equal_to<T>> set;
+    for (int i = 0; i < n; ++i) {
+      // Spread over [lo, hi], in a shuffled order
+      set.add(static_cast<T>(lo + (hi - lo) / 70 * ((i * 37) % 70)));
+    }
+    T mid = static_cast<T>(lo + (hi - lo) / 2);
+    checkSimdFilter(set, InRange<T>(static_cast<T>(lo + (hi - lo) / 4), mid));
+    checkSimdFilter(set, InRange<T>(mid, mid));
+    checkSimdFilter(set, InRange<T>(hi, lo));
+    checkSimdFilter(set, LessThan<T>(mid));
+    checkSimdFilter(set, GreaterThan<T>(mid));
+    checkSimdFilter(set, GreaterThan<T>(lo));
+  }
+}
+
+void testSimdFilter() {
+  assert((SimdPredicate<int, InRange<int>>::value && SimdPredicate<double, LessThan<double>>::value));
+  assert((SimdPredicate<int, Modulo<int>>::value && !SimdPredicate<unsigned, Modulo<unsigned>>::value));
+  assert((!SimdPredicate<short, InRange<short>>::value && !SimdPredicate<int, LessThan<long>>::value));
+
+  checkSimdComparisons<int>(-1000000, 1000000);
+  checkSimdComparisons<unsigned>(0, 4000000000u); // Beyond the sign bit
+  checkSimdComparisons<long long>(-(1LL << 40), 1LL << 40);
+  checkSimdComparisons<unsigned long long>(0, 18000000000000000000ull);
+  checkSimdComparisons<float>(-100.0f, 100.0f);
+  checkSimdComparisons<double>(-1e9, 1e9);
+
+  // Modulo follows %, including the sign of the remainders
+  Set<int, std::equal_to<int>> ints;
+  for (int i = -50; i < 50; ++i) {
+    ints.add(i * 7919);
+  }
+  ints.add(std::numeric_limits<int>::max());
+  ints.add(std::numeric_limits<int>::min());
+  int divisors[] = {1, 2, 3, -3, 7, 1000, 65536, 2147483647};
+  for (size_t d = 0; d < sizeof(divisors) / sizeof(divisors[0]); ++d) {
+    for (int r = -2; r <= 2; ++r) {
+      checkSimdFilter(ints, Modulo<int>(divisors[d], r));
+    }
+  }
+
+  // NaN is outside of every interval
+  Set<double, std::equal_to<double>> doubles;
+  for (int i = 0; i < 20; ++i) {
+    doubles.add(i);
+  }
+  doubles.add(std::numeric_limits<double>::quiet_NaN());
+  assert(filter_out(doubles, InRange<double>(-1e300, 1e300)).getNumElements() == 20);
+  assert(filter_out(doubles, GreaterThan<double>(-1.0)).getNumElements() == 20);
+  assert(filter_out(doubles, LessThan<double>(5.0)).getNumElements() == 5);
+
+  // Other Sets take the scalar path
+  Set<int, std::equal_to<int>> into;
+  into.add(-1);
+  assert(into.add_unchecked_if(ints, GreaterThan<int>(0)) == 50);
+  assert(into.getNumElements() == 51 && into.contains(7919) && !into.contains(0));
+  Set<std::string, std::equal_to<std::string>> strings;
+  strings.add("apple");
+  strings.add("banana");
+  strings.add("cherry");
+  Set<std::string, std::equal_to<std::string>> middle = filter_out(strings, InRange<std::string>("b", "c"));
+  assert(middle.getNumElements() == 1 && middle.contains("banana"));
+
+  std::cout << "testSimdFilter() passed" << std::endl;
+}
+
+void testCuckooFilter() {
+  CuckooFilter filter;
+  assert(filter.may_contain(42) && !filter.insert(42) && filter.false_positive_rate() == 1.0);
+
+  const size_t n = 30000;
+  std::vector<size_t> hashes;
+  for (size_t i = 0; i < n; ++i) {
+    hashes.push_back(hash_mix(i));
+  }
+  filter.rebuild(hashes.data(), n, n);
+  assert(filter.size() == n && filter.memory_usage() <= 16 * n);
+  for (size_t i = 0; i < n; ++i) {
+    assert(filter.may_contain(hashes[i]));
+  }
+
+  // The measured false positive rate matches the estimate
+  size_t passed = 0;
+  const size_t probes = 1000000;
+  for (size_t i = 0; i < probes; ++i) {
+    passed += filter.may_contain(hash_mix(n + i));
+  }
+  double estimate = filter.false_positive_rate();
+  assert(estimate > 0.0 && estimate < 0.0002);
+  assert(static_cast<double>(passed) / probes < 2 * estimate + 0.0001);
+
+  // Every other hash value is erased, the others still pass
+  for (size_t i = 0; i < n; i += 2) {
+    assert(filter.erase(hashes[i]));
+  }
+  assert(filter.size() == n / 2 && filter.false_positive_rate() < estimate);
+  for (size_t i = 1; i < n; i += 2) {
+    assert(filter.may_contain(hashes[i]));
+  }
+
+  // A filter too small for the hash values grows until they fit
+  filter.rebuild(hashes.data(), n, 10);
+  assert(filter.size() == n);
+  for (size_t i = 0; i < n; ++i) {
+    assert(filter.may_contain(hashes[i]));
+  }
+
+  // More than 8 equal hash values never fit: the filter saturates
+  std::vector<size_t> equal(9, hash_mix(n));
+  filter.rebuild(equal.data(), equal.size(), 16);
+  assert(filter.saturated() && filter.memory_usage() == 0 && filter.false_positive_rate() == 1.0);
+  assert(filter.may_contain(hash_mix(n + 1)) && filter.insert(hash_mix(n + 1)));
+  filter.rebuild(equal.data(), 8, 16);
+  assert(!filter.saturated() && filter.size() == 8 && !filter.may_contain(hash_mix(n + 1)));
+
+  std::cout << "testCuckooFilter() passed" << std::endl;
+}
+
+/**
+ * @brief Checks that a filtered Set holds exactly the strings "s0", "s1",
+ * ... whose flag is set, and that every string passes the filter.
+*/
+void checkFilteredSet(const stringSet& set, const std::vector<char>& expected) {
+  assert(set.has_filter());
+  size_t count = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    assert(set.contains("s" + std::to_string(i)) == (expected[i] != 0));
+    count += expected[i];
+  }
+  assert(set.getNumElements() == count);
+}
+
+void testSetFilter() {
+  stringSet set;
+  assert(!set.has_filter() && set.filter_false_positive_rate() == 1.0);
+  set.add("s0");
+  set.enable_filter();
+  assert(set.has_filter() && set.contains("s0") && !set.contains("s1"));
+
+  const size_t n = 5000;
+  std::vector<char> expected(2 * n, 0);
+  expected[0] = 1;
+  for (size_t i = 1; i < n; ++i) {
+    assert(set.add("s" + std::to_string(i)));
+    expected[i] = 1;
+  }
+  assert(!set.add("s7") && !set.remove("s" + std::to_string(n)));
+  checkFilteredSet(set, expected);
+  assert(set.filter_false_positive_rate() < 0.0002);
+
+  // remove, shrinking the array
+  for (size_t i = 0; i < n; i += 3) {
+    assert(set.remove("s" + std::to_string(i)));
+    expected[i] = 0;
+  }
+  checkFilteredSet(set, expected);
+
+  // emplace, try_emplace, add_range
+  assert(set.emplace("s" + std::to_string(n)) && !set.emplace("s1"));
+  assert(set.try_emplace(std::string("s") + std::to_string(n + 1), "s" + std::to_string(n + 1)));
+  expected[n] = expected[n + 1] = 1;
+  std::vector<std::string> range;
+  for (size_t i = n; i < n + 100; ++i) {
+    range.push_back("s" + std::to_string(i));
+    expected[i] = 1;
+  }
+  set.add_range(range.begin(), range.end());
+  checkFilteredSet(set, expected);
+
+  // remove_if, retain, operators
+  set.remove_if([](const std::string& s) { return s.size() == 3; });
+  for (size_t i = 10; i < 100; ++i) expected[i] = 0;
+  checkFilteredSet(set, expected);
+  stringSet other;
+  for (size_t i = n; i < 2 * n; ++i) {
+    other.add("s" + std::to_string(i));
+  }
+  set ^= other;
+  for (size_t i = n; i < 2 * n; ++i) expected[i] = !expected[i];
+  checkFilteredSet(set, expected);
+  set &= other;
+  for (size_t i = 0; i < n; ++i) expected[i] = 0;
+  checkFilteredSet(set, expected);
+  set += other;
+  for (size_t i = n; i < 2 * n; ++i) expected[i] = 1;
+  checkFilteredSet(set, expected);
+
+  // Copies and moves keep the filter, swap exchanges it
+  stringSet copy(set), moved(std::move(copy));
+  checkFilteredSet(moved, expected);
+  assert(!copy.has_filter());
+  moved.swap(copy);
+  assert(!moved.has_filter());
+  checkFilteredSet(copy, expected);
+  copy.shrink_to_fit();
+  checkFilteredSet(copy, expected);
+  copy.empty();
+  assert(copy.has_filter() && !copy.contains("s" + std::to_string(n)));
+  copy.add("s1");
+  assert(copy.contains("s1") && !copy.contains("s2"));
+  copy.disable_filter();
+  assert(!copy.has_filter() && copy.contains("s1"));
+
+  // The SIMD path of filter_out
+  intSet numbers;
+  numbers.enable_filter();
+  for (int i = 0; i < 1000; ++i) {
+    numbers.add(i);
+  }
+  intSet ranged;
+  ranged.enable_filter();
+  ranged.add_unchecked_if(numbers, InRange<int>(100, 199));
+  assert(ranged.getNumElements() == 100 && ranged.contains(100) && ranged.contains(199) && !ranged.contains(200));
+
+  // Colliding hash values saturate the filter, until the next reallocation
+  Set<Person, EqualNamesake> namesakes;
+  namesakes.enable_filter();
+  for (int age = 0; age < 30; ++age) {
+    assert(namesakes.add(Person("Ann", age)));
+  }
+  assert(namesakes.filter_false_positive_rate() == 1.0);
+  assert(namesakes.contains(Person("Ann", 29)) && !namesakes.contains(Person("Ann", 30)));
+  assert(!namesakes.add(Person("Ann", 7)) && namesakes.remove(Person("Ann", 7)));
+  namesakes.enable_filter();
+  assert(namesakes.filter_false_positive_rate() == 1.0 && !namesakes.contains(Person("Ann", 7)));
+  for (int age = 8; age < 30; ++age) {
+    assert(namesakes.remove(Person("Ann", age)));
+  }
+  assert(namesakes.getNumElements() == 7 && namesakes.filter_false_positive_rate() < 1.0);
+  assert(namesakes.contains(Person("Ann", 0)) && !namesakes.contains(Person("Bob", 0)));
+
+  std::cout << "testSetFilter() passed" << std::endl;
+}
+
+void testConcurrentSet() {
+  intConcurrentSet set(5);
+  assert(set.stripes() == 8 && set.getNumElements() == 0);
+  assert(set.add(1) && !set.add(1) && set.contains(1) && !set.contains(2));
+  assert(set.remove(1) && !set.remove(1) && set.getNumElements() == 0);
+
+  // Threads adding overlapping ranges: every element is added exactly once
+  const int THREADS = 8, N = 20000;
+  std::vector<size_t> added(THREADS, 0);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < THREADS; ++t) {
+    workers.push_back(std::thread([&set, &added, t]() {
+      for (int i = 0; i < N; ++i) {
+        added[t] += set.add((t * N / 2 + i) % (THREADS * N / 2));
+      }
+    }));
+  }
+  for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+  size_t total = 0;
+  for (int t = 0; t < THREADS; ++t) total += added[t];
+  assert(total == static_cast<size_t>(THREADS * N / 2) && set.getNumElements() == total);
+
+  // Removers, readers and snapshots at the same time
+  workers.clear();
+  for (int t = 0; t < THREADS / 2; ++t) {
+    workers.push_back(std::thread([&set, t]() {
+      for (int i = t; i < THREADS * N / 2; i += THREADS / 2) {
+        if (i % 2 == 1) assert(set.remove(i));
+      }
+    }));
+    workers.push_back(std::thread([&set, t]() {
+      for (int i = 0; i < N; i += 2) assert(set.contains(i));
+      intSet snapshot = set.snapshot();
+      assert(snapshot.getNumElements() >= static_cast<size_t>(THREADS * N / 4));
+    }));
+  }
+  for (size_t t = 0; t < workers.size(); ++t) workers[t].join();
+  assert(set.getNumElements() == static_cast<size_t>(THREADS * N / 4));
+
+  // Conversions to and from Set
+  intSet snapshot = set.snapshot();
+  assert(snapshot.getNumElements() == set.getNumElements());
+  size_t visited = 0;
+  set.for_each([&](int x) { assert(x % 2 == 0 && snapshot.contains(x)); ++visited; });
+  assert(visited == snapshot.getNumElements());
+  intConcurrentSet copy(snapshot);
+  assert(copy.stripes() == intConcurrentSet::DEFAULT_STRIPES && copy.getNumElements() == visited);
+  assert(copy.snapshot() == snapshot);
+  copy.empty();
+  assert(copy.getNumElements() == 0 && !copy.contains(0));
+
+  stringConcurrentSet strings;
+  std::string key = "key";
+  assert(strings.add(std::move(key)) && strings.contains("key") && !strings.add("key"));
+  std::stringstream buffer;
+  buffer << strings;
+  assert(buffer.str() == "1 (key)");
+
+  std::cout << "testConcurrentSet() passed" << std::endl;
+}
+
+void testShardedSetInt() {
+  intShardedSet set(5);
+  assert(set.shards() == 8 && set.getNumElements() == 0 && set.begin() == set.end());
+  for (int i = 0; i < 1000; ++i) {
+    assert(set.add(i));
+  }
+  assert(!set.add(7) && set.contains(999) && !set.contains(1000) && set.getNumElements() == 1000);
+  for (size_t s = 0; s < set.shards(); ++s) {
+    const intShardedSet::shard_type& shard = set.shard(s);
+    assert(shard.getNumElements() > 60 && shard.getNumElements() < 190); // About 125 each
+    for (size_t i = 0; i < shard.getNumElements(); ++i) {
+      assert(set.shard_of(shard[i]) == s);
+    }
+  }
+  try {
+    set.shard(8);
+    assert(false);
+  } catch (const std::out_of_range&) {}
+  assert(set.remove(7) && !set.remove(7) && !set.contains(7));
+
+  // Iteration visits every element once
+  intSet visited;
+  for (intShardedSet::const_iterator it = set.begin(); it != set.end(); ++it) {
+    assert(visited.add(*it));
+  }
+  assert(visited.getNumElements() == 999 && visited == set.to_set());
+
+  // Bulk operations, one shard per thread
+  ParallelPolicy policy(4, 1);
+  std::vector<int> range;
+  for (int i = 500; i < 3000; ++i) range.push_back(i);
+  assert(set.add_range(policy, range.begin(), range.end()) == 2000);
+  assert(set.getNumElements() == 2999);
+  set.reserve(policy, 8000);
+  for (size_t s = 0; s < set.shards(); ++s) assert(set.shard(s).capacity() >= 1000);
+  set.shrink_to_fit(policy);
+  for (size_t s = 0; s < set.shards(); ++s) assert(set.shard(s).capacity() == set.shard(s).getNumElements());
+  std::vector<size_t> sizes(set.shards(), 0);
+  set.for_each_shard(policy, [&](size_t s, const intShardedSet::shard_type& shard) { sizes[s] = shard.getNumElements(); });
+  assert(sizes[3] == set.shard(3).getNumElements());
+
+  // Conversion from Set
+  intShardedSet converted(visited, 3);
+  assert(converted.shards() == 4 && converted.to_set() == visited && converted == intShardedSet(visited));
+  converted.empty();
+  assert(converted.getNumElements() == 0 && converted.shards() == 4);
+
+  std::cout << "testShardedSetInt() passed" << std::endl;
+}
+
+void testShardedSetOperators() {
+  intSet a, b;
+  for (int i = 0; i < 3000; ++i) {
+    a.add(i);
+    b.add(i * 3);
+  }
+  intShardedSet sa(a), sb(b);
+  ParallelPolicy policy(4, 1);
+
+  assert((sa + sb).to_set() == a + b && unite(policy, sa, sb) == sa + sb);
+  assert((sa - sb).to_set() == a - b && intersection(policy, sa, sb) == intersection(sa, sb));
+  assert(difference(sa, sb).to_set() == difference(a, b) && difference(policy, sa, sb) == difference(sa, sb));
+  assert(symmetric_difference(sa, sb).to_set() == symmetric_difference(a, b));
+  assert(symmetric_difference(policy, sa, sb) == symmetric_difference(sa, sb));
+  auto isEven = [](int x) { return x % 2 == 0; };
+  assert(filter_out(sa, isEven).to_set() == filter_out(a, isEven));
+  assert(filter_out(policy, sa, isEven) == filter_out(sa, isEven));
+  assert(!(sa == sb) && sa == intShardedSet(a, 64));
+
+  // Shards with different layouts cannot be combined
+  try {
+    sa + intShardedSet(b, 4);
+    assert(false);
+  } catch (const std::invalid_argument&) {}
+
+  // Exceptions of the workers reach the caller
+  try {
+    filter_out(policy, sa, [](int x) {
+      if (x == 100) throw std::runtime_error("predicate failed");
+      return true;
+    });
+    assert(false);
+  } catch (const std::runtime_error&) {}
+
+  stringShardedSet strings(2);
+  strings.add("one");
+  std::string two = "two";
+  strings.add(std::move(two));
+  std::stringstream buffer;
+  buffer << strings;
+  assert(buffer.str().compare(0, 1, "2") == 0 && buffer.str().find("(one)") != std::string::npos);
+  std::string filename = "test_save_sharded.txt";
+  save(strings, filename);
+  std::ifstream inFile(filename);
+  std::string contents((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+  inFile.close();
+  assert(contents == buffer.str());
+  std::remove(filename.c_str());
+
+  std::cout << "testShardedSetOperators() passed" << std::endl;
+}
+
+void testRcuSet() {
+  intRcuSet set;
+  {
+    intRcuSet::Reader reader(set);
+    assert(!reader.contains(1) && reader.getNumElements() == 0);
+    assert(set.add(1) && !set.add(1) && reader.contains(1));
+    assert(set.retired() == 0); // No lookup in progress: freed at once
+
+    // A Snapshot keeps seeing its version, which is not freed meanwhile
+    {
+      intRcuSet::Snapshot snapshot(reader);
+      set.update([](intRcuSet::version_type& next) {
+        for (int i = 2; i < 100; ++i) next.add(i);
+      });
+      assert(snapshot->getNumElements() == 1 && !snapshot->contains(2));
+      assert(reader.contains(2)); // Lookups see the current version, even inside a Snapshot
+      assert(set.remove(1) && !set.remove(1));
+      assert(set.retired() == 2);
+      assert((*snapshot).contains(1));
+    }
+    assert(reader.getNumElements() == 98 && !reader.contains(1) && reader.contains(99));
+    set.reclaim();
+    assert(set.retired() == 0);
+
+    intRcuSet::version_type replacement;
+    replacement.add(-1);
+    set.publish(std::move(replacement));
+    assert(reader.getNumElements() == 1 && reader.contains(-1));
+  }
+
+  // The slot of a destroyed Reader is reused
+  {
+    intRcuSet::Reader reader(set);
+    assert(reader.contains(-1));
+  }
+
+  // Readers running while a writer publishes batches of 10 elements: every
+  // version holds whole batches
+  const int BATCHES = 200;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.push_back(std::thread([&set, &done]() {
+      intRcuSet::Reader reader(set);
+      while (!done.load()) {
+        intRcuSet::Snapshot snapshot(reader);
+        size_t n = snapshot->getNumElements();
+        assert((n - 1) % 10 == 0);
+        for (int i = 0; i < static_cast<int>(n - 1); ++i) {
+          assert(snapshot->contains(i));
+        }
+      }
+    }));
+  }
+  for (int b = 0; b < BATCHES; ++b) {
+    set.update([b](intRcuSet::version_type& next) {
+      for (int i = b * 10; i < b * 10 + 10; ++i) next.add(i);
+    });
+  }
+  done.store(true);
+  for (size_t t = 0; t < readers.size(); ++t) readers[t].join();
+  set.reclaim();
+  assert(set.retired() == 0);
+
+  // Conversions
+  intSet plain = set.to_set();
+  assert(plain.getNumElements() == BATCHES * 10 + 1 && plain.contains(-1));
+  intRcuSet copy(plain);
+  intRcuSet::Reader reader(copy);
+  assert(reader.getNumElements() == plain.getNumElements() && reader.contains(BATCHES * 10 - 1));
+
+  std::cout << "testRcuSet() passed" << std::endl;
+}
+
+void testPersistentSetInt() {
+  intPersistentSet empty;
+  assert(empty.getNumElements() == 0 && !empty.contains(0) && empty.begin() == empty.end());
+
+  // Every version keeps its elements
+  std::vector<intPersistentSet> versions(1, empty);
+  for (int i = 0; i < 2000; ++i) {
+    versions.push_back(versions.back().add(i * 7));
+  }
+  for (int v = 0; v <= 2000; v += 250) {
+    assert(versions[v].getNumElements() == static_cast<size_t>(v));
+    for (int i = 0; i < 2000; ++i) {
+      assert(versions[v].contains(i * 7) == (i < v));
+    }
+  }
+  const intPersistentSet& full = versions.back();
+  assert(full.add(7).shares(full) && full.remove(8).shares(full));
+
+  intPersistentSet smaller = full.remove(700);
+  assert(smaller.getNumElements() == 1999 && !smaller.contains(700) && full.contains(700));
+  assert(!(smaller == full) && smaller.add(700) == full && !smaller.add(700).shares(full));
+
+  // Removing everything, in another order than the additions
+  intPersistentSet drained = full;
+  for (int i = 1999; i >= 0; --i) {
+    drained = drained.remove(i * 7);
+    assert(drained.getNumElements() == static_cast<size_t>(i));
+  }
+  assert(drained == empty && full.getNumElements() == 2000);
+
+  // Iteration visits every element once
+  size_t visited = 0;
+  for (intPersistentSet::const_iterator it = full.begin(); it != full.end(); ++it) {
+    assert(*it % 7 == 0 && *it < 14000);
+    ++visited;
+  }
+  assert(visited == 2000);
+  assert(full.to_set().getNumElements() == 2000 && intPersistentSet(full.to_set()) == full);
+
+  // The Builder changes in place, without affecting the versions it shares
+  intPersistentSet::Builder builder(full);
+  for (int i = 0; i < 2000; ++i) {
+    assert(builder.add(i * 7 + 1));
+    assert(!builder.add(i * 7));
+  }
+  intPersistentSet doubled = builder.persistent();
+  for (int i = 0; i < 1000; ++i) {
+    assert(builder.remove(i * 7));
+  }
+  assert(!builder.remove(-1) && builder.getNumElements() == 3000);
+  assert(builder.contains(7000) && !builder.contains(0) && builder.contains(1));
+  assert(full.getNumElements() == 2000 && full.contains(0) && !full.contains(1));
+  assert(doubled.getNumElements() == 4000 && doubled.contains(0) && doubled.contains(1));
+
+  // Elements whose hash values are equal in every bit
+  collidingPersistentSet colliding;
+  collidingPersistentSet::Builder collidingBuilder;
+  for (int i = 0; i < 100; ++i) {
+    colliding = colliding.add(i);
+    assert(collidingBuilder.add(i));
+  }
+  assert(colliding.getNumElements() == 100 && collidingBuilder.persistent() == colliding);
+  collidingPersistentSet odd = filter_out(colliding, [](int v) { return v % 2 == 1; });
+  assert(odd.getNumElements() == 50 && odd.contains(99) && !odd.contains(98));
+  for (int i = 0; i < 100; ++i) {
+    colliding = colliding.remove(i);
+    assert(!colliding.contains(i) && colliding.contains(99) == (i < 99));
+  }
+  assert(colliding.getNumElements() == 0);
+
+  std::cout << "testPersistentSetInt() passed" << std::endl;
+}
+
+void testPersistentSetOperators() {
+  std::vector<int> values_a, values_b;
+  for (int i = 0; i < 3000; ++i) values_a.push_back(i);
+  for (int i = 1500; i < 6000; ++i) values_b.push_back(i);
+  intPersistentSet a(values_a.begin(), values_a.end());
+  intPersistentSet b(values_b.begin(), values_b.end());
+  intSet plain_a = a.to_set();
+  intSet plain_b = b.to_set();
+
+  assert((a + b).to_set() == plain_a + plain_b);
+  assert((a - b).to_set() == plain_a - plain_b);
+  assert(intersection(a, b).to_set() == intersection(plain_a, plain_b));
+  assert(difference(a, b).to_set() == difference(plain_a, plain_b));
+  assert(symmetric_difference(a, b).to_set() == symmetric_difference(plain_a, plain_b));
+  assert(a.getNumElements() == 3000 && b.getNumElements() == 4500);
+
+  stringPersistentSet words;
+  words = words.add("persistent").add("hash").add("trie");
+  std::ostringstream os;
+  os << words;
+  assert(os.str().substr(0, 2) == "3 " && os.str().find("(trie)") != std::string::npos);
+  save(words, "persistent_set.txt");
+  std::ifstream in("persistent_set.txt");
+  std::string saved((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  assert(saved == os.str());
+  in.close();
+  std::remove("persistent_set.txt");
+
+  std::cout << "testPersistentSetOperators() passed" << std::endl;
+}
+
+void testSmallSetInt() {
+  intSmallSet set;
+  for (int i = 0; i < 8; ++i) {
+    assert(set.add(i));
+  }
+  assert(!set.add(3));
+  assert(set.is_inline() && set.capacity() == 8);
+
+  // The ninth element spills to the heap, and removals bring it back inline
+  assert(set.add(8) && !set.is_inline() && set.capacity() == 16);
+  for (int i = 9; i < 40; ++i) {
+    set.add(i);
+  }
+  assert(set.getNumElements() == 40 && set.contains(39) && !set.contains(40));
+  for (int i = 0; i < 36; ++i) {
+    assert(set.remove(i));
+  }
+  assert(set.is_inline() && set.getNumElements() == 4);
+  assert(set.contains(36) && set.contains(39) && !set.contains(0));
+
+  intSmallSet copiedSet(set);
+  assert(copiedSet == set && copiedSet.is_inline());
+
+  int values[] = {5, 1, 5, 9};
+  intSmallSet rangeSet(values, values + 4);
+  std::stringstream buffer;
+  buffer << rangeSet;
+  assert(buffer.str() == "3 (5) (1) (9)");
+  assert(rangeSet[2] == 9);
+  bool thrown = false;
+  try {
+    rangeSet[3];
+  } catch (const std::out_of_range&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  std::cout << "testSmallSetInt() passed" << std::endl;
+}
+
+void testSmallSetString() {
+  stringSmallSet small, large;
+  small.add("a");
+  small.add("b");
+  for (int i = 0; i < 10; ++i) {
+    large.emplace(i + 1, 'x');
+  }
+  assert(small.is_inline() && !large.is_inline());
+
+  // Copies use the inline buffer when the elements fit
+  stringSmallSet copiedSmall(small), copiedLarge(large);
+  assert(copiedSmall.is_inline() && copiedSmall == small);
+  assert(!copiedLarge.is_inline() && copiedLarge == large);
+  copiedLarge = small;
+  assert(copiedLarge.is_inline() && copiedLarge == small);
+
+  // Moves take a dynamic array over, and move inline elements one at a time
+  stringSmallSet movedLarge(std::move(large));
+  assert(!movedLarge.is_inline() && movedLarge.getNumElements() == 10);
+  assert(large.getNumElements() == 0 && large.is_inline());
+  stringSmallSet movedSmall(std::move(small));
+  assert(movedSmall.getNumElements() == 2 && movedSmall.contains("b"));
+  assert(small.getNumElements() == 0);
+  std::string moved = "moved";
+  assert(movedSmall.add(std::move(moved)) && movedSmall.contains("moved"));
+
+  // Swaps of every combination of inline and dynamic storage
+  stringSmallSet other(movedLarge);
+  movedSmall.swap(movedLarge);
+  assert(movedSmall == other && movedLarge.getNumElements() == 3 && movedLarge.is_inline());
+  movedSmall.swap(movedLarge);
+  assert(movedLarge == other && movedSmall.contains("moved"));
+  stringSmallSet third(other);
+  movedLarge.swap(third);
+  assert(movedLarge == other && third == other);
+  movedSmall.swap(copiedSmall);
+  assert(movedSmall.getNumElements() == 2 && copiedSmall.getNumElements() == 3);
+
+  movedLarge = std::move(copiedSmall);
+  assert(movedLarge.contains("moved") && movedLarge.is_inline());
+
+  {
+    SmallSet<Tracked, std::equal_to<Tracked>, 3> tracked;
+    for (int i = 0; i < 10; ++i) {
+      tracked.add(Tracked(i));
+    }
+    assert(Tracked::live == 10);
+    for (int i = 0; i < 9; ++i) {
+      tracked.remove(Tracked(i));
+    }
+    assert(Tracked::live == 1 && tracked.is_inline());
+    SmallSet<Tracked, std::equal_to<Tracked>, 3> copy(tracked);
+    copy.swap(tracked);
+    assert(Tracked::live == 2);
+  }
+  assert(Tracked::live == 0);
+
+  std::cout << "testSmallSetString() passed" << std::endl;
+}
+
+void testSmallSetOperators() {
+  personSmallSet people;
+  people.add(Person("Ruben", 99));
+  people.add(Person("Youness", 13));
+  assert(!people.add(Person("Ruben", 99)) && people.is_inline());
+  people.add(Person("Quack", 64));
+  assert(!people.is_inline() && people.contains(Person("Quack", 64)));
+
+  intSmallSet set1;
+  set1.add(1);
+  set1.add(2);
+  set1.add(3);
+
+  intSmallSet set2;
+  set2.add(3);
+  set2.add(4);
+  set2.add(5);
+
+  std::stringstream buffer;
+  buffer << set1 + set2 << " " << set1 - set2 << " " << difference(set1, set2)
+         << " " << symmetric_difference(set1, set2);
+  assert(buffer.str() == "5 (1) (2) (3) (4) (5) 1 (3) 2 (1) (2) 4 (1) (2) (4) (5)");
+
+  auto isOdd = [](int x) { return x % 2 == 1; };
+  intSmallSet filteredSet = filter_out(set1 + set2, isOdd);
+  assert(filteredSet.getNumElements() == 3);
+  assert(filteredSet.contains(1) && filteredSet.contains(3) && filteredSet.contains(5));
+
+  stringSmallSet strings;
+  strings.add("Hello");
+  strings.add("World");
+
+  std::string filename = "test_save_small.txt";
+  save(strings, filename);
+
+  std::ifstream inFile(filename);
+  assert(inFile.is_open());
+  std::stringstream fileContents;
+  fileContents << inFile.rdbuf();
+  inFile.close();
+  assert(fileContents.str() == "2 (Hello) (World)");
+  std::remove(filename.c_str());
+
+  std::cout << "testSmallSetOperators() passed" << std::endl;
+}
+
+void testBitSetInt() {
+  intBitSet set;
+  assert(set.words() == nullptr && !set.contains(5) && set.begin() == set.end());
+  assert(set.add(5) && set.add(999) && set.add(0) && set.add(64) && set.add(63));
+  assert(!set.add(5) && set.getNumElements() == 5);
+  assert(set.contains(999) && !set.contains(998) && !set.contains(-1) && !set.contains(1000));
+
+  bool thrown = false;
+  try {
+    set.add(1000);
+  } catch (const std::out_of_range&) {
+    thrown = true;
+  }
+  assert(thrown && set.getNumElements() == 5);
+  thrown = false;
+  try {
+    set.add(-1);
+  } catch (const std::out_of_range&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  // Ascending order, whatever the order of insertion
+  std::stringstream buffer;
+  buffer << set;
+  assert(buffer.str() == "5 (0) (5) (63) (64) (999)");
+  assert(set[0] == 0 && set[2] == 63 && set[3] == 64 && set[4] == 999);
+  std::vector<int> values(set.begin(), set.end());
+  assert(values.size() == 5 && values[1] == 5);
+
+  assert(set.remove(63) && !set.remove(63) && !set.remove(-3) && !set.contains(63));
+  assert(set.getNumElements() == 4 && set[2] == 64);
+
+  intBitSet copiedSet(set);
+  assert(copiedSet == set);
+  copiedSet.remove(0);
+  copiedSet.add(1);
+  assert(!(copiedSet == set) && copiedSet.getNumElements() == set.getNumElements());
+
+  intBitSet movedSet(std::move(copiedSet));
+  assert(movedSet.contains(1) && copiedSet.getNumElements() == 0 && copiedSet.words() == nullptr);
+  copiedSet = movedSet;
+  assert(copiedSet == movedSet);
+  copiedSet.empty();
+  assert(copiedSet.getNumElements() == 0 && copiedSet == intBitSet());
+
+  int data[] = {7, 3, 7, 500};
+  intBitSet rangeSet(data, data + 4);
+  assert(rangeSet.getNumElements() == 3 && rangeSet[0] == 3);
+
+  // Unsigned and narrow types
+  BitSet<300, unsigned char> bytes;
+  assert(bytes.add(255) && bytes.add(0) && *bytes.begin() == 0);
+  BitSet<70000, unsigned> ids;
+  assert(ids.add(69999u) && ids.contains(69999u) && !ids.contains(4000000000u));
+
+  std::cout << "testBitSetInt() passed" << std::endl;
+}
+
+void testBitSetOperators() {
+  intBitSet set1, set2;
+  for (int i = 0; i < 1000; i += 2) {
+    set1.add(i); // Even numbers
+  }
+  for (int i = 0; i < 1000; i += 3) {
+    set2.add(i); // Multiples of 3
+  }
+
+  intBitSet both = set1 + set2;
+  intBitSet common = set1 - set2;
+  assert(common == intersection(set1, set2));
+  intBitSet onlyEven = difference(set1, set2);
+  intBitSet exactlyOne = symmetric_difference(set1, set2);
+  for (int i = 0; i < 1000; ++i) {
+    bool even = i % 2 == 0, triple = i % 3 == 0;
+    assert(both.contains(i) == (even || triple));
+    assert(common.contains(i) == (even && triple));
+    assert(onlyEven.contains(i) == (even && !triple));
+    assert(exactlyOne.contains(i) == (even != triple));
+  }
+  assert(common.getNumElements() == 167 && both.getNumElements() == 667);
+  assert(onlyEven.getNumElements() + common.getNumElements() == set1.getNumElements());
+
+  intBitSet none;
+  assert(set1 + none == set1 && (set1 - none).getNumElements() == 0 && (none + none).words() == nullptr);
+
+  auto isSmall = [](int x) { return x < 10; };
+  intBitSet filteredSet = filter_out(set1, isSmall);
+  std::stringstream buffer;
+  buffer << filteredSet;
+  assert(buffer.str() == "5 (0) (2) (4) (6) (8)");
+
+  std::string filename = "test_save_bits.txt";
+  save(filteredSet, filename);
+
+  std::ifstream inFile(filename);
+  assert(inFile.is_open());
+  std::stringstream fileContents;
+  fileContents << inFile.rdbuf();
+  inFile.close();
+  assert(fileContents.str() == "5 (0) (2) (4) (6) (8)");
+  std::remove(filename.c_str());
+
+  std::cout << "testBitSetOperators() passed" << std::endl;
+}
+
+/**
+ * @brief Checks a RoaringSet against the std::set of the same values.
+*/
+void checkRoaring(const idRoaringSet& set, const std::set<unsigned>& expected) {
+  assert(set.getNumElements() == expected.size());
+  assert(std::equal(expected.begin(), expected.end(), set.begin()));
+  size_t n = expected.size();
+  if (n > 0) {
+    assert(set[0] == *expected.begin() && set[static_cast<int>(n - 1)] == *expected.rbegin());
+    std::set<unsigned>::const_iterator middle = expected.begin();
+    std::advance(middle, n / 2);
+    assert(set[static_cast<int>(n / 2)] == *middle && set.contains(*middle));
+  }
+}
+
+/**
+ * @brief Values mixing the three forms of containers: sparse values, a dense
+ * chunk and long runs.
+*/
+std::set<unsigned> roaringValues(unsigned seed) {
+  std::set<unsigned> values;
+  unsigned state = seed;
+  for (int i = 0; i < 3000; ++i) {
+    state = state * 1103515245u + 12345u;
+    values.insert(state); // Sparse over the whole 32 bit space
+  }
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    values.insert((7u << 16) | (state >> 16)); // Dense chunk
+  }
+  for (unsigned v = 0; v < 5000; ++v) {
+    values.insert((9u << 16) + seed % 1000 + v); // Runs
+    values.insert((11u << 16) + (v / 100) * 200 + v % 100 + seed % 7);
+  }
+  return values;
+}
+
+void testRoaringSetInt() {
+  idRoaringSet set;
+  assert(set.begin() == set.end() && !set.contains(0));
+  assert(set.add(70000) && set.add(5) && set.add(4000000000u) && !set.add(5));
+  assert(set.contains(70000) && !set.contains(70001) && set.getNumElements() == 3);
+  std::stringstream buffer;
+  buffer << set;
+  assert(buffer.str() == "3 (5) (70000) (4000000000)");
+  assert(set.remove(70000) && !set.remove(70000) && set.getNumElements() == 2);
+
+  // Negative ints come after the positive ones
+  RoaringSet<int> ints;
+  ints.add(-1);
+  ints.add(1);
+  assert(ints[0] == 1 && ints[1] == -1 && ints.contains(-1));
+
+  // An array becomes a bitmap beyond 4096 values, and an array again below
+  std::set<unsigned> expected;
+  idRoaringSet dense;
+  for (unsigned v = 0; v < 10000; v += 2) {
+    dense.add(v);
+    expected.insert(v);
+  }
+  checkRoaring(dense, expected);
+  for (unsigned v = 0; v < 8000; v += 4) {
+    assert(dense.remove(v));
+    expected.erase(v);
+  }
+  checkRoaring(dense, expected);
+
+  // Runs
+  idRoaringSet runs;
+  std::set<unsigned> expectedRuns;
+  for (unsigned v = 100000; v < 160000; ++v) {
+    runs.add(v);
+    expectedRuns.insert(v);
+  }
+  size_t before = runs.memory_usage();
+  idRoaringSet copy(runs);
+  runs.optimize();
+  assert(runs.memory_usage() < before / 50);
+  assert(runs == copy && copy == runs);
+  checkRoaring(runs, expectedRuns);
+  assert(runs.contains(100000) && runs.contains(159999) && !runs.contains(99999) && !runs.contains(160000));
+  assert(runs.add(5) && runs.remove(130000) && !runs.add(130001));
+  expectedRuns.insert(5);
+  expectedRuns.erase(130000);
+  checkRoaring(runs, expectedRuns);
+
+  // Random operations against std::set
+  idRoaringSet random;
+  std::set<unsigned> expectedRandom;
+  unsigned state = 1;
+  for (int i = 0; i < 40000; ++i) {
+    state = state * 1103515245u + 12345u;
+    unsigned v = (state >> 8) % 300000;
+    if (state % 3 == 0) {
+      assert(random.remove(v) == (expectedRandom.erase(v) == 1));
+    } else {
+      assert(random.add(v) == expectedRandom.insert(v).second);
+    }
+    if (i % 10000 == 0) random.optimize();
+  }
+  checkRoaring(random, expectedRandom);
+
+  std::vector<unsigned> data(expectedRandom.begin(), expectedRandom.end());
+  idRoaringSet rangeSet(data.rbegin(), data.rend());
+  assert(rangeSet == random);
+  idRoaringSet movedSet(std::move(rangeSet));
+  assert(movedSet == random && rangeSet.getNumElements() == 0);
+  rangeSet = movedSet;
+  rangeSet.empty();
+  assert(rangeSet == idRoaringSet() && rangeSet.memory_usage() == sizeof(idRoaringSet));
+
+  std::cout << "testRoaringSetInt() passed" << std::endl;
+}
+
+void testRoaringSetOperators() {
+  std::set<unsigned> values1 = roaringValues(1), values2 = roaringValues(2);
+  idRoaringSet set1(values1.begin(), values1.end()), set2(values2.begin(), values2.end());
+  checkRoaring(set1, values1);
+
+  for (int optimized = 0; optimized < 2; ++optimized) {
+    std::set<unsigned> expected;
+    std::set_union(values1.begin(), values1.end(), values2.begin(), values2.end(),
+                   std::inserter(expected, expected.end()));
+    checkRoaring(set1 + set2, expected);
+
+    expected.clear();
+    std::set_intersection(values1.begin(), values1.end(), values2.begin(), values2.end(),
+                          std::inserter(expected, expected.end()));
+    checkRoaring(set1 - set2, expected);
+    assert(intersection(set1, set2) == set1 - set2);
+
+    expected.clear();
+    std::set_difference(values1.begin(), values1.end(), values2.begin(), values2.end(),
+                        std::inserter(expected, expected.end()));
+    checkRoaring(difference(set1, set2), expected);
+
+    expected.clear();
+    std::set_symmetric_difference(values1.begin(), values1.end(), values2.begin(), values2.end(),
+                                  std::inserter(expected, expected.end()));
+    checkRoaring(symmetric_difference(set1, set2), expected);
+
+    assert(!(set1 == set2) && set1 + set1 == set1 && difference(set1, set1) == idRoaringSet());
+    set1.optimize(); // Again with run containers
+  }
+
+  auto isEven = [](unsigned x) { return x % 2 == 0; };
+  std::set<unsigned> even;
+  for (std::set<unsigned>::const_iterator it = values1.begin(); it != values1.end(); ++it) {
+    if (isEven(*it)) even.insert(*it);
+  }
+  checkRoaring(filter_out(set1, isEven), even);
+
+  // save and load, in every form of container
+  std::string filename = "test_save_roaring.bin";
+  save(set1, filename);
+  idRoaringSet loaded;
+  loaded.add(42);
+  assert(load(loaded, filename) && loaded == set1);
+  checkRoaring(loaded, values1);
+
+  // A truncated file is rejected, leaving the set unchanged
+  std::ifstream inFile(filename, std::ios::binary);
+  std::string contents((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+  inFile.close();
+  std::ofstream outFile(filename, std::ios::binary);
+  outFile.write(contents.data(), contents.size() / 2);
+  outFile.close();
+  assert(!load(loaded, filename) && loaded == set1);
+  std::remove(filename.c_str());
+  assert(!load(loaded, filename) && loaded == set1);
+
+  std::cout << "testRoaringSetOperators() passed" << std::endl;
+}
+
+int main() {
+  // copy constructor
+  testCopyConstructorInt();
+
+  // assignment operator
+  testAssignmentOperatorInt();
+
+  // tests copy on write
+  testCopyOnWriteInt();
+  testCopyOnWriteThreads();
+
+  // destructor
+  testDestructorInt();
+
+  // empty
+  testEmptyInt();
+
+  // swap
+  testSwapInt();
+
+  // tests add
+  testAddInt();
+  testAddString();
+  testAddPerson();
+
+  // tests remove
+  testRemoveInt();
+  testRemoveString();
+  testRemovePerson();
+
+  // tests operator[]
+  testBracketOperatorInt();
+  testBracketOperatorString();
+  testBracketOperatorPerson();
+
+  // tests contains
+  testContainsInt();
+  testContainsString();
+  testContainsPerson();
+
+  // tests const iterator
+  testConstIteratorInt();
+  testConstIteratorString();
+  testConstIteratorPerson();
+
+  // tests constructor with iterators
+  testIteratorConstructorInt();
+  testIteratorConstructorString();
+  testIteratorConstructorPerson();
+
+  // tests operator<<
+  testPrintOperatorInt();
+  testPrintOperatorString();
+  testPrintOperatorPerson();
+
+  // tests operator==
+  testEqualityOperatorInt();
+  testEqualityOperatorString();
+  testEqualityOperatorPerson();
+
+  // tests filter_out
+  testFilterOutInt();
+  testFilterOutString();
+  testFilterOutPerson();
+
+  // tests operator+
+  testConcatenationOperatorInt();
+  testConcatenationOperatorString();
+  testConcatenationOperatorPerson();
+
+  // tests operator-
+  testDifferenceOperatorInt();
+  testDifferenceOperatorString();
+  testDifferenceOperatorPerson();
+
+  // tests set algebra kernels
+  testHashJoin();
+  testDifferences();
+  testCompoundOperators();
+  testParallelAlgorithms();
+
+  // tests save
+  testSaveFunction();
+
+  // tests move semantics
+  testMoveConstructorString();
+  testAddMoveString();
+  testMoveOnlyElements();
+
+  // tests raw storage
+  testRawStorage();
+
+  // tests capacity management
+  testReserveInt();
+  testGrowthPolicies();
+
+  // tests SIMD kernels
+  testSimdFind();
+  testSimdFilter();
+
+  // tests membership filter
+  testCuckooFilter();
+  testSetFilter();
+
+  // tests bulk insertion
+  testAddRange();
+  testUniqueFastPath();
+
+  // tests bulk removal
+  testBulkRemoval();
+
+  // tests allocators
+  testStatefulAllocator();
+#if __cplusplus >= 201703L
+  testPmrSet();
+#endif
+
+  // tests HashSet
+  testHashers();
+  testHashSetInt();
+  testHashSetString();
+  testHashSetPerson();
+  testHashSetOperators();
+
+  // tests ConcurrentSet
+  testConcurrentSet();
+
+  // tests ShardedSet
+  testShardedSetInt();
+  testShardedSetOperators();
+
+  // tests RcuSet
+  testRcuSet();
+
+  // tests PersistentSet
+  testPersistentSetInt();
+  testPersistentSetOperators();
+
+  // tests SmallSet
+  testSmallSetInt();
+  testSmallSetString();
+  testSmallSetOperators();
+
+  // tests BitSet
+  testBitSetInt();
+  testBitSetOperators();
+
+  // tests RoaringSet
+  testRoaringSetInt();
+  testRoaringSetOperators();
+
+  // tests SwissSet
+  testSwissSetInt();
+  testSwissSetString();
+  testIndexStats();
+
+  // tests SortedSet
+  testSortedSetInt();
+  testSortedSetPerson();
+  testSortedSetOperators();
 
   std::cout << "All tests passed!" << std::endl;
   return 0;
@@ -0,0 +1,360 @@
+/**
+ * @file parallel.hpp
+ *
+ * @brief Header file for the parallel algorithms of the templated Set class.
+ *
+ * Declaration/Definition of the ParallelPolicy execution policy and of the
+ * overloads of the Set algorithms taking it. The array of the Set is split in
+ * contiguous partitions evaluated by std::thread workers; the partial results
+ * are merged in partition order, so the output is deterministic and identical
+ * to the one of the sequential algorithms.
+ *
+ * Link with -pthread.
+*/
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <thread> // std::thread
+#include <exception> // std::exception_ptr
+#include <vector> // std::vector
+#include <algorithm> // std::min, std::count
+#include "set.hpp"
+
+/**
+ * @brief Execution policy of the parallel Set algorithms.
+ *
+ * Tells how many threads may be used, and the minimum number of elements
+ * worth a thread: small inputs are processed by the calling thread alone.
+*/
+struct ParallelPolicy {
+  size_t threads; ///< Maximum number of threads, 0 for std::thread::hardware_concurrency()
+  size_t min_partition; ///< Minimum number of elements per thread
+
+  /**
+   * @brief Constructor.
+   *
+   * @param threads Maximum number of threads, 0 for the number of hardware
+   * threads.
+   * @param min_partition Minimum number of elements per thread.
+  */
+  explicit ParallelPolicy(size_t threads = 0, size_t min_partition = 4096)
+    : threads(threads), min_partition(min_partition > 0 ? min_partition : 1) {}
+
+  /**
+   * @brief Number of partitions of an input.
+   *
+   * @param n Number of elements of the input.
+   *
+   * @return The number of partitions, between 1 and the number of threads.
+  */
+  size_t partitions(size_t n) const {
+    size_t count = threads;
+    if (count == 0) {
+      count = std::thread::hardware_concurrency();
+      if (count == 0) count = 1;
+    }
+    size_t useful = n / min_partition;
+    if (useful < count) count = useful;
+    return count > 0 ? count : 1;
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Calls a function on contiguous partitions of [0, n), in parallel.
+ *
+ * The first partition is processed by the calling thread. Waits for every
+ * partition before returning, even if some of them throw.
+ *
+ * @param policy The execution policy.
+ * @param n Number of positions.
+ * @param f Functor called as f(begin, end) once per non empty partition,
+ * concurrently: it must only write to the positions of its partition.
+ *
+ * @throw Any exception thrown by 'f' (the one of the first partition that
+ * threw), or std::system_error if a thread cannot be started.
+*/
+template <typename Function>
+void parallel_for(const ParallelPolicy& policy, size_t n, Function f) {
+  size_t count = policy.partitions(n);
+  if (count <= 1) {
+    if (n > 0) f(static_cast<size_t>(0), n);
+    return;
+  }
+
+  size_t step = (n + count - 1) / count;
+  std::vector<std::exception_ptr> errors(count);
+  auto run = [&](size_t part) {
+    try {
+      size_t begin = part * step;
+      size_t end = std::min(n, begin + step);
+      if (begin < end) f(begin, end);
+    } catch (...) {
+      errors[part] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(count - 1);
+  try {
+    for (size_t part = 1; part < count; ++part) {
+      workers.push_back(std::thread(run, part));
+    }
+  } catch (...) {
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+    throw;
+  }
+  run(0);
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+  }
+
+  for (size_t part = 0; part < count; ++part) {
+    if (errors[part]) std::rethrow_exception(errors[part]);
+  }
+}
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y', probing 'y' with every
+ * element of 'x' in parallel, when no hasher consistent with Equal is known.
+ *
+ * @param policy The execution policy.
+ * @param x The Set whose elements are flagged.
+ * @param y The Set in which they are searched.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void parallel_match_flags(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& x,
+                          const Set<T, Equal, Policy, Allocator>& y, std::vector<char>& x_in_y,
+                          std::false_type) {
+  const T* elements = x.data();
+  x_in_y.assign(x.getNumElements(), 0);
+  detail::parallel_for(policy, x.getNumElements(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      x_in_y[i] = y.contains(elements[i]) ? 1 : 0;
+    }
+  });
+}
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y' with a parallel hash
+ * join.
+ *
+ * The hashes of 'y' are computed in parallel, the temporary hash index is
+ * built by the calling thread, then it is probed with the elements of 'x' in
+ * parallel (find() is read only).
+ *
+ * @param policy The execution policy.
+ * @param x The Set whose elements are flagged.
+ * @param y The Set in which they are searched.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void parallel_match_flags(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& x,
+                          const Set<T, Equal, Policy, Allocator>& y, std::vector<char>& x_in_y,
+                          std::true_type) {
+  typedef typename HashTraits<T, Equal>::hasher Hasher;
+  size_t nx = x.getNumElements();
+  size_t ny = y.getNumElements();
+  const T* xs = x.data();
+  const T* ys = y.data();
+
+  std::vector<size_t> hashes(ny);
+  detail::parallel_for(policy, ny, [&](size_t begin, size_t end) {
+    Hasher hasher;
+    for (size_t i = begin; i < end; ++i) {
+      hashes[i] = hasher(ys[i]);
+    }
+  });
+  ChainedIndex index;
+  index.rebuild(hashes.data(), ny, ny);
+
+  x_in_y.assign(nx, 0);
+  detail::parallel_for(policy, nx, [&](size_t begin, size_t end) {
+    Hasher hasher;
+    Equal equal;
+    for (size_t i = begin; i < end; ++i) {
+      const T& value = xs[i];
+      size_t pos = index.find(hasher(value), [&](size_t p) { return equal(ys[p], value); });
+      x_in_y[i] = pos != ChainedIndex::npos ? 1 : 0;
+    }
+  });
+}
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y' in parallel, picking the
+ * strategy from HashTraits.
+ *
+ * @param policy The execution policy.
+ * @param x The Set whose elements are flagged.
+ * @param y The Set in which they are searched.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void parallel_match_flags(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& x,
+                          const Set<T, Equal, Policy, Allocator>& y, std::vector<char>& x_in_y) {
+  detail::parallel_match_flags(policy, x, y, x_in_y,
+                               std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+}
+
+} // namespace detail
+
+/**
+ * @brief Filters elements of a set based on a predicate, in parallel.
+ *
+ * The predicate is evaluated concurrently on contiguous partitions of the
+ * array; the selected elements are then appended in the order of S, so the
+ * result is the same as the one of filter_out(S, P).
+ *
+ * @tparam Predicate A functor or function that takes an element of type T and
+ *         returns a boolean. It is called concurrently: it must be thread safe.
+ *
+ * @param policy The execution policy.
+ * @param S The original Set from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new Set.
+ *
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing elements that
+ * satisfy the predicate P.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator, typename Predicate>
+Set<T, Equal, Policy, Allocator> filter_out(const ParallelPolicy& policy,
+                                            const Set<T, Equal, Policy, Allocator>& S, Predicate P) {
+  Set<T, Equal, Policy, Allocator> new_set(S.get_allocator());
+  try {
+    const T* elements = S.data();
+    std::vector<char> selected(S.getNumElements(), 0);
+    detail::parallel_for(policy, S.getNumElements(), [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        selected[i] = P(elements[i]) ? 1 : 0;
+      }
+    });
+    new_set.reserve(std::count(selected.begin(), selected.end(), 1));
+    detail::append_flagged(new_set, S, selected, 1);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the union of two sets, in parallel.
+ *
+ * The parallel counterpart of operator+: the elements of 'b' are searched in
+ * 'a' concurrently, then the elements of 'a' followed by the new elements of
+ * 'b' are copied in order.
+ *
+ * @param policy The execution policy.
+ * @param a The first Set.
+ * @param b The second Set.
+ *
+ * @return Set<T, Equal, Policy, Allocator> A new Set equal to a + b.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> unite(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& a,
+                                       const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a, a.get_allocator());
+  try {
+    std::vector<char> in_a;
+    detail::parallel_match_flags(policy, b, a, in_a);
+    new_set.reserve(a.getNumElements() + std::count(in_a.begin(), in_a.end(), 0));
+    detail::append_flagged(new_set, b, in_a, 0);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in unite: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the intersection of two sets, in parallel.
+ *
+ * The parallel counterpart of intersection() and operator-: the elements of
+ * 'a' are searched in 'b' concurrently, then the common ones are copied in
+ * the order of 'a'.
+ *
+ * @param policy The execution policy.
+ * @param a The first Set to intersect.
+ * @param b The second Set to intersect.
+ *
+ * @return Set<T, Equal, Policy, Allocator> A new Set equal to a - b.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> intersection(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& a,
+                                              const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a.get_allocator());
+  try {
+    std::vector<char> in_b;
+    detail::parallel_match_flags(policy, a, b, in_b);
+    new_set.reserve(std::count(in_b.begin(), in_b.end(), 1));
+    detail::append_flagged(new_set, a, in_b, 1);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the difference of two sets, in parallel.
+ *
+ * The parallel counterpart of difference().
+ *
+ * @param policy The execution policy.
+ * @param a The Set whose elements are kept.
+ * @param b The Set whose elements are removed.
+ *
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing a \ b.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> difference(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& a,
+                                            const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a.get_allocator());
+  try {
+    std::vector<char> in_b;
+    detail::parallel_match_flags(policy, a, b, in_b);
+    new_set.reserve(std::count(in_b.begin(), in_b.end(), 0));
+    detail::append_flagged(new_set, a, in_b, 0);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Compares two sets for equality, in parallel.
+ *
+ * The parallel counterpart of operator==: the Sets are equal if they have the
+ * same number of elements and every element of 'a' is contained in 'b'.
+ *
+ * @param policy The execution policy.
+ * @param a The first Set.
+ * @param b The second Set.
+ *
+ * @return true if the Sets hold the same elements, in any order.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+bool equals(const ParallelPolicy& policy, const Set<T, Equal, Policy, Allocator>& a,
+            const Set<T, Equal, Policy, Allocator>& b) {
+  if (a.getNumElements() != b.getNumElements()) return false;
+
+  std::vector<char> in_b;
+  detail::parallel_match_flags(policy, a, b, in_b);
+  return std::count(in_b.begin(), in_b.end(), 0) == 0;
+}
+
+#endif // PARALLEL_HPP
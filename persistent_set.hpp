@@ -0,0 +1,1026 @@
+/**
+ * @file persistent_set.hpp
+ *
+ * @brief Header file for the templated PersistentSet class.
+ *
+ * Declaration/Definition of the templated PersistentSet class, an immutable
+ * sibling of Set stored in a hash array mapped trie whose nodes are shared
+ * between versions, of its Builder, and of its algorithms.
+*/
+
+#ifndef PERSISTENT_SET_HPP
+#define PERSISTENT_SET_HPP
+
+#include <iostream>
+#include <ostream> // std::ostream
+#include <fstream> // std::ofstream
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <cstdint> // std::uint32_t
+#include <atomic> // std::atomic
+#include <vector> // std::vector
+#include <utility> // std::pair, std::swap
+#include "set.hpp"
+#include "bit_set.hpp" // detail::popcount64
+
+/**
+ * @brief PersistentSet Class
+ *
+ * Immutable Set of type T elements. add() and remove() never modify a
+ * PersistentSet: they return a new version, which shares with the old one
+ * every node of the trie except the O(log32 n) ones on the path to the
+ * changed element. Copies share the whole trie, so copying, assigning and
+ * keeping many versions of a large PersistentSet cost O(1) each.
+ *
+ * The trie consumes the hash value of an element 5 bits per level. A node
+ * has a 32 bit map of the positions holding an element and one of the
+ * positions holding a child, and stores only the occupied positions, in
+ * order. The elements whose hash values are equal in every bit end up in a
+ * collision node, searched linearly.
+ *
+ * The nodes are reference counted with atomic counters, so versions sharing
+ * nodes can be read, copied and destroyed by different threads.
+ *
+ * Batches of changes are faster through a Builder, which modifies in place
+ * the nodes that no PersistentSet shares.
+ *
+ * @tparam T Type of the elements in the PersistentSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam Hash Functor used for hashing an element. Two elements that are
+ * equal according to Equal must have the same hash value.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T> >
+class PersistentSet {
+private:
+  enum {
+    BITS = 5, ///< Bits of the hash value consumed per level
+    MASK = 31 ///< Mask of the bits of one level
+  };
+
+  typedef std::pair<size_t, T> entry_type; ///< Hash value and element
+
+  /**
+   * @brief A node of the trie.
+   *
+   * A collision node (below the last level) has empty maps and no children.
+  */
+  struct Node {
+    std::atomic<size_t> refs; ///< Number of references to the node
+    std::uint32_t datamap; ///< Positions holding an element
+    std::uint32_t nodemap; ///< Positions holding a child
+    std::vector<entry_type> entries; ///< Elements, by position
+    std::vector<Node*> children; ///< Children, by position
+
+    Node() : refs(1), datamap(0), nodemap(0) {}
+
+    /**
+     * @brief Copy of a node, referenced once, sharing the children of 'other'.
+    */
+    Node(const Node& other)
+      : refs(1), datamap(other.datamap), nodemap(other.nodemap), entries(other.entries),
+        children(other.children) {
+      for (size_t i = 0; i < children.size(); ++i) {
+        retain(children[i]);
+      }
+    }
+  };
+
+  Node* _root; ///< Root of the trie, nullptr if empty
+  size_t _num_elements; ///< Number of elements in the trie
+  Equal _equal; ///< Instance of the Equal functor
+  Hash _hash; ///< Instance of the Hash functor
+
+  /**
+   * @brief Adds a reference to a node.
+  */
+  static void retain(Node* node) {
+    if (node != nullptr) {
+      node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Drops a reference to a node, deleting the node (and dropping its
+   * references to its children) if it was the last one.
+  */
+  static void release(Node* node) {
+    if (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      for (size_t i = 0; i < node->children.size(); ++i) {
+        release(node->children[i]);
+      }
+      delete node;
+    }
+  }
+
+  /**
+   * @brief Tells if the hash value has no bits left below 'shift'.
+  */
+  static bool is_collision(size_t shift) {
+    return shift >= sizeof(size_t) * 8;
+  }
+
+  /**
+   * @brief Returns the position of 'bit' among the bits set in 'map'.
+  */
+  static size_t index_of(std::uint32_t map, std::uint32_t bit) {
+    return detail::popcount64(map & (bit - 1));
+  }
+
+  /**
+   * @brief Builds the subtrie holding two entries whose hash values are
+   * equal above 'shift'.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  static Node* pair_node(const entry_type& a, const entry_type& b, size_t shift) {
+    Node* node = new Node;
+    try {
+      if (is_collision(shift)) {
+        node->entries.push_back(a);
+        node->entries.push_back(b);
+        return node;
+      }
+      std::uint32_t bit_a = 1u << ((a.first >> shift) & MASK);
+      std::uint32_t bit_b = 1u << ((b.first >> shift) & MASK);
+      if (bit_a == bit_b) {
+        node->children.push_back(pair_node(a, b, shift + BITS));
+        node->nodemap = bit_a;
+      } else {
+        node->entries.push_back(bit_a < bit_b ? a : b);
+        node->entries.push_back(bit_a < bit_b ? b : a);
+        node->datamap = bit_a | bit_b;
+      }
+    } catch (...) {
+      release(node);
+      throw;
+    }
+    return node;
+  }
+
+  /**
+   * @brief Searches an element in the trie.
+  */
+  bool find(size_t hash, const T& value) const {
+    const Node* node = _root;
+    for (size_t shift = 0; node != nullptr; shift += BITS) {
+      if (is_collision(shift)) {
+        for (size_t i = 0; i < node->entries.size(); ++i) {
+          if (_equal(node->entries[i].second, value)) return true;
+        }
+        return false;
+      }
+      std::uint32_t bit = 1u << ((hash >> shift) & MASK);
+      if (node->datamap & bit) {
+        const entry_type& entry = node->entries[index_of(node->datamap, bit)];
+        return entry.first == hash && _equal(entry.second, value);
+      }
+      node = (node->nodemap & bit) ? node->children[index_of(node->nodemap, bit)] : nullptr;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Adds an element to a subtrie.
+   *
+   * A node is modified in place only if 'transient' is true and the node,
+   * like all the nodes above it, is referenced once: otherwise it may be
+   * reachable from another version, and it is copied.
+   *
+   * @param node The root of the subtrie, not nullptr.
+   * @param hash The hash value of the element.
+   * @param shift The bits of the hash value consumed above 'node'.
+   * @param value The element.
+   * @param transient true if the nodes above 'node' have been modified in
+   * place.
+   * @param changed Set to true if the element has been added.
+   *
+   * @return 'node' if it has been modified in place or not at all, otherwise
+   * the new copy, referenced once, that replaces it.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  Node* insert(Node* node, size_t hash, size_t shift, const T& value, bool transient, bool& changed) {
+    bool owned = transient && node->refs.load(std::memory_order_acquire) == 1;
+
+    if (is_collision(shift)) {
+      for (size_t i = 0; i < node->entries.size(); ++i) {
+        if (_equal(node->entries[i].second, value)) return node;
+      }
+      Node* edit = owned ? node : new Node(*node);
+      try {
+        edit->entries.push_back(entry_type(hash, value));
+      } catch (...) {
+        if (edit != node) release(edit);
+        throw;
+      }
+      changed = true;
+      return edit;
+    }
+
+    std::uint32_t bit = 1u << ((hash >> shift) & MASK);
+    if (node->datamap & bit) {
+      size_t i = index_of(node->datamap, bit);
+      if (node->entries[i].first == hash && _equal(node->entries[i].second, value)) return node;
+
+      // Push both elements one level down
+      Node* child = pair_node(node->entries[i], entry_type(hash, value), shift + BITS);
+      Node* edit = nullptr;
+      try {
+        edit = owned ? node : new Node(*node);
+        edit->children.insert(edit->children.begin() + index_of(edit->nodemap, bit), child);
+      } catch (...) {
+        release(child);
+        if (edit != node) release(edit);
+        throw;
+      }
+      edit->entries.erase(edit->entries.begin() + i);
+      edit->datamap ^= bit;
+      edit->nodemap |= bit;
+      changed = true;
+      return edit;
+    }
+
+    if (node->nodemap & bit) {
+      size_t i = index_of(node->nodemap, bit);
+      Node* child = node->children[i];
+      Node* new_child = insert(child, hash, shift + BITS, value, owned, changed);
+      if (new_child == child) return node;
+
+      Node* edit = nullptr;
+      try {
+        edit = owned ? node : new Node(*node);
+      } catch (...) {
+        release(new_child);
+        throw;
+      }
+      release(child);
+      edit->children[i] = new_child;
+      return edit;
+    }
+
+    Node* edit = owned ? node : new Node(*node);
+    try {
+      edit->entries.insert(edit->entries.begin() + index_of(edit->datamap, bit), entry_type(hash, value));
+    } catch (...) {
+      if (edit != node) release(edit);
+      throw;
+    }
+    edit->datamap |= bit;
+    changed = true;
+    return edit;
+  }
+
+  /**
+   * @brief Removes an element from a subtrie.
+   *
+   * A child left with a single element and no children is replaced by its
+   * element, so that the trie does not get deeper than needed.
+   *
+   * @param node The root of the subtrie, not nullptr.
+   * @param hash The hash value of the element.
+   * @param shift The bits of the hash value consumed above 'node'.
+   * @param value The element.
+   * @param transient true if the nodes above 'node' have been modified in
+   * place.
+   * @param changed Set to true if the element has been removed.
+   *
+   * @return As insert(): 'node' if it has been modified in place or not at
+   * all, otherwise the new copy that replaces it.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  Node* erase(Node* node, size_t hash, size_t shift, const T& value, bool transient, bool& changed) {
+    bool owned = transient && node->refs.load(std::memory_order_acquire) == 1;
+
+    if (is_collision(shift)) {
+      for (size_t i = 0; i < node->entries.size(); ++i) {
+        if (_equal(node->entries[i].second, value)) {
+          Node* edit = owned ? node : new Node(*node);
+          edit->entries.erase(edit->entries.begin() + i);
+          changed = true;
+          return edit;
+        }
+      }
+      return node;
+    }
+
+    std::uint32_t bit = 1u << ((hash >> shift) & MASK);
+    if (node->datamap & bit) {
+      size_t i = index_of(node->datamap, bit);
+      if (node->entries[i].first != hash || !_equal(node->entries[i].second, value)) return node;
+
+      Node* edit = owned ? node : new Node(*node);
+      edit->entries.erase(edit->entries.begin() + i);
+      edit->datamap ^= bit;
+      changed = true;
+      return edit;
+    }
+
+    if ((node->nodemap & bit) == 0) return node;
+
+    size_t i = index_of(node->nodemap, bit);
+    Node* child = node->children[i];
+    Node* new_child = erase(child, hash, shift + BITS, value, owned, changed);
+    if (!changed) return node;
+
+    bool single = new_child->children.empty() && new_child->entries.size() == 1;
+    if (new_child == child && !single) return node;
+
+    // A child modified in place implies 'owned': no allocation here then
+    Node* edit = nullptr;
+    try {
+      edit = owned ? node : new Node(*node);
+    } catch (...) {
+      if (new_child != child) release(new_child);
+      throw;
+    }
+
+    if (single) {
+      bool reserved = true;
+      try {
+        edit->entries.reserve(edit->entries.size() + 1);
+      } catch (...) {
+        reserved = false; // Keep the child: a node with a single element is valid too
+      }
+      if (reserved) {
+        edit->entries.insert(edit->entries.begin() + index_of(edit->datamap, bit), new_child->entries[0]);
+        edit->children.erase(edit->children.begin() + i);
+        edit->nodemap ^= bit;
+        edit->datamap |= bit;
+        if (new_child != child) release(new_child);
+        release(child);
+        return edit;
+      }
+    }
+    if (new_child != child) {
+      release(child);
+      edit->children[i] = new_child;
+    }
+    return edit;
+  }
+
+  /**
+   * @brief Adds an element to this PersistentSet, copying the shared nodes.
+   *
+   * @param value The element.
+   * @param transient true to modify in place the nodes referenced once (see
+   * Builder), false to copy every node on the path.
+   *
+   * @return true if the element has been added.
+  */
+  bool insert_value(const T& value, bool transient) {
+    size_t hash = _hash(value);
+    if (_root == nullptr) {
+      Node* root = new Node;
+      try {
+        root->entries.push_back(entry_type(hash, value));
+      } catch (...) {
+        release(root);
+        throw;
+      }
+      root->datamap = 1u << (hash & MASK);
+      _root = root;
+      _num_elements = 1;
+      return true;
+    }
+
+    bool changed = false;
+    Node* root = insert(_root, hash, 0, value, transient, changed);
+    if (root != _root) {
+      release(_root);
+      _root = root;
+    }
+    if (changed) ++_num_elements;
+    return changed;
+  }
+
+  /**
+   * @brief Removes an element from this PersistentSet, copying the shared
+   * nodes.
+   *
+   * @param value The element.
+   * @param transient As insert_value().
+   *
+   * @return true if the element has been removed.
+  */
+  bool erase_value(const T& value, bool transient) {
+    if (_root == nullptr) return false;
+
+    bool changed = false;
+    Node* root = erase(_root, _hash(value), 0, value, transient, changed);
+    if (root != _root) {
+      release(_root);
+      _root = root;
+    }
+    if (!changed) return false;
+    if (--_num_elements == 0) {
+      release(_root);
+      _root = nullptr;
+    }
+    return true;
+  }
+
+public:
+  class Builder;
+
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty PersistentSet. No memory is allocated.
+  */
+  PersistentSet() : _root(nullptr), _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Shares the trie of 'other', in O(1).
+   *
+   * @param other PersistentSet to be copied.
+  */
+  PersistentSet(const PersistentSet& other)
+    : _root(other._root), _num_elements(other._num_elements), _equal(other._equal), _hash(other._hash) {
+    retain(_root);
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other PersistentSet from which to take the trie.
+   *
+   * @post other is empty.
+  */
+  PersistentSet(PersistentSet&& other) noexcept
+    : _root(other._root), _num_elements(other._num_elements), _equal(other._equal), _hash(other._hash) {
+    other._root = nullptr;
+    other._num_elements = 0;
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * Shares the trie of 'other', in O(1).
+   *
+   * @param other The PersistentSet to assign from.
+   *
+   * @return A reference to this PersistentSet after the assignment.
+  */
+  PersistentSet& operator=(PersistentSet other) {
+    swap(other);
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   *
+   * Deletes the nodes that no other version shares.
+  */
+  ~PersistentSet() {
+    release(_root);
+  }
+
+  /**
+   * @brief Conversion constructor from a Set.
+   *
+   * @param set The Set whose elements are copied.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  template <typename Policy, typename Allocator>
+  explicit PersistentSet(const Set<T, Equal, Policy, Allocator>& set) : _root(nullptr), _num_elements(0) {
+    try {
+      for (typename Set<T, Equal, Policy, Allocator>::const_iterator it = set.begin(); it != set.end(); ++it) {
+        insert_value(*it, true);
+      }
+    } catch (const std::exception& e) {
+      release(_root);
+      std::cerr << "Exception caught in PersistentSet: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Constructor that creates a PersistentSet from a range defined by
+   * two iterators.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  template <typename IteratorQ>
+  PersistentSet(IteratorQ begin, IteratorQ end) : _root(nullptr), _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        insert_value(*it, true);
+      }
+    } catch (const std::exception& e) {
+      release(_root);
+      std::cerr << "Exception caught in PersistentSet: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The PersistentSet to swap states with the current instance.
+  */
+  void swap(PersistentSet& other) {
+    std::swap(_root, other._root);
+    std::swap(_num_elements, other._num_elements);
+    std::swap(_equal, other._equal);
+    std::swap(_hash, other._hash);
+  }
+
+  /**
+   * @brief Returns a version with an element added.
+   *
+   * Copies the O(log32 n) nodes on the path to the element and shares the
+   * other ones with this version, which is unchanged.
+   *
+   * @param value The element of type T to be added.
+   *
+   * @return The new version, or a copy of this one if the element is already
+   * contained.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  PersistentSet add(const T& value) const {
+    PersistentSet version(*this);
+    version.insert_value(value, false);
+    return version;
+  }
+
+  /**
+   * @brief Returns a version with an element removed.
+   *
+   * @param value The element of type T to be removed.
+   *
+   * @return The new version, or a copy of this one if the element is not
+   * contained.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  PersistentSet remove(const T& value) const {
+    PersistentSet version(*this);
+    version.erase_value(value, false);
+    return version;
+  }
+
+  /**
+   * @brief Checks if the PersistentSet contains a specific element.
+   *
+   * @param value The element to search for.
+   *
+   * @return true if the element is found, false otherwise.
+  */
+  bool contains(const T& value) const {
+    return find(_hash(value), value);
+  }
+
+  /**
+   * @brief Returns the number of elements, in O(1).
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Tells if two PersistentSets are copies of the same version.
+   *
+   * @param other The other PersistentSet.
+   *
+   * @return true if the PersistentSets share their whole trie.
+  */
+  bool shares(const PersistentSet& other) const {
+    return _root == other._root;
+  }
+
+  /**
+   * @brief Copies the elements into a plain Set.
+   *
+   * @return A Set with the elements, in the order of iteration.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  Set<T, Equal> to_set() const {
+    return Set<T, Equal>::from_unique_range(begin(), end());
+  }
+
+  /**
+   * @brief Transient companion of PersistentSet, for batches of changes.
+   *
+   * A Builder starts empty or from a PersistentSet, sharing its trie, and is
+   * modified in place: the nodes still shared with some PersistentSet are
+   * copied once, on the first change below them, and then modified in place
+   * like the nodes it creates. persistent() returns the elements as a
+   * PersistentSet in O(1), sharing the trie again, so the Builder can keep
+   * changing afterwards without affecting it.
+   *
+   * A Builder must not be used by several threads at the same time.
+  */
+  class Builder {
+  public:
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes a new, empty Builder.
+    */
+    Builder() {}
+
+    /**
+     * @brief Starts from the elements of a PersistentSet, sharing its trie.
+     *
+     * @param set The PersistentSet, which is never modified.
+    */
+    explicit Builder(const PersistentSet& set) : _set(set) {}
+
+    /**
+     * @brief Adds an element.
+     *
+     * @param value The element of type T to be added.
+     *
+     * @return true if the element was added, false if it is already contained.
+     *
+     * @throw Allocation exception, or any exception thrown by the constructor
+     * of T.
+    */
+    bool add(const T& value) {
+      return _set.insert_value(value, true);
+    }
+
+    /**
+     * @brief Removes an element.
+     *
+     * @param value The element of type T to be removed.
+     *
+     * @return true if the element was removed, false if it is not contained.
+     *
+     * @throw Allocation exception, or any exception thrown by the constructor
+     * of T.
+    */
+    bool remove(const T& value) {
+      return _set.erase_value(value, true);
+    }
+
+    /**
+     * @brief Checks if the Builder contains a specific element.
+     *
+     * @param value The element to search for.
+     *
+     * @return true if the element is found, false otherwise.
+    */
+    bool contains(const T& value) const {
+      return _set.contains(value);
+    }
+
+    /**
+     * @brief Returns the number of elements.
+    */
+    size_t getNumElements() const {
+      return _set.getNumElements();
+    }
+
+    /**
+     * @brief Returns the elements as a PersistentSet, in O(1).
+    */
+    PersistentSet persistent() const {
+      return _set;
+    }
+
+  private:
+    PersistentSet _set; ///< Current elements, with nodes possibly not shared
+
+    Builder(const Builder&); // not copyable: see persistent()
+    Builder& operator=(const Builder&);
+  };
+
+  /**
+   * @brief Constant forward iterator for the PersistentSet class.
+   *
+   * Visits the elements of a node before the ones of its children. It stays
+   * valid as long as the version it iterates, or a copy of it, is alive.
+  */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef const T* pointer; ///< Pointer to the constant element type
+    typedef const T& reference; ///< Reference to the constant element type
+
+    /**
+     * @brief Default constructor, the end iterator.
+    */
+    const_iterator() : _current(nullptr) {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return A constant reference to the element pointed to by the iterator.
+    */
+    reference operator*() const {
+      return *_current;
+    }
+
+    /**
+     * @brief Member access operator.
+     *
+     * @return A constant pointer to the element pointed to by the iterator.
+    */
+    pointer operator->() const {
+      return _current;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return A copy of the iterator before it was incremented.
+    */
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      advance();
+      return tmp;
+    }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return A reference to the incremented iterator.
+    */
+    const_iterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    /**
+     * @brief Equality operator.
+     *
+     * @param other The iterator to compare with.
+     *
+     * @return true if both iterators point to the same element.
+    */
+    bool operator==(const const_iterator& other) const {
+      return _current == other._current;
+    }
+
+    /**
+     * @brief Inequality operator.
+     *
+     * @param other The iterator to compare with.
+     *
+     * @return true if the iterators point to different elements.
+    */
+    bool operator!=(const const_iterator& other) const {
+      return _current != other._current;
+    }
+
+  private:
+    std::vector<std::pair<const Node*, size_t> > _path; ///< Nodes being visited, and their next entry or child
+    const T* _current; ///< Current element, nullptr at the end
+
+    friend class PersistentSet; ///< Allow PersistentSet class to access private constructor.
+
+    /**
+     * @brief Private constructor, used by begin().
+     *
+     * @param root The root of the trie, or nullptr.
+    */
+    explicit const_iterator(const Node* root) : _current(nullptr) {
+      if (root != nullptr) {
+        _path.push_back(std::make_pair(root, static_cast<size_t>(0)));
+        advance();
+      }
+    }
+
+    /**
+     * @brief Moves to the next entry of the deepest node being visited,
+     * descending into its children after its entries.
+    */
+    void advance() {
+      while (!_path.empty()) {
+        const Node* node = _path.back().first;
+        size_t next = _path.back().second++;
+        if (next < node->entries.size()) {
+          _current = &node->entries[next].second;
+          return;
+        }
+        next -= node->entries.size();
+        if (next < node->children.size()) {
+          _path.push_back(std::make_pair(static_cast<const Node*>(node->children[next]), static_cast<size_t>(0)));
+        } else {
+          _path.pop_back();
+        }
+      }
+      _current = nullptr;
+    }
+  };
+
+  /**
+   * @brief Returns an iterator to the first element.
+  */
+  const_iterator begin() const {
+    return const_iterator(_root);
+  }
+
+  /**
+   * @brief Returns an iterator past the last element.
+  */
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  /**
+   * @brief Stream operator for the PersistentSet class.
+   *
+   * The output format is the one of Set: the number of elements followed by
+   * each element between round brackets, in the order of iteration.
+   *
+   * @param os The output stream to which the PersistentSet data will be sent.
+   * @param set The PersistentSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the PersistentSet
+   * data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const PersistentSet& set) {
+    os << set._num_elements;
+    for (const_iterator it = set.begin(); it != set.end(); ++it) {
+      os << " (" << *it << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for PersistentSet.
+   *
+   * Copies of the same version are equal in O(1); otherwise the elements of
+   * 'other' are searched in this PersistentSet.
+   *
+   * @param other The PersistentSet to compare with.
+   *
+   * @return True if the PersistentSets contain the same elements, false
+   * otherwise.
+  */
+  bool operator==(const PersistentSet& other) const {
+    if (_num_elements != other._num_elements) return false;
+    if (_root == other._root) return true;
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+      if (!contains(*it)) return false;
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a PersistentSet based on a predicate.
+ *
+ * The elements failing the predicate are removed from a Builder sharing the
+ * trie of S, so the nodes left untouched stay shared with S.
+ *
+ * @tparam Predicate A functor or function that takes an element of type T and
+ *         returns a boolean.
+ *
+ * @param S The original PersistentSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new PersistentSet.
+ *
+ * @return A new PersistentSet containing the elements that satisfy the
+ * predicate P.
+*/
+template <typename T, typename Equal, typename Hash, typename Predicate>
+PersistentSet<T, Equal, Hash> filter_out(const PersistentSet<T, Equal, Hash>& S, Predicate P) {
+  typename PersistentSet<T, Equal, Hash>::Builder builder(S);
+  for (typename PersistentSet<T, Equal, Hash>::const_iterator it = S.begin(); it != S.end(); ++it) {
+    if (!P(*it)) builder.remove(*it);
+  }
+  return builder.persistent();
+}
+
+/**
+ * @brief Computes the union of two PersistentSets.
+ *
+ * The elements of the smaller PersistentSet are added to a Builder sharing
+ * the trie of the larger one.
+ *
+ * @param a The first PersistentSet.
+ * @param b The second PersistentSet.
+ *
+ * @return A new PersistentSet containing the elements of both a and b.
+*/
+template <typename T, typename Equal, typename Hash>
+PersistentSet<T, Equal, Hash> operator+(const PersistentSet<T, Equal, Hash>& a, const PersistentSet<T, Equal, Hash>& b) {
+  const PersistentSet<T, Equal, Hash>& large = a.getNumElements() < b.getNumElements() ? b : a;
+  const PersistentSet<T, Equal, Hash>& small = a.getNumElements() < b.getNumElements() ? a : b;
+  typename PersistentSet<T, Equal, Hash>::Builder builder(large);
+  for (typename PersistentSet<T, Equal, Hash>::const_iterator it = small.begin(); it != small.end(); ++it) {
+    builder.add(*it);
+  }
+  return builder.persistent();
+}
+
+/**
+ * @brief Computes the intersection of two PersistentSets.
+ *
+ * The elements of the smaller PersistentSet are searched in the larger one.
+ *
+ * @param a The first PersistentSet.
+ * @param b The second PersistentSet.
+ *
+ * @return A new PersistentSet containing the elements of both a and b.
+*/
+template <typename T, typename Equal, typename Hash>
+PersistentSet<T, Equal, Hash> intersection(const PersistentSet<T, Equal, Hash>& a,
+                                           const PersistentSet<T, Equal, Hash>& b) {
+  const PersistentSet<T, Equal, Hash>& large = a.getNumElements() < b.getNumElements() ? b : a;
+  const PersistentSet<T, Equal, Hash>& small = a.getNumElements() < b.getNumElements() ? a : b;
+  typename PersistentSet<T, Equal, Hash>::Builder builder;
+  for (typename PersistentSet<T, Equal, Hash>::const_iterator it = small.begin(); it != small.end(); ++it) {
+    if (large.contains(*it)) builder.add(*it);
+  }
+  return builder.persistent();
+}
+
+/**
+ * @brief Computes the intersection of two PersistentSets.
+ *
+ * Same as intersection(), as operator- of Set.
+*/
+template <typename T, typename Equal, typename Hash>
+PersistentSet<T, Equal, Hash> operator-(const PersistentSet<T, Equal, Hash>& a, const PersistentSet<T, Equal, Hash>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two PersistentSets.
+ *
+ * The elements of b are removed from a Builder sharing the trie of a.
+ *
+ * @param a The PersistentSet whose elements are kept.
+ * @param b The PersistentSet whose elements are removed.
+ *
+ * @return A new PersistentSet containing a \ b.
+*/
+template <typename T, typename Equal, typename Hash>
+PersistentSet<T, Equal, Hash> difference(const PersistentSet<T, Equal, Hash>& a,
+                                         const PersistentSet<T, Equal, Hash>& b) {
+  typename PersistentSet<T, Equal, Hash>::Builder builder(a);
+  for (typename PersistentSet<T, Equal, Hash>::const_iterator it = b.begin(); it != b.end(); ++it) {
+    builder.remove(*it);
+  }
+  return builder.persistent();
+}
+
+/**
+ * @brief Computes the symmetric difference of two PersistentSets.
+ *
+ * Each element of b is removed from a Builder sharing the trie of a, or added
+ * to it if it is not contained.
+ *
+ * @param a The first PersistentSet.
+ * @param b The second PersistentSet.
+ *
+ * @return A new PersistentSet containing the elements of exactly one of a
+ * and b.
+*/
+template <typename T, typename Equal, typename Hash>
+PersistentSet<T, Equal, Hash> symmetric_difference(const PersistentSet<T, Equal, Hash>& a,
+                                                   const PersistentSet<T, Equal, Hash>& b) {
+  typename PersistentSet<T, Equal, Hash>::Builder builder(a);
+  for (typename PersistentSet<T, Equal, Hash>::const_iterator it = b.begin(); it != b.end(); ++it) {
+    if (!builder.remove(*it)) builder.add(*it);
+  }
+  return builder.persistent();
+}
+
+/**
+ * @brief Saves a PersistentSet of strings to a file.
+ *
+ * The file has the format of save() for Set.
+ *
+ * @param set The PersistentSet to be saved.
+ * @param filename The name of the file.
+*/
+template <typename Equal, typename Hash>
+void save(const PersistentSet<std::string, Equal, Hash>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+#endif // PERSISTENT_SET_HPP
@@ -0,0 +1,311 @@
+/**
+ * @file raw_storage.hpp
+ *
+ * @brief Header file for the raw storage helpers used by the Sets.
+ *
+ * Declaration/Definition of the functions managing uninitialized storage for
+ * the arrays of the Sets. Only the slots holding an element contain a live
+ * object: the remaining capacity is raw memory, so T does not need to be
+ * default constructible and no work is spent constructing unused slots.
+ *
+ * Every helper takes the allocator of the container, and goes through
+ * std::allocator_traits so that stateful allocators (such as
+ * std::pmr::polymorphic_allocator) are honored, including their construct().
+ * The overloads without an allocator use ReallocAllocator.
+*/
+
+#ifndef RAW_STORAGE_HPP
+#define RAW_STORAGE_HPP
+
+#include <cstdlib> // std::malloc, std::realloc, std::free
+#include <cstddef> // size_t, std::max_align_t
+#include <new> // std::bad_alloc
+#include <memory> // std::allocator_traits
+#include <type_traits> // std::is_trivially_copyable, std::is_same
+#include <utility> // std::move_if_noexcept, std::forward
+
+/**
+ * @brief Default allocator of the Sets.
+ *
+ * A stateless allocator based on std::malloc and std::free, that can also
+ * resize a block of trivially copyable elements in place with std::realloc.
+ *
+ * @tparam T Type of the elements.
+*/
+template <typename T>
+class ReallocAllocator {
+public:
+  typedef T value_type; ///< Type of the elements
+
+  /**
+   * @brief Default constructor.
+  */
+  ReallocAllocator() {}
+
+  /**
+   * @brief Converting constructor, from an allocator of another type.
+  */
+  template <typename U>
+  ReallocAllocator(const ReallocAllocator<U>&) {}
+
+  /**
+   * @brief Allocates uninitialized storage for n elements.
+   *
+   * @param n Number of elements.
+   *
+   * @return Pointer to the storage.
+   *
+   * @throw std::bad_alloc If the storage cannot be allocated.
+  */
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+    void* p = std::malloc(n * sizeof(T));
+    if (p == nullptr) throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+
+  /**
+   * @brief Deallocates storage obtained by allocate() or reallocate().
+   *
+   * @param p Pointer to the storage.
+   * @param n Number of elements of the storage (unused).
+  */
+  void deallocate(T* p, size_t n) {
+    (void)n;
+    std::free(p);
+  }
+
+  /**
+   * @brief Changes the size of a block of trivially copyable elements.
+   *
+   * The elements are moved bitwise, possibly without copying them at all if
+   * the block can grow in place.
+   *
+   * @param p Pointer to the storage.
+   * @param n New number of elements of the storage, greater than 0.
+   *
+   * @return Pointer to the new storage.
+   *
+   * @throw std::bad_alloc If the storage cannot be resized. The old storage is
+   * unchanged in that case.
+  */
+  T* reallocate(T* p, size_t n) {
+    void* q = std::realloc(p, n * sizeof(T));
+    if (q == nullptr) throw std::bad_alloc();
+    return static_cast<T*>(q);
+  }
+
+  /**
+   * @brief Every ReallocAllocator can deallocate the storage of the others.
+  */
+  template <typename U>
+  bool operator==(const ReallocAllocator<U>&) const { return true; }
+
+  /**
+   * @brief Every ReallocAllocator can deallocate the storage of the others.
+  */
+  template <typename U>
+  bool operator!=(const ReallocAllocator<U>&) const { return false; }
+};
+
+namespace detail {
+
+/**
+ * @brief Allocates uninitialized storage for n elements.
+ *
+ * @param alloc The allocator.
+ * @param n Number of elements.
+ *
+ * @return Pointer to the storage, nullptr if n is 0.
+ *
+ * @throw Allocation exception.
+*/
+template <typename Alloc>
+typename Alloc::value_type* allocate(Alloc& alloc, size_t n) {
+  if (n == 0) return nullptr;
+  return std::allocator_traits<Alloc>::allocate(alloc, n);
+}
+
+/**
+ * @brief Deallocates storage obtained by allocate() or relocate().
+ *
+ * @param alloc The allocator.
+ * @param p Pointer to the storage. The elements must have been destroyed.
+ * @param n Capacity of the storage.
+*/
+template <typename Alloc>
+void deallocate(Alloc& alloc, typename Alloc::value_type* p, size_t n) {
+  if (p != nullptr) {
+    std::allocator_traits<Alloc>::deallocate(alloc, p, n);
+  }
+}
+
+/**
+ * @brief Constructs an element in uninitialized storage.
+ *
+ * @param alloc The allocator.
+ * @param p Pointer to the uninitialized slot.
+ * @param args Arguments forwarded to the constructor of the element.
+*/
+template <typename Alloc, typename... Args>
+void construct(Alloc& alloc, typename Alloc::value_type* p, Args&&... args) {
+  std::allocator_traits<Alloc>::construct(alloc, p, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Destroys the elements in a range, leaving the storage allocated.
+ *
+ * @param alloc The allocator.
+ * @param first Pointer to the first element.
+ * @param last Pointer to the element following the last one.
+*/
+template <typename Alloc>
+void destroy(Alloc& alloc, typename Alloc::value_type* first, typename Alloc::value_type* last) {
+  for (; first != last; ++first) {
+    std::allocator_traits<Alloc>::destroy(alloc, first);
+  }
+}
+
+/**
+ * @brief Copies a range of elements into uninitialized storage.
+ *
+ * @param alloc The allocator.
+ * @param first Pointer to the first element to copy.
+ * @param last Pointer to the element following the last one to copy.
+ * @param dest Pointer to the uninitialized storage.
+ *
+ * @throw Any exception thrown by the copy constructor of the elements. The
+ * elements already copied are destroyed in that case.
+*/
+template <typename Alloc>
+void copy_construct(Alloc& alloc, const typename Alloc::value_type* first,
+                    const typename Alloc::value_type* last, typename Alloc::value_type* dest) {
+  typename Alloc::value_type* next = dest;
+  try {
+    for (; first != last; ++first, ++next) {
+      detail::construct(alloc, next, *first);
+    }
+  } catch (...) {
+    detail::destroy(alloc, dest, next);
+    throw;
+  }
+}
+
+/**
+ * @brief relocate() of trivially copyable elements stored by a
+ * ReallocAllocator: std::realloc moves them bitwise.
+*/
+template <typename T>
+T* relocate_storage(ReallocAllocator<T>& alloc, T* old, size_t n, size_t old_capacity,
+                    size_t capacity, std::true_type) {
+  (void)n;
+  if (capacity == 0) {
+    detail::deallocate(alloc, old, old_capacity);
+    return nullptr;
+  }
+  return alloc.reallocate(old, capacity);
+}
+
+/**
+ * @brief relocate() of the other elements: they are moved (or copied) one at
+ * a time into a new storage.
+*/
+template <typename Alloc>
+typename Alloc::value_type* relocate_storage(Alloc& alloc, typename Alloc::value_type* old,
+                                             size_t n, size_t old_capacity, size_t capacity,
+                                             std::false_type) {
+  typename Alloc::value_type* storage = detail::allocate(alloc, capacity);
+  size_t i = 0;
+  try {
+    for (; i < n; ++i) {
+      detail::construct(alloc, storage + i, std::move_if_noexcept(old[i]));
+    }
+  } catch (...) {
+    detail::destroy(alloc, storage, storage + i);
+    detail::deallocate(alloc, storage, capacity);
+    throw;
+  }
+  detail::destroy(alloc, old, old + n);
+  detail::deallocate(alloc, old, old_capacity);
+  return storage;
+}
+
+/**
+ * @brief Moves the live elements of a storage into a storage of a new
+ * capacity.
+ *
+ * - Trivially copyable types stored by a ReallocAllocator are moved bitwise
+ *   by std::realloc, which may even grow the storage in place.
+ * - Types with a move constructor that does not throw (or that cannot be
+ *   copied) are move constructed into the new storage.
+ * - Other types are copy constructed, so that the old storage is untouched
+ *   if a copy throws (strong exception guarantee).
+ *
+ * @param alloc The allocator.
+ * @param old Pointer to the storage holding the elements.
+ * @param n Number of live elements.
+ * @param old_capacity Capacity of the storage holding the elements.
+ * @param capacity Capacity of the new storage, not lower than n.
+ *
+ * @return Pointer to the new storage. The old storage has been deallocated.
+ *
+ * @throw Allocation exception, or any exception thrown by the copy
+ * constructor of the elements. The old storage is unchanged in that case.
+*/
+template <typename Alloc>
+typename Alloc::value_type* relocate(Alloc& alloc, typename Alloc::value_type* old, size_t n,
+                                     size_t old_capacity, size_t capacity) {
+  typedef typename Alloc::value_type T;
+  return detail::relocate_storage(alloc, old, n, old_capacity, capacity,
+    std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                 std::is_same<Alloc, ReallocAllocator<T> >::value>());
+}
+
+/**
+ * @brief allocate() with a ReallocAllocator.
+*/
+template <typename T>
+T* allocate(size_t n) {
+  ReallocAllocator<T> alloc;
+  return detail::allocate(alloc, n);
+}
+
+/**
+ * @brief deallocate() with a ReallocAllocator.
+*/
+template <typename T>
+void deallocate(T* p, size_t n) {
+  ReallocAllocator<T> alloc;
+  detail::deallocate(alloc, p, n);
+}
+
+/**
+ * @brief destroy() with a ReallocAllocator.
+*/
+template <typename T>
+void destroy(T* first, T* last) {
+  ReallocAllocator<T> alloc;
+  detail::destroy(alloc, first, last);
+}
+
+/**
+ * @brief copy_construct() with a ReallocAllocator.
+*/
+template <typename T>
+void copy_construct(const T* first, const T* last, T* dest) {
+  ReallocAllocator<T> alloc;
+  detail::copy_construct(alloc, first, last, dest);
+}
+
+/**
+ * @brief relocate() with a ReallocAllocator.
+*/
+template <typename T>
+T* relocate(T* old, size_t n, size_t old_capacity, size_t capacity) {
+  ReallocAllocator<T> alloc;
+  return detail::relocate(alloc, old, n, old_capacity, capacity);
+}
+
+} // namespace detail
+
+#endif // RAW_STORAGE_HPP
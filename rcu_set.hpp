@@ -0,0 +1,430 @@
+/**
+ * @file rcu_set.hpp
+ *
+ * @brief Header file for the templated RcuSet class.
+ *
+ * Declaration/Definition of the templated RcuSet class, a read-mostly Set in
+ * the style of read-copy-update: readers look up an immutable version of the
+ * elements without ever blocking, writers publish whole new versions, and
+ * the old versions are freed by epoch based reclamation once no reader can
+ * hold them anymore.
+ *
+ * Link with -pthread.
+*/
+
+#ifndef RCU_SET_HPP
+#define RCU_SET_HPP
+
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex, std::lock_guard
+#include <memory> // std::unique_ptr
+#include <vector> // std::vector
+#include <utility> // std::move, std::pair
+#include <cstdint> // std::uint64_t
+#include <cstddef> // size_t
+#include "set.hpp"
+#include "hash_set.hpp"
+
+/**
+ * @brief RcuSet Class
+ *
+ * Set of type T elements for workloads with many concurrent lookups and rare
+ * updates. The elements live in an immutable version (a HashSet), reached
+ * through an atomic pointer:
+ * - a reader thread registers once, creating a Reader, then every lookup
+ *   announces the current epoch in the slot of the Reader, loads the pointer
+ *   and searches the version: a fixed number of steps, with no lock, so
+ *   readers are wait-free and never wait for a writer copying or resizing;
+ * - a writer copies the current version, applies its changes to the copy
+ *   (see update()) and publishes it with an atomic exchange. Writers are
+ *   serialized by a mutex, and should batch their changes: every publication
+ *   copies the whole version.
+ *
+ * A replaced version is retired with the epoch of its replacement, and freed
+ * by a later writer once every Reader is either outside any lookup or has
+ * announced a later epoch, i.e. once no Reader can still be searching it.
+ *
+ * @tparam T Type of the elements in the RcuSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam Hash Functor used for hashing an element. Two elements that are
+ * equal according to Equal must have the same hash value.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T> >
+class RcuSet {
+public:
+  typedef HashSet<T, Equal, Hash> version_type; ///< Type of the immutable versions
+
+private:
+  /**
+   * @brief The epoch announced by a Reader.
+  */
+  struct Slot {
+    std::atomic<std::uint64_t> epoch; ///< Epoch of the current lookup, 0 outside any lookup
+    bool in_use; ///< Owned by a Reader (guarded by _slot_lock)
+
+    Slot() : epoch(0), in_use(true) {}
+  };
+
+  std::atomic<const version_type*> _current; ///< Version seen by new lookups
+  std::atomic<std::uint64_t> _epoch; ///< Current epoch, starting from 1
+  std::mutex _write_lock; ///< Serializes the writers, guards _retired
+  std::vector<std::pair<const version_type*, std::uint64_t> > _retired; ///< Replaced versions and their epochs
+  mutable std::mutex _slot_lock; ///< Guards _slots
+  std::vector<std::unique_ptr<Slot> > _slots; ///< Slots of the Readers, never deallocated before the RcuSet
+
+  RcuSet(const RcuSet&); // not copyable: see to_set()
+  RcuSet& operator=(const RcuSet&);
+
+  /**
+   * @brief Publishes a new version, retires the replaced one and frees the
+   * versions no Reader can hold.
+   *
+   * @param next The new version, owned by the RcuSet once published.
+   *
+   * @throw Allocation exception. Nothing is published in that case.
+   *
+   * @pre _write_lock is held.
+  */
+  void publish_locked(std::unique_ptr<version_type>& next) {
+    _retired.reserve(_retired.size() + 1); // The push_back below cannot throw
+    const version_type* old = _current.exchange(next.release());
+    std::uint64_t epoch = _epoch.fetch_add(1);
+    _retired.push_back(std::make_pair(old, epoch));
+    reclaim_locked();
+  }
+
+  /**
+   * @brief Frees the retired versions that no Reader can hold.
+   *
+   * A Reader announces the epoch before loading the pointer to the version,
+   * so a Reader that found a version retired with epoch e has announced an
+   * epoch not greater than e.
+   *
+   * @pre _write_lock is held.
+  */
+  void reclaim_locked() {
+    std::uint64_t oldest = _epoch.load();
+    {
+      std::lock_guard<std::mutex> guard(_slot_lock);
+      for (size_t s = 0; s < _slots.size(); ++s) {
+        std::uint64_t epoch = _slots[s]->epoch.load();
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+      }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < _retired.size(); ++i) {
+      if (_retired[i].second < oldest) {
+        delete _retired[i].first;
+      } else {
+        _retired[kept++] = _retired[i];
+      }
+    }
+    _retired.resize(kept);
+  }
+
+public:
+  class Snapshot;
+
+  /**
+   * @brief Handle of a reader thread.
+   *
+   * Owns a slot of the RcuSet, in which it announces the epoch of its
+   * lookups. A Reader must be used by one thread at a time; creating one
+   * takes a lock, so a thread should keep its Reader for all its lookups.
+  */
+  class Reader {
+  public:
+    /**
+     * @brief Registers a reader of an RcuSet.
+     *
+     * @param set The RcuSet, which must outlive the Reader.
+     *
+     * @throw Allocation exception.
+    */
+    explicit Reader(RcuSet& set) : _set(set), _slot(nullptr), _depth(0) {
+      std::lock_guard<std::mutex> guard(set._slot_lock);
+      for (size_t s = 0; s < set._slots.size() && _slot == nullptr; ++s) {
+        if (!set._slots[s]->in_use) {
+          _slot = set._slots[s].get();
+          _slot->in_use = true;
+        }
+      }
+      if (_slot == nullptr) {
+        set._slots.push_back(std::unique_ptr<Slot>(new Slot));
+        _slot = set._slots.back().get();
+      }
+    }
+
+    /**
+     * @brief Destructor.
+     *
+     * Gives the slot back to the RcuSet, for the next Reader.
+     *
+     * @pre No Snapshot of this Reader is alive.
+    */
+    ~Reader() {
+      std::lock_guard<std::mutex> guard(_set._slot_lock);
+      _slot->epoch.store(0);
+      _slot->in_use = false;
+    }
+
+    /**
+     * @brief Checks if the current version contains a specific element.
+     *
+     * Wait-free.
+     *
+     * @param value The element to search for.
+     *
+     * @return true if the element is found in the current version.
+    */
+    bool contains(const T& value) {
+      const version_type* version = enter();
+      bool found = version->contains(value);
+      exit();
+      return found;
+    }
+
+    /**
+     * @brief Returns the number of elements of the current version.
+     *
+     * Wait-free.
+    */
+    size_t getNumElements() {
+      const version_type* version = enter();
+      size_t n = version->getNumElements();
+      exit();
+      return n;
+    }
+
+  private:
+    RcuSet& _set; ///< RcuSet being read
+    Slot* _slot; ///< Slot owned by this Reader
+    size_t _depth; ///< Number of nested lookups and Snapshots
+
+    friend class Snapshot; ///< Allow Snapshot to pin versions.
+
+    Reader(const Reader&); // not copyable: a slot has one owner
+    Reader& operator=(const Reader&);
+
+    /**
+     * @brief Announces the current epoch, unless already inside a lookup,
+     * and loads the current version.
+     *
+     * @return The current version, which cannot be freed before exit().
+    */
+    const version_type* enter() {
+      if (_depth++ == 0) {
+        _slot->epoch.store(_set._epoch.load());
+      }
+      return _set._current.load();
+    }
+
+    /**
+     * @brief Leaves a lookup.
+    */
+    void exit() {
+      if (--_depth == 0) {
+        _slot->epoch.store(0);
+      }
+    }
+  };
+
+  /**
+   * @brief A version pinned by a Reader.
+   *
+   * The version cannot be freed while the Snapshot is alive, so it can be
+   * searched and iterated freely, without ever seeing the changes published
+   * later (Reader::contains() still searches the current version). Long
+   * lived Snapshots delay the reclamation of every version retired meanwhile.
+  */
+  class Snapshot {
+  public:
+    /**
+     * @brief Pins the current version.
+     *
+     * @param reader The Reader of the calling thread.
+    */
+    explicit Snapshot(Reader& reader) : _reader(reader), _version(reader.enter()) {}
+
+    /**
+     * @brief Destructor.
+     *
+     * Releases the version.
+    */
+    ~Snapshot() {
+      _reader.exit();
+    }
+
+    /**
+     * @brief Accesses the pinned version.
+    */
+    const version_type& operator*() const {
+      return *_version;
+    }
+
+    /**
+     * @brief Accesses the members of the pinned version.
+    */
+    const version_type* operator->() const {
+      return _version;
+    }
+
+  private:
+    Reader& _reader; ///< Reader pinning the version
+    const version_type* _version; ///< Pinned version
+
+    Snapshot(const Snapshot&); // not copyable: pins exactly once
+    Snapshot& operator=(const Snapshot&);
+  };
+
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new RcuSet, whose current version is empty.
+   *
+   * @throw Allocation exception.
+  */
+  RcuSet() : _current(new version_type), _epoch(1) {}
+
+  /**
+   * @brief Conversion constructor from a Set.
+   *
+   * @param set The Set whose elements form the first version.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  template <typename Policy, typename Allocator>
+  explicit RcuSet(const Set<T, Equal, Policy, Allocator>& set)
+    : _current(new version_type(set.begin(), set.end())), _epoch(1) {}
+
+  /**
+   * @brief Destructor.
+   *
+   * Frees the current version and the retired ones.
+   *
+   * @pre No Reader of this RcuSet is alive.
+  */
+  ~RcuSet() {
+    delete _current.load();
+    for (size_t i = 0; i < _retired.size(); ++i) {
+      delete _retired[i].first;
+    }
+  }
+
+  /**
+   * @brief Publishes a new version built from the current one.
+   *
+   * The current version is copied, 'f' is applied to the copy, then the copy
+   * becomes the current version. The lookups started before keep searching
+   * the previous version.
+   *
+   * @param f Functor called as f(version_type&) with the copy. It may add and
+   * remove any number of elements.
+   *
+   * @throw Allocation exception, or any exception thrown by 'f'. Nothing is
+   * published in that case.
+  */
+  template <typename Function>
+  void update(Function f) {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    std::unique_ptr<version_type> next(new version_type(*_current.load()));
+    f(*next);
+    publish_locked(next);
+  }
+
+  /**
+   * @brief Publishes a new version, replacing all the elements.
+   *
+   * @param elements The elements of the new version, moved into it.
+   *
+   * @throw Allocation exception. Nothing is published in that case.
+  */
+  void publish(version_type&& elements) {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    std::unique_ptr<version_type> next(new version_type(std::move(elements)));
+    publish_locked(next);
+  }
+
+  /**
+   * @brief Adds an element, publishing a new version if it is not contained.
+   *
+   * Copies the whole version: use update() to add many elements at once.
+   *
+   * @param value The element of type T to be added.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @throw Allocation exception. Nothing is published in that case.
+  */
+  bool add(const T& value) {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    if (_current.load()->contains(value)) return false;
+
+    std::unique_ptr<version_type> next(new version_type(*_current.load()));
+    next->add(value);
+    publish_locked(next);
+    return true;
+  }
+
+  /**
+   * @brief Removes an element, publishing a new version if it is contained.
+   *
+   * Copies the whole version: use update() to remove many elements at once.
+   *
+   * @param value The element of type T to be removed.
+   *
+   * @return true if the element was removed, false if it is not contained.
+   *
+   * @throw Allocation exception. Nothing is published in that case.
+  */
+  bool remove(const T& value) {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    if (!_current.load()->contains(value)) return false;
+
+    std::unique_ptr<version_type> next(new version_type(*_current.load()));
+    next->remove(value);
+    publish_locked(next);
+    return true;
+  }
+
+  /**
+   * @brief Frees the retired versions that no Reader can hold anymore.
+   *
+   * Every publication does it already: this is only useful to release the
+   * memory of the last versions once the readers have moved on.
+  */
+  void reclaim() {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    reclaim_locked();
+  }
+
+  /**
+   * @brief Returns the number of retired versions not freed yet.
+  */
+  size_t retired() {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    return _retired.size();
+  }
+
+  /**
+   * @brief Copies the current version into a plain Set.
+   *
+   * Takes the lock of the writers: meant for the writers themselves, readers
+   * should use a Snapshot.
+   *
+   * @return A Set with the elements of the current version.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  Set<T, Equal> to_set() {
+    std::lock_guard<std::mutex> guard(_write_lock);
+    const version_type& version = *_current.load();
+    return Set<T, Equal>::from_unique_range(version.begin(), version.end());
+  }
+};
+
+#endif // RCU_SET_HPP
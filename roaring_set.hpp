@@ -0,0 +1,1347 @@
+/**
+ * @file roaring_set.hpp
+ *
+ * @brief Header file for the templated RoaringSet class.
+ *
+ * Declaration/Definition of the templated RoaringSet class, a compressed
+ * sibling of Set for 32 bit integers, and of its containers.
+*/
+
+#ifndef ROARING_SET_HPP
+#define ROARING_SET_HPP
+
+#include <iostream>
+#include <algorithm> // std::lower_bound, std::set_union, std::set_intersection, ...
+#include <ostream> // std::ostream
+#include <stdexcept> // std::out_of_range
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <cstdint> // std::uint16_t, std::uint32_t, std::uint64_t
+#include <fstream> // std::ofstream, std::ifstream
+#include <string> // std::string
+#include <type_traits> // std::is_integral
+#include <utility> // std::move, std::swap
+#include <vector> // std::vector
+#include "bit_set.hpp" // detail::popcount64, detail::ctz64
+
+namespace detail {
+
+/**
+ * @brief Container of the values of a RoaringSet sharing their 16 high bits.
+ *
+ * The 16 low bits of the values are stored in one of three forms:
+ * - ARRAY: sorted array of values, for up to ARRAY_MAX values;
+ * - BITMAP: 65536 bits, for more than ARRAY_MAX values;
+ * - RUN: sorted array of runs of consecutive values, each stored as its
+ *   start and its length minus one. Only built by optimize(), when smaller
+ *   than the other forms; modifying a RUN container converts it back.
+ * An ARRAY never holds more than ARRAY_MAX values and a BITMAP never holds
+ * ARRAY_MAX values or less, so two containers of one of these forms holding
+ * the same values are identical.
+*/
+struct RoaringContainer {
+  enum Kind { ARRAY, BITMAP, RUN }; ///< Forms of the container
+
+  enum {
+    ARRAY_MAX = 4096, ///< Largest ARRAY: 8 KB, like a BITMAP
+    BITMAP_WORDS = 1024 ///< Words of a BITMAP
+  };
+
+  Kind kind; ///< Form of the container
+  std::uint32_t cardinality; ///< Number of values, from 1 to 65536 in a RoaringSet
+  std::vector<std::uint16_t> values; ///< ARRAY values, or RUN starts and lengths minus one
+  std::vector<std::uint64_t> bits; ///< BITMAP words
+
+  /**
+   * @brief Default constructor: empty ARRAY.
+  */
+  RoaringContainer() : kind(ARRAY), cardinality(0) {}
+
+  /**
+   * @brief Calls a function on every value, in ascending order.
+  */
+  template <typename Function>
+  void for_each(Function f) const {
+    if (kind == ARRAY) {
+      for (size_t i = 0; i < values.size(); ++i) {
+        f(values[i]);
+      }
+    } else if (kind == BITMAP) {
+      for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        for (std::uint64_t word = bits[w]; word != 0; word &= word - 1) {
+          f(static_cast<std::uint16_t>(w * 64 + detail::ctz64(word)));
+        }
+      }
+    } else {
+      for (size_t r = 0; r < values.size(); r += 2) {
+        for (std::uint32_t v = values[r]; v <= static_cast<std::uint32_t>(values[r] + values[r + 1]); ++v) {
+          f(static_cast<std::uint16_t>(v));
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Converts the container to an ARRAY.
+   *
+   * @throw Allocation exception. The container is unchanged in that case.
+  */
+  void to_array() {
+    std::vector<std::uint16_t> out;
+    out.reserve(cardinality);
+    for_each([&](std::uint16_t v) { out.push_back(v); });
+    values.swap(out);
+    std::vector<std::uint64_t>().swap(bits);
+    kind = ARRAY;
+  }
+
+  /**
+   * @brief Converts the container to a BITMAP.
+   *
+   * @throw Allocation exception. The container is unchanged in that case.
+  */
+  void to_bitmap() {
+    std::vector<std::uint64_t> out(BITMAP_WORDS, 0);
+    for_each([&](std::uint16_t v) { out[v >> 6] |= std::uint64_t(1) << (v & 63); });
+    bits.swap(out);
+    std::vector<std::uint16_t>().swap(values);
+    kind = BITMAP;
+  }
+
+  /**
+   * @brief Converts the container to a RUN.
+   *
+   * @throw Allocation exception. The container is unchanged in that case.
+  */
+  void to_run() {
+    std::vector<std::uint16_t> out;
+    for_each([&](std::uint16_t v) {
+      size_t n = out.size();
+      if (n > 0 && v == out[n - 2] + out[n - 1] + 1) {
+        ++out[n - 1];
+      } else {
+        out.push_back(v);
+        out.push_back(0);
+      }
+    });
+    out.shrink_to_fit();
+    values.swap(out);
+    std::vector<std::uint64_t>().swap(bits);
+    kind = RUN;
+  }
+
+  /**
+   * @brief Converts a RUN to the ARRAY or BITMAP form for its cardinality,
+   * and an ARRAY or a BITMAP whose cardinality crossed ARRAY_MAX to the
+   * other form.
+  */
+  void normalize() {
+    if (cardinality > ARRAY_MAX) {
+      if (kind != BITMAP) to_bitmap();
+    } else if (kind != ARRAY) {
+      to_array();
+    }
+  }
+
+  /**
+   * @brief Number of runs of consecutive values.
+  */
+  size_t run_count() const {
+    if (kind == RUN) return values.size() / 2;
+    size_t runs = 0;
+    if (kind == ARRAY) {
+      for (size_t i = 0; i < values.size(); ++i) {
+        if (i == 0 || values[i] != values[i - 1] + 1) ++runs;
+      }
+    } else {
+      std::uint64_t carry = 0; // Highest bit of the previous word
+      for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        runs += detail::popcount64(bits[w] & ~((bits[w] << 1) | carry));
+        carry = bits[w] >> 63;
+      }
+    }
+    return runs;
+  }
+
+  /**
+   * @brief Recomputes the cardinality of a BITMAP.
+  */
+  void recount() {
+    cardinality = 0;
+    for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+      cardinality += static_cast<std::uint32_t>(detail::popcount64(bits[w]));
+    }
+  }
+
+  /**
+   * @brief Position of the last run starting at or before a value.
+   *
+   * @return The index of the run, or values.size() / 2 if none.
+  */
+  size_t find_run(std::uint16_t low) const {
+    size_t lo = 0, hi = values.size() / 2;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (values[2 * mid] <= low) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo == 0 ? values.size() / 2 : lo - 1;
+  }
+
+  /**
+   * @brief Tells if the container holds a value.
+  */
+  bool contains(std::uint16_t low) const {
+    if (kind == ARRAY) {
+      return std::binary_search(values.begin(), values.end(), low);
+    } else if (kind == BITMAP) {
+      return (bits[low >> 6] >> (low & 63)) & 1;
+    }
+    size_t r = find_run(low);
+    return r < values.size() / 2 && low - values[2 * r] <= values[2 * r + 1];
+  }
+
+  /**
+   * @brief Adds a value.
+   *
+   * @return true if the value was added, false if it is already contained.
+   *
+   * @throw Allocation exception.
+  */
+  bool add(std::uint16_t low) {
+    if (kind == RUN) {
+      if (contains(low)) return false;
+      normalize();
+    }
+    if (kind == ARRAY) {
+      std::vector<std::uint16_t>::iterator it = std::lower_bound(values.begin(), values.end(), low);
+      if (it != values.end() && *it == low) return false;
+      if (cardinality < ARRAY_MAX) {
+        values.insert(it, low);
+        ++cardinality;
+        return true;
+      }
+      to_bitmap(); // The value goes to the bitmap
+    }
+    std::uint64_t mask = std::uint64_t(1) << (low & 63);
+    if (bits[low >> 6] & mask) return false;
+    bits[low >> 6] |= mask;
+    ++cardinality;
+    return true;
+  }
+
+  /**
+   * @brief Removes a value.
+   *
+   * @return true if the value was removed, false if it is not contained.
+   *
+   * @throw Allocation exception (converting the form of the container).
+  */
+  bool remove(std::uint16_t low) {
+    if (!contains(low)) return false;
+    if (kind == RUN) normalize();
+    if (kind == ARRAY) {
+      values.erase(std::lower_bound(values.begin(), values.end(), low));
+      --cardinality;
+    } else {
+      std::uint64_t mask = std::uint64_t(1) << (low & 63);
+      bits[low >> 6] &= ~mask;
+      --cardinality;
+      if (cardinality <= ARRAY_MAX) {
+        try {
+          to_array();
+        } catch (...) {
+          bits[low >> 6] |= mask;
+          ++cardinality;
+          throw;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Value of a given rank, in ascending order.
+   *
+   * @pre rank < cardinality
+  */
+  std::uint16_t select(std::uint32_t rank) const {
+    if (kind == ARRAY) {
+      return values[rank];
+    } else if (kind == BITMAP) {
+      size_t w = 0;
+      for (size_t count = detail::popcount64(bits[w]); rank >= count; count = detail::popcount64(bits[++w])) {
+        rank -= static_cast<std::uint32_t>(count);
+      }
+      std::uint64_t word = bits[w];
+      for (; rank > 0; --rank) {
+        word &= word - 1;
+      }
+      return static_cast<std::uint16_t>(w * 64 + detail::ctz64(word));
+    }
+    size_t r = 0;
+    for (; rank > values[r + 1]; r += 2) {
+      rank -= values[r + 1] + 1u;
+    }
+    return static_cast<std::uint16_t>(values[r] + rank);
+  }
+
+  /**
+   * @brief Finds the first value at or after a position.
+   *
+   * A position is an index in an ARRAY, a value in a BITMAP, or the index
+   * of a run and an offset in the run for a RUN.
+   *
+   * @param i Index of the position, updated to the one of the value found.
+   * @param offset Offset of the position in a RUN, updated likewise.
+   * @param low Set to the value found.
+   *
+   * @return true if a value was found, false if the position is past the
+   * last value.
+  */
+  bool seek(size_t& i, std::uint32_t& offset, std::uint16_t& low) const {
+    if (kind == ARRAY) {
+      if (i >= values.size()) return false;
+      low = values[i];
+      return true;
+    } else if (kind == BITMAP) {
+      size_t w = i >> 6;
+      if (w >= BITMAP_WORDS) return false;
+      std::uint64_t word = bits[w] & (~std::uint64_t(0) << (i & 63));
+      while (word == 0) {
+        if (++w == BITMAP_WORDS) return false;
+        word = bits[w];
+      }
+      i = w * 64 + detail::ctz64(word);
+      low = static_cast<std::uint16_t>(i);
+      return true;
+    }
+    if (i < values.size() / 2 && offset > values[2 * i + 1]) {
+      ++i;
+      offset = 0;
+    }
+    if (i >= values.size() / 2) return false;
+    low = static_cast<std::uint16_t>(values[2 * i] + offset);
+    return true;
+  }
+
+  /**
+   * @brief Compacts the container to its smallest form.
+  */
+  void optimize() {
+    if (kind == RUN) normalize();
+    size_t run_bytes = 4 * run_count();
+    size_t bytes = kind == ARRAY ? 2 * cardinality : 8 * BITMAP_WORDS;
+    if (run_bytes < bytes) {
+      to_run();
+    } else {
+      values.shrink_to_fit();
+    }
+  }
+
+  /**
+   * @brief Heap memory used by the container.
+  */
+  size_t memory_usage() const {
+    return values.capacity() * sizeof(std::uint16_t) + bits.capacity() * sizeof(std::uint64_t);
+  }
+};
+
+/**
+ * @brief Writes an unsigned integer in little endian order.
+*/
+template <typename U>
+void write_le(std::ostream& os, U value) {
+  for (size_t i = 0; i < sizeof(U); ++i) {
+    os.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+/**
+ * @brief Reads an unsigned integer in little endian order.
+ *
+ * @return false if the stream ended.
+*/
+template <typename U>
+bool read_le(std::istream& is, U& value) {
+  value = 0;
+  for (size_t i = 0; i < sizeof(U); ++i) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof()) return false;
+    value |= static_cast<U>(static_cast<U>(byte) << (8 * i));
+  }
+  return true;
+}
+
+/**
+ * @brief Copy of a container in ARRAY or BITMAP form.
+*/
+inline RoaringContainer materialized(const RoaringContainer& c) {
+  RoaringContainer copy(c);
+  copy.normalize();
+  return copy;
+}
+
+/**
+ * @brief Union of two containers.
+*/
+inline RoaringContainer unite(const RoaringContainer& a, const RoaringContainer& b) {
+  typedef RoaringContainer C;
+  if (a.kind == C::RUN || b.kind == C::RUN) return unite(materialized(a), materialized(b));
+  C r;
+  if (a.kind == C::ARRAY && b.kind == C::ARRAY) {
+    r.values.resize(a.cardinality + b.cardinality);
+    r.values.erase(std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                                  r.values.begin()), r.values.end());
+    r.cardinality = static_cast<std::uint32_t>(r.values.size());
+    r.normalize();
+    return r;
+  }
+  const C& bitmap = a.kind == C::BITMAP ? a : b;
+  const C& other = a.kind == C::BITMAP ? b : a;
+  r = bitmap;
+  if (other.kind == C::ARRAY) {
+    for (size_t i = 0; i < other.values.size(); ++i) {
+      r.bits[other.values[i] >> 6] |= std::uint64_t(1) << (other.values[i] & 63);
+    }
+  } else {
+    for (size_t w = 0; w < C::BITMAP_WORDS; ++w) {
+      r.bits[w] |= other.bits[w];
+    }
+  }
+  r.recount();
+  return r;
+}
+
+/**
+ * @brief Intersection of two containers.
+*/
+inline RoaringContainer intersect(const RoaringContainer& a, const RoaringContainer& b) {
+  typedef RoaringContainer C;
+  if (a.kind == C::RUN || b.kind == C::RUN) return intersect(materialized(a), materialized(b));
+  C r;
+  if (a.kind == C::ARRAY && b.kind == C::ARRAY) {
+    r.values.resize(std::min(a.cardinality, b.cardinality));
+    r.values.erase(std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                                         r.values.begin()), r.values.end());
+  } else if (a.kind == C::ARRAY || b.kind == C::ARRAY) {
+    const C& array = a.kind == C::ARRAY ? a : b;
+    const C& bitmap = a.kind == C::ARRAY ? b : a;
+    for (size_t i = 0; i < array.values.size(); ++i) {
+      if (bitmap.contains(array.values[i])) r.values.push_back(array.values[i]);
+    }
+  } else {
+    r.kind = C::BITMAP;
+    r.bits.resize(C::BITMAP_WORDS);
+    for (size_t w = 0; w < C::BITMAP_WORDS; ++w) {
+      r.bits[w] = a.bits[w] & b.bits[w];
+    }
+    r.recount();
+    r.normalize();
+    return r;
+  }
+  r.cardinality = static_cast<std::uint32_t>(r.values.size());
+  return r;
+}
+
+/**
+ * @brief Difference of two containers: the values of 'a' not in 'b'.
+*/
+inline RoaringContainer subtract(const RoaringContainer& a, const RoaringContainer& b) {
+  typedef RoaringContainer C;
+  if (a.kind == C::RUN || b.kind == C::RUN) return subtract(materialized(a), materialized(b));
+  C r;
+  if (a.kind == C::ARRAY) {
+    if (b.kind == C::ARRAY) {
+      r.values.resize(a.cardinality);
+      r.values.erase(std::set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                                         r.values.begin()), r.values.end());
+    } else {
+      for (size_t i = 0; i < a.values.size(); ++i) {
+        if (!b.contains(a.values[i])) r.values.push_back(a.values[i]);
+      }
+    }
+    r.cardinality = static_cast<std::uint32_t>(r.values.size());
+    return r;
+  }
+  r = a;
+  if (b.kind == C::ARRAY) {
+    for (size_t i = 0; i < b.values.size(); ++i) {
+      r.bits[b.values[i] >> 6] &= ~(std::uint64_t(1) << (b.values[i] & 63));
+    }
+  } else {
+    for (size_t w = 0; w < C::BITMAP_WORDS; ++w) {
+      r.bits[w] &= ~b.bits[w];
+    }
+  }
+  r.recount();
+  r.normalize();
+  return r;
+}
+
+/**
+ * @brief Symmetric difference of two containers.
+*/
+inline RoaringContainer symmetric_subtract(const RoaringContainer& a, const RoaringContainer& b) {
+  typedef RoaringContainer C;
+  if (a.kind == C::RUN || b.kind == C::RUN) return symmetric_subtract(materialized(a), materialized(b));
+  C r;
+  if (a.kind == C::ARRAY && b.kind == C::ARRAY) {
+    r.values.resize(a.cardinality + b.cardinality);
+    r.values.erase(std::set_symmetric_difference(a.values.begin(), a.values.end(), b.values.begin(),
+                                                 b.values.end(), r.values.begin()), r.values.end());
+    r.cardinality = static_cast<std::uint32_t>(r.values.size());
+    r.normalize();
+    return r;
+  }
+  const C& bitmap = a.kind == C::BITMAP ? a : b;
+  const C& other = a.kind == C::BITMAP ? b : a;
+  r = bitmap;
+  if (other.kind == C::ARRAY) {
+    for (size_t i = 0; i < other.values.size(); ++i) {
+      r.bits[other.values[i] >> 6] ^= std::uint64_t(1) << (other.values[i] & 63);
+    }
+  } else {
+    for (size_t w = 0; w < C::BITMAP_WORDS; ++w) {
+      r.bits[w] ^= other.bits[w];
+    }
+  }
+  r.recount();
+  r.normalize();
+  return r;
+}
+
+/**
+ * @brief Tells if two containers hold the same values.
+*/
+inline bool equal_containers(const RoaringContainer& a, const RoaringContainer& b) {
+  if (a.cardinality != b.cardinality) return false;
+  if (a.kind == RoaringContainer::RUN || b.kind == RoaringContainer::RUN) {
+    if (a.kind == b.kind) return a.values == b.values; // Runs are maximal
+    return equal_containers(materialized(a), materialized(b));
+  }
+  return a.kind == RoaringContainer::ARRAY ? a.values == b.values : a.bits == b.bits;
+}
+
+} // namespace detail
+
+/**
+ * @brief RoaringSet Class
+ *
+ * Set of 32 bit integers, with the same interface of Set, compressed as a
+ * Roaring bitmap. The values are split by their 16 high bits into chunks of
+ * 65536 values; each chunk that is not empty has a container holding the 16
+ * low bits of its values, as a sorted array (up to 4096 values, 2 bytes per
+ * value), as a bitmap (8 KB) or, after optimize(), as runs of consecutive
+ * values (4 bytes per run). Therefore:
+ * - add, remove and contains are a binary search on the chunks followed by
+ *   a binary search or a bit test in the container;
+ * - getNumElements() takes constant time;
+ * - operator+, operator-, difference, symmetric_difference and operator==
+ *   merge the chunks, combining matching containers with sorted merges or
+ *   with word by word operations, and copying the others whole;
+ * - iteration and operator<< list the elements in ascending order (of their
+ *   unsigned value, so negative ints come after the positive ones);
+ * - save() and load() store a compact binary form.
+ *
+ * @tparam T Integral type of 32 bits of the elements.
+*/
+template <typename T = std::uint32_t>
+class RoaringSet {
+  static_assert(std::is_integral<T>::value && sizeof(T) == 4, "RoaringSet requires a 32 bit integral type");
+
+private:
+  typedef detail::RoaringContainer Container; ///< Container of a chunk
+
+  std::vector<std::uint16_t> _keys; ///< High 16 bits of the chunks, sorted
+  std::vector<Container> _containers; ///< Container of each chunk (never empty)
+  size_t _num_elements; ///< Number of elements currently in the RoaringSet
+
+  /**
+   * @brief Position of the chunk of a key, or of the first following one.
+  */
+  size_t find_key(std::uint16_t key) const {
+    return std::lower_bound(_keys.begin(), _keys.end(), key) - _keys.begin();
+  }
+
+  /**
+   * @brief Appends a chunk following the last one.
+  */
+  void push_back(std::uint16_t key, const Container& container) {
+    _keys.push_back(key);
+    _containers.push_back(container);
+    _num_elements += container.cardinality;
+  }
+
+  /**
+   * @brief Appends a chunk following the last one, moving its container.
+  */
+  void push_back(std::uint16_t key, Container&& container) {
+    _keys.push_back(key);
+    _num_elements += container.cardinality;
+    _containers.push_back(std::move(container));
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty RoaringSet. No memory is allocated.
+  */
+  RoaringSet() : _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * @param other RoaringSet from which to copy the elements.
+   *
+   * @throw Allocation exception.
+  */
+  RoaringSet(const RoaringSet& other) = default;
+
+  /**
+   * @brief Assignment operator.
+   *
+   * @param other The RoaringSet object to be copied.
+   *
+   * @return A reference to this RoaringSet after the assignment.
+   *
+   * @throw Allocation exception.
+  */
+  RoaringSet& operator=(const RoaringSet& other) {
+    if (&other != this) {
+      RoaringSet tmp(other);
+      this->swap(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new RoaringSet by taking over the chunks of another one.
+   *
+   * @param other RoaringSet from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  RoaringSet(RoaringSet&& other) noexcept : _num_elements(0) {
+    this->swap(other);
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The RoaringSet from which to take the elements.
+   *
+   * @return A reference to this RoaringSet after the assignment.
+   *
+   * @post other is empty.
+  */
+  RoaringSet& operator=(RoaringSet&& other) noexcept {
+    if (&other != this) {
+      empty();
+      this->swap(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Empties the RoaringSet.
+   *
+   * @post The internal memory has been deallocated.
+   * @post _num_elements = 0
+  */
+  void empty(void) {
+    std::vector<std::uint16_t>().swap(_keys);
+    std::vector<Container>().swap(_containers);
+    _num_elements = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * Swaps the state between the current instance of RoaringSet and the
+   * instance provided as a parameter.
+   *
+   * @param other The RoaringSet instance to swap states with the current
+   * instance.
+  */
+  void swap(RoaringSet& other) noexcept {
+    _keys.swap(other._keys);
+    _containers.swap(other._containers);
+    std::swap(_num_elements, other._num_elements);
+  }
+
+  /**
+   * @brief Adds a new element to the RoaringSet.
+   *
+   * @param value The element of type T to be added to the RoaringSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @throw Allocation exception. The element is not added in that case.
+  */
+  bool add(const T& value) {
+    std::uint32_t v = static_cast<std::uint32_t>(value);
+    std::uint16_t key = static_cast<std::uint16_t>(v >> 16);
+    size_t pos = find_key(key);
+    if (pos == _keys.size() || _keys[pos] != key) {
+      Container container;
+      container.add(static_cast<std::uint16_t>(v));
+      _containers.insert(_containers.begin() + pos, std::move(container));
+      try {
+        _keys.insert(_keys.begin() + pos, key);
+      } catch (...) {
+        _containers.erase(_containers.begin() + pos);
+        throw;
+      }
+      ++_num_elements;
+      return true;
+    }
+    if (!_containers[pos].add(static_cast<std::uint16_t>(v))) return false;
+    ++_num_elements;
+    return true;
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the
+   * RoaringSet.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    return add(T(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Removes an element from the RoaringSet.
+   *
+   * The chunk of the element is released when it becomes empty.
+   *
+   * @param value The element of type T to be removed from the RoaringSet.
+   *
+   * @return true if the element was removed, false if it is not contained.
+   *
+   * @throw Allocation exception, if the container of the chunk changes
+   * form. The element is not removed in that case.
+  */
+  bool remove(const T& value) {
+    std::uint32_t v = static_cast<std::uint32_t>(value);
+    std::uint16_t key = static_cast<std::uint16_t>(v >> 16);
+    size_t pos = find_key(key);
+    if (pos == _keys.size() || _keys[pos] != key) return false;
+    if (!_containers[pos].remove(static_cast<std::uint16_t>(v))) return false;
+    --_num_elements;
+    if (_containers[pos].cardinality == 0) {
+      _containers.erase(_containers.begin() + pos);
+      _keys.erase(_keys.begin() + pos);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Accesses the element at the specified index.
+   *
+   * Provides read-only access to the element at the given index, in
+   * ascending order. The chunks are skipped by their cardinality, so the
+   * access takes time linear in the number of chunks.
+   *
+   * @param index The index of the element to access.
+   *
+   * @return The element at the specified index.
+   *
+   * @throw std::out_of_range If the index is out of the bounds of the
+   * RoaringSet.
+  */
+  T operator[](int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= _num_elements) {
+      throw std::out_of_range("Index out of range");
+    }
+    std::uint32_t rank = static_cast<std::uint32_t>(index);
+    size_t c = 0;
+    for (; rank >= _containers[c].cardinality; ++c) {
+      rank -= _containers[c].cardinality;
+    }
+    return static_cast<T>(static_cast<std::uint32_t>(_keys[c]) << 16 | _containers[c].select(rank));
+  }
+
+  /**
+   * @brief Checks if the RoaringSet contains a specific element.
+   *
+   * @param value The element to search for in the RoaringSet.
+   *
+   * @return true if the element is found in the RoaringSet, false otherwise.
+  */
+  bool contains(const T& value) const {
+    std::uint32_t v = static_cast<std::uint32_t>(value);
+    std::uint16_t key = static_cast<std::uint16_t>(v >> 16);
+    size_t pos = find_key(key);
+    return pos < _keys.size() && _keys[pos] == key && _containers[pos].contains(static_cast<std::uint16_t>(v));
+  }
+
+  /**
+   * Returns the number of elements stored inside of the RoaringSet
+   *
+   * @return number of elements stored inside of the RoaringSet, in constant
+   * time.
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Compresses the runs of consecutive values.
+   *
+   * Converts to runs the containers that are smaller that way, and releases
+   * the unused capacity of the others. Adding or removing elements converts
+   * the runs of the chunk back to an array or a bitmap.
+   *
+   * @throw Allocation exception. The containers already converted stay so.
+  */
+  void optimize() {
+    for (size_t c = 0; c < _containers.size(); ++c) {
+      _containers[c].optimize();
+    }
+    _keys.shrink_to_fit();
+    _containers.shrink_to_fit();
+  }
+
+  /**
+   * @brief Returns the memory used by the RoaringSet.
+   *
+   * @return The size of the object plus the heap memory of the chunks, in
+   * bytes.
+  */
+  size_t memory_usage() const {
+    size_t bytes = sizeof(*this) + _keys.capacity() * sizeof(std::uint16_t) +
+                   _containers.capacity() * sizeof(Container);
+    for (size_t c = 0; c < _containers.size(); ++c) {
+      bytes += _containers[c].memory_usage();
+    }
+    return bytes;
+  }
+
+  /**
+   * @brief Writes the RoaringSet in the binary form of save().
+   *
+   * @param os The output stream, opened in binary mode.
+  */
+  void write_binary(std::ostream& os) const {
+    os.write("RSET", 4);
+    detail::write_le(os, static_cast<std::uint32_t>(_keys.size()));
+    for (size_t c = 0; c < _containers.size(); ++c) {
+      const Container& container = _containers[c];
+      detail::write_le(os, _keys[c]);
+      os.put(static_cast<char>(container.kind));
+      detail::write_le(os, container.cardinality);
+      if (container.kind == Container::BITMAP) {
+        for (size_t w = 0; w < Container::BITMAP_WORDS; ++w) {
+          detail::write_le(os, container.bits[w]);
+        }
+      } else {
+        detail::write_le(os, static_cast<std::uint32_t>(container.values.size()));
+        for (size_t i = 0; i < container.values.size(); ++i) {
+          detail::write_le(os, container.values[i]);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Reads a RoaringSet written by write_binary(), replacing the
+   * elements of this one.
+   *
+   * Every container is validated: the keys must be increasing, the values
+   * and runs sorted and disjoint, and the cardinalities exact.
+   *
+   * @param is The input stream, opened in binary mode.
+   *
+   * @return true if a valid RoaringSet was read, false otherwise: this
+   * RoaringSet is unchanged in that case.
+   *
+   * @throw Allocation exception. This RoaringSet is unchanged in that case.
+  */
+  bool read_binary(std::istream& is) {
+    char tag[4];
+    if (!is.read(tag, 4) || std::string(tag, 4) != "RSET") return false;
+    std::uint32_t chunks;
+    if (!detail::read_le(is, chunks) || chunks > 65536) return false;
+
+    RoaringSet loaded;
+    for (std::uint32_t c = 0; c < chunks; ++c) {
+      std::uint16_t key;
+      Container container;
+      int kind = 0;
+      if (!detail::read_le(is, key) || (kind = is.get()) == std::char_traits<char>::eof() ||
+          !detail::read_le(is, container.cardinality)) return false;
+      if (kind > Container::RUN || container.cardinality == 0 || container.cardinality > 65536) return false;
+      if (!loaded._keys.empty() && key <= loaded._keys.back()) return false;
+      container.kind = static_cast<Container::Kind>(kind);
+
+      size_t count = 0;
+      if (container.kind == Container::BITMAP) {
+        container.bits.resize(Container::BITMAP_WORDS);
+        for (size_t w = 0; w < Container::BITMAP_WORDS; ++w) {
+          if (!detail::read_le(is, container.bits[w])) return false;
+          count += detail::popcount64(container.bits[w]);
+        }
+        if (container.cardinality <= Container::ARRAY_MAX) return false;
+      } else {
+        std::uint32_t size;
+        if (!detail::read_le(is, size) || size > 2 * 65536) return false;
+        container.values.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+          if (!detail::read_le(is, container.values[i])) return false;
+        }
+        if (container.kind == Container::ARRAY) {
+          for (size_t i = 1; i < size; ++i) {
+            if (container.values[i - 1] >= container.values[i]) return false;
+          }
+          if (size > Container::ARRAY_MAX) return false;
+          count = size;
+        } else {
+          if (size % 2 != 0) return false;
+          for (size_t r = 0; r < size; r += 2) {
+            std::uint32_t last = static_cast<std::uint32_t>(container.values[r]) + container.values[r + 1];
+            // Runs are maximal: the next one starts after a gap
+            if (last > 0xFFFF || (r + 2 < size && last + 1 >= container.values[r + 2])) return false;
+            count += container.values[r + 1] + 1u;
+          }
+        }
+      }
+      if (count != container.cardinality) return false;
+      loaded.push_back(key, std::move(container));
+    }
+    swap(loaded);
+    return true;
+  }
+
+  /**
+   * @brief Constant input iterator for the RoaringSet class.
+   *
+   * This iterator provides read-only access to the elements of the
+   * RoaringSet, in ascending order. It holds a copy of the current element,
+   * decoded from its chunk: like the iterator of BitSet it is dereferenced
+   * by value, and declared an input iterator (although it can be copied and
+   * traversed again).
+  */
+  class const_iterator {
+  public:
+    typedef std::input_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef void pointer; ///< No pointer to the elements, which are decoded
+    typedef T reference; ///< Elements are returned by value
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes the iterator to a null pointer.
+    */
+    const_iterator() : _set(nullptr), _container(0), _index(0), _offset(0), _value(0) {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return The current element.
+    */
+    reference operator*() const { return _value; }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator++() {
+      if (_set->_containers[_container].kind == Container::RUN) {
+        ++_offset;
+      } else {
+        ++_index;
+      }
+      settle();
+      return *this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return Copy of the original iterator.
+    */
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if both iterators point to same element, false otherwise.
+    */
+    bool operator==(const const_iterator &other) const {
+      return _set == other._set && _container == other._container &&
+             _index == other._index && _offset == other._offset;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if iterators point to different element, false otherwise.
+    */
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    const RoaringSet* _set; ///< RoaringSet being iterated
+    size_t _container; ///< Index of the current chunk (number of chunks at the end)
+    size_t _index; ///< Position in the container (see RoaringContainer::seek)
+    std::uint32_t _offset; ///< Offset in the current run of a RUN container
+    T _value; ///< Copy of the current element
+
+    friend class RoaringSet; ///< Allow RoaringSet class to access private constructor.
+
+    /**
+     * @brief Constructor for internal use by the RoaringSet class.
+     *
+     * @param set RoaringSet being iterated.
+     * @param container Index of the first chunk to visit.
+    */
+    const_iterator(const RoaringSet* set, size_t container)
+      : _set(set), _container(container), _index(0), _offset(0), _value(0) {
+      settle();
+    }
+
+    /**
+     * @brief Moves to the first element at or after the current position,
+     * in the current chunk or the following ones.
+    */
+    void settle() {
+      std::uint16_t low;
+      for (; _container < _set->_containers.size(); ++_container, _index = 0, _offset = 0) {
+        if (_set->_containers[_container].seek(_index, _offset, low)) {
+          _value = static_cast<T>(static_cast<std::uint32_t>(_set->_keys[_container]) << 16 | low);
+          return;
+        }
+      }
+      _index = 0;
+      _offset = 0;
+    }
+
+  }; //const_iterator class
+
+  /**
+   * @brief Returns an iterator to the beginning of the RoaringSet.
+   *
+   * @return A const_iterator to the lowest element of the RoaringSet.
+  */
+  const_iterator begin() const {
+    return const_iterator(this, 0);
+  }
+
+  /**
+   * @brief Returns an iterator to the end of the RoaringSet.
+   *
+   * @return A const_iterator to the element following the highest element
+   * of the RoaringSet.
+  */
+  const_iterator end() const {
+    return const_iterator(this, _containers.size());
+  }
+
+  /**
+   * Constructor that creates a RoaringSet from a range defined by two
+   * iterators.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+  */
+  template <typename IteratorQ>
+  RoaringSet(IteratorQ begin, IteratorQ end) : _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        add(*it);
+      }
+    } catch (const std::exception& e) {
+      empty();
+      std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Builds a RoaringSet by merging the chunks of two RoaringSets.
+   *
+   * @param a The first RoaringSet.
+   * @param b The second RoaringSet.
+   * @param op Function combining two containers of the same chunk.
+   * @param keep_a Whether the chunks of 'a' only are copied to the result.
+   * @param keep_b Whether the chunks of 'b' only are copied to the result.
+   *
+   * @return The new RoaringSet.
+   *
+   * @throw Allocation exception.
+  */
+  template <typename Op>
+  static RoaringSet combine(const RoaringSet& a, const RoaringSet& b, Op op, bool keep_a, bool keep_b) {
+    RoaringSet new_set;
+    size_t i = 0, j = 0;
+    while (i < a._keys.size() && j < b._keys.size()) {
+      if (a._keys[i] < b._keys[j]) {
+        if (keep_a) new_set.push_back(a._keys[i], a._containers[i]);
+        ++i;
+      } else if (b._keys[j] < a._keys[i]) {
+        if (keep_b) new_set.push_back(b._keys[j], b._containers[j]);
+        ++j;
+      } else {
+        Container container = op(a._containers[i], b._containers[j]);
+        if (container.cardinality > 0) new_set.push_back(a._keys[i], std::move(container));
+        ++i;
+        ++j;
+      }
+    }
+    for (; keep_a && i < a._keys.size(); ++i) new_set.push_back(a._keys[i], a._containers[i]);
+    for (; keep_b && j < b._keys.size(); ++j) new_set.push_back(b._keys[j], b._containers[j]);
+    return new_set;
+  }
+
+  /**
+   * @brief Stream operator for the RoaringSet class.
+   *
+   * The output format is the same of Set: the number of elements followed by
+   * each element between round brackets, in ascending order.
+   *
+   * @param os The output stream to which the RoaringSet data will be sent.
+   * @param set The RoaringSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the RoaringSet
+   * data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const RoaringSet& set) {
+    os << set._num_elements;
+    for (const_iterator it = set.begin(); it != set.end(); ++it) {
+      os << " (" << *it << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for RoaringSet.
+   *
+   * Two RoaringSets are considered equal if they contain the same elements:
+   * they have the same chunks, with containers holding the same values.
+   *
+   * @param other The RoaringSet to compare with.
+   *
+   * @return True if the RoaringSets contain the same elements, false
+   * otherwise.
+  */
+  bool operator==(const RoaringSet& other) const {
+    if (_num_elements != other._num_elements || _keys != other._keys) return false;
+
+    for (size_t c = 0; c < _containers.size(); ++c) {
+      if (!detail::equal_containers(_containers[c], other._containers[c])) return false;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a RoaringSet, based on a predicate.
+ *
+ * This function creates a new RoaringSet containing elements from the
+ * original RoaringSet that satisfy the given predicate.
+ *
+ * @param S The original RoaringSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new RoaringSet. It is called in ascending order.
+ *
+ * @return A new RoaringSet containing elements that satisfy the predicate P.
+*/
+template <typename T, typename Predicate>
+RoaringSet<T> filter_out(const RoaringSet<T>& S, Predicate P) {
+  RoaringSet<T> new_set;
+  try {
+    for (typename RoaringSet<T>::const_iterator it = S.begin(); it != S.end(); ++it) {
+      if (P(*it)) {
+        new_set.add(*it); // Appended at the end of the last chunk
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the addition operator to concatenate two RoaringSets.
+ *
+ * Creates a new RoaringSet that represents the union of 'a' and 'b'.
+ *
+ * @param a The first RoaringSet to be concatenated.
+ * @param b The second RoaringSet to be concatenated.
+ *
+ * @return A new RoaringSet containing all elements from both 'a' and 'b'.
+*/
+template <typename T>
+RoaringSet<T> operator+(const RoaringSet<T>& a, const RoaringSet<T>& b) {
+  try {
+    return RoaringSet<T>::combine(a, b, detail::unite, true, true);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in operator+: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Computes the intersection of two RoaringSets.
+ *
+ * Creates a new RoaringSet containing the elements of 'a' that are also
+ * present in 'b'. Only the chunks present in both are visited.
+ *
+ * @param a The first RoaringSet to intersect.
+ * @param b The second RoaringSet to intersect.
+ *
+ * @return A new RoaringSet containing the intersection of 'a' and 'b'.
+*/
+template <typename T>
+RoaringSet<T> intersection(const RoaringSet<T>& a, const RoaringSet<T>& b) {
+  try {
+    return RoaringSet<T>::combine(a, b, detail::intersect, false, false);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of
+ * two RoaringSets.
+ *
+ * Same as intersection(a, b).
+ *
+ * @param a The first RoaringSet to intersect.
+ * @param b The second RoaringSet to intersect.
+ *
+ * @return A new RoaringSet containing the intersection of 'a' and 'b'.
+ *
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <typename T>
+RoaringSet<T> operator-(const RoaringSet<T>& a, const RoaringSet<T>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two RoaringSets.
+ *
+ * Creates a new RoaringSet with the elements of 'a' that are not contained
+ * in 'b'.
+ *
+ * @param a The RoaringSet whose elements are kept.
+ * @param b The RoaringSet whose elements are removed.
+ *
+ * @return A new RoaringSet containing a \ b.
+*/
+template <typename T>
+RoaringSet<T> difference(const RoaringSet<T>& a, const RoaringSet<T>& b) {
+  try {
+    return RoaringSet<T>::combine(a, b, detail::subtract, true, false);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Computes the symmetric difference of two RoaringSets.
+ *
+ * Creates a new RoaringSet with the elements contained in exactly one of
+ * 'a' and 'b'.
+ *
+ * @param a The first RoaringSet.
+ * @param b The second RoaringSet.
+ *
+ * @return A new RoaringSet containing (a \ b) U (b \ a).
+*/
+template <typename T>
+RoaringSet<T> symmetric_difference(const RoaringSet<T>& a, const RoaringSet<T>& b) {
+  try {
+    return RoaringSet<T>::combine(a, b, detail::symmetric_subtract, true, true);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
+    throw;
+  }
+}
+
+/**
+ * @brief Saves the contents of a RoaringSet to a file.
+ *
+ * Unlike the save() of the other Sets, the RoaringSet is written in a
+ * compact binary form, read back by load(): the tag "RSET", the number of
+ * chunks, then for each chunk its key, the form and the cardinality of its
+ * container and the contents of the container, all in little endian order.
+ *
+ * @param set The RoaringSet to be saved to the file.
+ * @param filename The name of the file to which the RoaringSet's contents
+ *                 will be saved.
+ *
+ * @note The function does not return a value or throw exceptions, but it
+ * reports to stderr if the file cannot be opened.
+*/
+template <typename T>
+void save(const RoaringSet<T>& set, const std::string& filename) {
+  std::ofstream outFile(filename, std::ios::binary);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  set.write_binary(outFile);
+  outFile.close();
+}
+
+/**
+ * @brief Loads a RoaringSet saved by save().
+ *
+ * @param set The RoaringSet receiving the contents of the file, replacing
+ *            its elements.
+ * @param filename The name of the file from which the contents are read.
+ *
+ * @return true if the file was read, false if it cannot be opened or does
+ * not hold a valid RoaringSet: 'set' is unchanged in that case.
+ *
+ * @note The failures are reported to stderr.
+*/
+template <typename T>
+bool load(RoaringSet<T>& set, const std::string& filename) {
+  std::ifstream inFile(filename, std::ios::binary);
+
+  if (!inFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return false;
+  }
+
+  RoaringSet<T> loaded;
+  if (!loaded.read_binary(inFile)) {
+    std::cerr << "Invalid RoaringSet file: " << filename << std::endl;
+    return false;
+  }
+  set.swap(loaded);
+  return true;
+}
+
+#endif // ROARING_SET_HPP
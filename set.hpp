@@ -10,12 +10,182 @@
 #define SET_HPP
 
 #include <iostream>
-#include <algorithm> // std::swap
+#include <algorithm> // std::swap, std::max
 #include <ostream> // std::ostream
 #include <stdexcept> // std::out_of_range
 #include <iterator> // std::forward_iterator_tag
 #include <cstddef> // std::ptrdiff_t, size_t
 #include <fstream> // std::ofstream
+#include <utility> // std::move, std::forward
+#include <new> // placement new
+#include <memory> // std::allocator_traits
+#include <atomic> // std::atomic
+#include <type_traits> // std::true_type, std::false_type, std::integral_constant
+#include <vector> // std::vector
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource> // std::pmr::polymorphic_allocator
+#endif
+#endif
+#include "raw_storage.hpp"
+#include "growth_policy.hpp"
+#include "hash.hpp"
+#include "hash_index.hpp"
+#include "cuckoo_filter.hpp"
+#include "simd.hpp"
+
+template <typename T, typename Equal, typename Policy = DefaultGrowthPolicy,
+          typename Allocator = ReallocAllocator<T> >
+class Set;
+
+namespace detail {
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y', and optionally the
+ * elements of 'y' contained in 'x', comparing every pair.
+ *
+ * Used when no hasher consistent with Equal is known (see HashTraits), and
+ * for small Sets, for which building a hash index does not pay off.
+ *
+ * @param x The first Set.
+ * @param y The second Set.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ * @param y_in_x If not nullptr, one flag per element of 'y', in order: 1 if
+ * contained in 'x'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void match_flags(const Set<T, Equal, Policy, Allocator>& x, const Set<T, Equal, Policy, Allocator>& y,
+                 std::vector<char>& x_in_y, std::vector<char>* y_in_x, std::false_type) {
+  typedef Set<T, Equal, Policy, Allocator> SetType;
+  Equal equal;
+
+  x_in_y.assign(x.getNumElements(), 0);
+  if (y_in_x != nullptr) y_in_x->assign(y.getNumElements(), 0);
+
+  size_t i = 0;
+  for (typename SetType::const_iterator ix = x.begin(); ix != x.end(); ++ix, ++i) {
+    size_t j = 0;
+    for (typename SetType::const_iterator iy = y.begin(); iy != y.end(); ++iy, ++j) {
+      if (equal(*iy, *ix)) {
+        x_in_y[i] = 1;
+        if (y_in_x != nullptr) (*y_in_x)[j] = 1;
+        break; // The elements of 'y' are unique
+      }
+    }
+  }
+}
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y', and optionally the
+ * elements of 'y' contained in 'x', with a hash join.
+ *
+ * A temporary hash index is built over the smaller Set and probed with the
+ * elements of the larger one, so the cost is O(|x| + |y|) and the memory is
+ * proportional to the smaller Set. When |x| * |y| is within a small factor
+ * of |x| + |y| (one of the Sets has a handful of elements) the pairs are
+ * compared directly instead.
+ *
+ * @param x The first Set.
+ * @param y The second Set.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ * @param y_in_x If not nullptr, one flag per element of 'y', in order: 1 if
+ * contained in 'x'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void match_flags(const Set<T, Equal, Policy, Allocator>& x, const Set<T, Equal, Policy, Allocator>& y,
+                 std::vector<char>& x_in_y, std::vector<char>* y_in_x, std::true_type) {
+  typedef Set<T, Equal, Policy, Allocator> SetType;
+  typedef typename HashTraits<T, Equal>::hasher Hasher;
+  const size_t LINEAR_FACTOR = 16; ///< Pairs compared per element before hashing pays off
+
+  size_t nx = x.getNumElements();
+  size_t ny = y.getNumElements();
+  size_t small = std::min(nx, ny);
+  if (small == 0 || std::max(nx, ny) <= LINEAR_FACTOR * (nx + ny) / small) {
+    detail::match_flags(x, y, x_in_y, y_in_x, std::false_type());
+    return;
+  }
+
+  x_in_y.assign(nx, 0);
+  if (y_in_x != nullptr) y_in_x->assign(ny, 0);
+
+  // Build over the smaller Set, probe with the larger one
+  const bool build_y = ny <= nx;
+  const SetType& build = build_y ? y : x;
+  const SetType& probe = build_y ? x : y;
+  std::vector<char>* build_flags = build_y ? y_in_x : &x_in_y;
+  std::vector<char>* probe_flags = build_y ? &x_in_y : y_in_x;
+  Hasher hasher;
+  Equal equal;
+
+  std::vector<const T*> elements;
+  std::vector<size_t> hashes;
+  elements.reserve(small);
+  hashes.reserve(small);
+  for (typename SetType::const_iterator it = build.begin(); it != build.end(); ++it) {
+    elements.push_back(&*it);
+    hashes.push_back(hasher(*it));
+  }
+  ChainedIndex index;
+  index.rebuild(hashes.data(), small, small);
+
+  size_t i = 0;
+  for (typename SetType::const_iterator it = probe.begin(); it != probe.end(); ++it, ++i) {
+    const T& value = *it;
+    size_t pos = index.find(hasher(value), [&](size_t p) { return equal(*elements[p], value); });
+    if (pos != ChainedIndex::npos) {
+      if (probe_flags != nullptr) (*probe_flags)[i] = 1;
+      if (build_flags != nullptr) (*build_flags)[pos] = 1;
+    }
+  }
+}
+
+/**
+ * @brief Flags the elements of 'x' contained in 'y', and optionally the
+ * elements of 'y' contained in 'x', picking the strategy from HashTraits and
+ * the sizes of the Sets.
+ *
+ * @param x The first Set.
+ * @param y The second Set.
+ * @param x_in_y One flag per element of 'x', in order: 1 if contained in 'y'.
+ * @param y_in_x If not nullptr, one flag per element of 'y', in order: 1 if
+ * contained in 'x'.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void match_flags(const Set<T, Equal, Policy, Allocator>& x, const Set<T, Equal, Policy, Allocator>& y,
+                 std::vector<char>& x_in_y, std::vector<char>* y_in_x = nullptr) {
+  detail::match_flags(x, y, x_in_y, y_in_x, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+}
+
+/**
+ * @brief Appends to a Set the elements of another Set whose flag has a
+ * given value.
+ *
+ * @param dest The Set receiving the elements, none of which it contains.
+ * @param src The Set providing the elements.
+ * @param flags One flag per element of 'src'.
+ * @param keep The value of the flag of the elements to append.
+ *
+ * @throw Allocation exception.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+void append_flagged(Set<T, Equal, Policy, Allocator>& dest, const Set<T, Equal, Policy, Allocator>& src,
+                    const std::vector<char>& flags, char keep) {
+  size_t i = 0;
+  for (typename Set<T, Equal, Policy, Allocator>::const_iterator it = src.begin(); it != src.end(); ++it, ++i) {
+    if (flags[i] == keep) {
+      dest.add_unchecked(*it);
+    }
+  }
+}
+
+} // namespace detail
 
 /**
  * @brief Set Class
@@ -23,28 +193,235 @@
  * Generic Set of type T elements. The Set ensures that each element is unique, 
  * disallowing duplicates. 
  * The Set uses a dynamic array to store its elements. This array is 
- * dynamically resized to accommodate the changing number of elements: it is
- * doubled in size when full and halved when only one quarter or less of its
- * capacity is being used.
+ * dynamically resized to accommodate the changing number of elements, as
+ * decided by the growth Policy: by default it is doubled in size when full
+ * and halved when only one quarter or less of its capacity is being used.
+ * The capacity can also be managed explicitly with reserve() and
+ * shrink_to_fit().
+ * The array is raw storage: only the first _num_elements slots hold a live
+ * element, so T does not need to be default constructible. It is obtained
+ * from the Allocator, whose propagation traits are honored by copy, move
+ * and swap.
+ * Copies with an equal allocator share the array, copy on write: copying a
+ * Set costs O(1), and the array is cloned by the first call changing one of
+ * the Sets sharing it (add, remove, empty, ...). The number of Sets sharing
+ * an array is an atomic counter, so copies of a Set can be made, changed
+ * and destroyed by different threads. The membership filter, if enabled, is
+ * not shared: a copy builds its own, in O(n).
  * 
  * @tparam T Type of the elements in the Set.
  * @tparam Equal Functor used for comparing two elements for equality. Returns 
  * true if the elements passed are equal, false otherwhise.
+ * @tparam Policy Growth policy of the array (see GrowthPolicy).
+ * @tparam Allocator Allocator of the array.
 */
-template <typename T, typename Equal>
+template <typename T, typename Equal, typename Policy, typename Allocator>
 class Set {
+public:
+  typedef Allocator allocator_type; ///< Type of the allocator
+
 private:
-  T* _array; ///< Pointer to the array
+  typedef std::allocator_traits<Allocator> alloc_traits; ///< Traits of the allocator
+  typedef std::atomic<size_t> refcount_type; ///< Counter of the Sets sharing an array
+
+  T* _array; ///< Pointer to the array (raw storage beyond _num_elements)
   size_t _size; ///< Capacity of the array (at a given moment)
   size_t _num_elements; ///< Number of elements currently in the Set
   Equal _equal; ///< Instance of the Equal functor;
+  Allocator _alloc; ///< Instance of the Allocator owning the array
+  CuckooFilter* _filter; ///< Membership filter of the elements, or nullptr (see enable_filter())
+  mutable std::atomic<refcount_type*> _refs; ///< Sets sharing the array, or nullptr if never shared
+
+  /**
+   * @brief An element constructed through the allocator outside of the
+   * array, and destroyed with the scope.
+  */
+  class Temporary {
+  public:
+    template <typename... Args>
+    explicit Temporary(Allocator& alloc, Args&&... args) : _alloc(alloc) {
+      detail::construct(_alloc, get(), std::forward<Args>(args)...);
+    }
+
+    ~Temporary() {
+      alloc_traits::destroy(_alloc, get());
+    }
+
+    T* get() {
+      return reinterpret_cast<T*>(&_storage);
+    }
+
+  private:
+    Allocator& _alloc; ///< Allocator constructing the element
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage; ///< Storage of the element
+
+    Temporary(const Temporary&); // not copyable
+    Temporary& operator=(const Temporary&);
+  };
+
+  /**
+   * @brief Swaps the arrays, but not the allocators, of two Sets.
+   *
+   * @param other The Set instance to swap arrays with the current instance.
+  */
+  void swap_storage(Set& other) {
+    std::swap(_num_elements, other._num_elements);
+    std::swap(_size, other._size);
+    std::swap(_array, other._array);
+    std::swap(_filter, other._filter);
+    refcount_type* refs = _refs.load(std::memory_order_relaxed);
+    _refs.store(other._refs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other._refs.store(refs, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Adds a reference to the array, for a copy sharing it.
+   *
+   * The counter is created by the first copy. Several threads may copy the
+   * same Set at the same time, so it is published with a compare and swap.
+   *
+   * @return The counter of the Sets sharing the array.
+   *
+   * @throw Allocation exception.
+  */
+  refcount_type* share() const {
+    refcount_type* refs = _refs.load(std::memory_order_acquire);
+    if (refs == nullptr) {
+      refcount_type* created = new refcount_type(1);
+      if (_refs.compare_exchange_strong(refs, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        refs = created;
+      } else {
+        delete created; // Another thread created it first
+      }
+    }
+    refs->fetch_add(1, std::memory_order_relaxed);
+    return refs;
+  }
+
+  /**
+   * @brief Tells if other Sets share the array.
+  */
+  bool is_shared() const {
+    refcount_type* refs = _refs.load(std::memory_order_relaxed);
+    return refs != nullptr && refs->load(std::memory_order_acquire) > 1;
+  }
+
+  /**
+   * @brief Clones the array before a change, if other Sets share it.
+   *
+   * @param capacity The capacity of the clone, i.e. the one the change
+   * needs, so that the elements are copied only once.
+   *
+   * @throw Allocation exception, or any exception thrown by the copy
+   * constructor of T. The Set is unchanged in that case.
+  */
+  void unshare(size_t capacity) {
+    if (is_shared()) {
+      reallocate(capacity);
+    }
+  }
+
+  /**
+   * @brief Drops the reference to the array, destroying the elements and
+   * deallocating it if no other Set shares it.
+   *
+   * @post _array == nullptr
+   * @post _num_elements = 0
+   * @post _size = 0
+  */
+  void release_array() {
+    refcount_type* refs = _refs.load(std::memory_order_relaxed);
+    if (refs == nullptr || refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      detail::destroy(_alloc, _array, _array + _num_elements);
+      detail::deallocate(_alloc, _array, _size);
+      delete refs;
+    }
+    _refs.store(nullptr, std::memory_order_relaxed);
+    _array = nullptr;
+    _num_elements = 0;
+    _size = 0;
+  }
+
+  /**
+   * @brief Swaps the allocators of two Sets, if they propagate.
+   *
+   * @param other The Set instance to swap allocators with.
+  */
+  void swap_allocators(Set& other, std::true_type) {
+    using std::swap;
+    swap(_alloc, other._alloc);
+  }
+
+  /**
+   * @brief Does not swap the allocators of two Sets, since they do not
+   * propagate.
+  */
+  void swap_allocators(Set&, std::false_type) {}
+
+  /**
+   * @brief Changes the capacity of the dynamic array used by the Set.
+   *
+   * This function reallocates the internal array of the Set. The operation
+   * takes care to relocate the existing elements to the new array (see
+   * detail::relocate) and to free up the old array's memory. An array shared
+   * with other Sets is copied instead, and left to them.
+   *
+   * @param new_size The new capacity, not lower than the number of elements.
+   * 
+   * @throw Allocation exception.
+   */
+  void reallocate(size_t new_size) {
+    try {
+      if (is_shared()) {
+        T* array = clone_array(new_size, std::is_copy_constructible<T>());
+        size_t n = _num_elements;
+        release_array();
+        _array = array;
+        _num_elements = n;
+      } else {
+        _array = detail::relocate(_alloc, _array, _num_elements, _size, new_size);
+      }
+      _size = new_size;
+      rebuild_filter();
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in resize: " << e.what() << '\n';
+      throw; // Re-throw the exception
+    }
+  }
+
+  /**
+   * @brief Copies the elements of the array into a new array.
+   *
+   * @param capacity The capacity of the new array.
+   *
+   * @return The new array.
+   *
+   * @throw Allocation exception, or any exception thrown by the copy
+   * constructor of T.
+  */
+  T* clone_array(size_t capacity, std::true_type) {
+    T* array = detail::allocate(_alloc, capacity);
+    try {
+      detail::copy_construct(_alloc, _array, _array + _num_elements, array);
+    } catch (...) {
+      detail::deallocate(_alloc, array, capacity);
+      throw;
+    }
+    return array;
+  }
+
+  /**
+   * @brief Sets of elements that cannot be copied cannot be copied either,
+   * so their arrays are never shared.
+  */
+  T* clone_array(size_t, std::false_type) {
+    return _array;
+  }
 
   /**
    * @brief Resizes the dynamic array used by the Set.
    *
-   * This function resizes the internal array of the Set. The resizing operation
-   * takes care to copy the existing elements to the new array and to free up
-   * the old array's memory.
+   * The new capacity is chosen by the growth Policy.
    *
    * @param increase A boolean indicating whether to increase (true) or 
    * decrease (false) the array size.
@@ -52,196 +429,1187 @@ private:
    * @throw Allocation exception.
    */
   void resize(bool increase) {
-    size_t new_size;
-    if (increase) {
-      new_size = _size > 0 ? _size * 2 : 1;
-    } else {
-      new_size = _size / 2;
+    reallocate(increase ? Policy::grow(_size) : Policy::shrink(_size));
+  }
+
+  /**
+   * @brief Makes room for a number of elements, growing the array at least
+   * as the Policy would.
+   *
+   * Unlike reserve(), repeated calls with slowly increasing counts still
+   * cost amortized constant time per element.
+   *
+   * @param n The number of elements to make room for.
+   *
+   * @throw Allocation exception.
+  */
+  void grow_to(size_t n) {
+    if (n > _size) {
+      reallocate(grown_capacity(n));
+    }
+  }
+
+  /**
+   * @brief Returns the capacity grow_to() reaches to make room for a number
+   * of elements.
+  */
+  size_t grown_capacity(size_t n) const {
+    if (n <= _size) return _size;
+    size_t grown = Policy::grow(_size);
+    return n > grown ? n : grown;
+  }
+
+  /**
+   * @brief Copies the elements of another Set into this empty Set.
+   *
+   * The array of 'other' is shared if this Set can deallocate it, i.e. if
+   * the allocators are equal; otherwise the elements are copied. The filter
+   * is never shared, since every Set updates its own.
+   *
+   * @param other Set from which to copy the elements.
+   *
+   * @throw Allocation exception. This Set is left empty in that case.
+  */
+  void copy_from(const Set& other) {
+    try {
+      if (other._array != nullptr && _alloc == other._alloc) {
+        _refs.store(other.share(), std::memory_order_relaxed);
+        _array = other._array;
+        _size = other._size;
+      } else {
+        _array = detail::allocate(_alloc, other._size);
+        _size = other._size;
+        detail::copy_construct(_alloc, other._array, other._array + other._num_elements, _array);
+      }
+      _num_elements = other._num_elements;
+      if (other._filter != nullptr) {
+        _filter = new CuckooFilter;
+        rebuild_filter();
+      }
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
+      empty(); // Clean up array in case of exception
+      throw;
+    }
+  }
+
+  /**
+   * @brief Finds the position of an element.
+   *
+   * Arithmetic elements compared by std::equal_to are searched with the SIMD
+   * kernels of simd.hpp (see SimdEqual), the other ones with Equal. When the
+   * filter is enabled, the keys of type T it rejects are not searched at all.
+   *
+   * @tparam K Type of the key, compared with the elements through Equal.
+   *
+   * @param key The key to search for.
+   *
+   * @return The position of the element equal to key, or _num_elements if
+   * there is none.
+  */
+  template <typename K>
+  size_t find(const K& key) const {
+    if (_filter != nullptr && !filter_may_contain(key)) {
+      return _num_elements;
+    }
+    return find(key, std::integral_constant<bool, SimdEqual<T, Equal>::value && std::is_same<K, T>::value>());
+  }
+
+  /**
+   * @brief find() with the SIMD kernels.
+  */
+  size_t find(const T& key, std::true_type) const {
+    return detail::simd_find(_array, _num_elements, key);
+  }
+
+  /**
+   * @brief find() with Equal, one element at a time.
+  */
+  template <typename K>
+  size_t find(const K& key, std::false_type) const {
+    for (size_t i = 0; i < _num_elements; ++i) {
+      if (_equal(_array[i], key)) {
+        return i;
+      }
+    }
+    return _num_elements;
+  }
+
+  /**
+   * @brief Adds a new element to the Set, copying or moving it.
+   *
+   * @param value The element to be added, forwarded to the array.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename U>
+  bool insert(U&& value) {
+    // Check if the element already exists
+    if (find(value) != _num_elements) {
+      return false;
+    }
+
+    append(std::forward<U>(value));
+    return true;
+  }
+
+  /**
+   * @brief Appends an element known not to be in the Set.
+   *
+   * @param value The element to be added, forwarded to the array.
+  */
+  template <typename U>
+  void append(U&& value) {
+    unshare(_num_elements == _size ? Policy::grow(_size) : _size);
+
+    // If the array is full, resize it
+    if (_num_elements == _size) {
+      resize(true);
+    }
+
+    // Construct the new element at the end of the used part of the array
+    detail::construct(_alloc, _array + _num_elements, std::forward<U>(value));
+    ++_num_elements;
+    filter_insert(_array[_num_elements - 1]);
+  }
+
+  /**
+   * @brief Hash value of an element, with the hasher of HashTraits.
+  */
+  static size_t hash_of(const T& value) {
+    typedef typename HashTraits<T, Equal>::hasher Hasher;
+    return Hasher()(value);
+  }
+
+  /**
+   * @brief Tells if an element may be contained, according to the filter.
+   *
+   * @pre The filter is enabled.
+  */
+  bool filter_may_contain(const T& value) const {
+    return filter_may_contain(value, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+  }
+
+  /**
+   * @brief Keys of another type than T are not hashed: they always pass.
+  */
+  template <typename K>
+  bool filter_may_contain(const K&) const {
+    return true;
+  }
+
+  /**
+   * @brief filter_may_contain() with the hasher of HashTraits.
+  */
+  bool filter_may_contain(const T& value, std::true_type) const {
+    return _filter->may_contain(hash_of(value));
+  }
+
+  /**
+   * @brief Without a hasher the filter is never enabled.
+  */
+  bool filter_may_contain(const T&, std::false_type) const {
+    return true;
+  }
+
+  /**
+   * @brief Inserts an element of the array into the filter, if enabled.
+  */
+  void filter_insert(const T& value) {
+    filter_insert(value, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+  }
+
+  /**
+   * @brief filter_insert() with the hasher of HashTraits.
+  */
+  void filter_insert(const T& value, std::true_type) {
+    if (_filter != nullptr && !_filter->insert(hash_of(value))) {
+      rebuild_filter(); // Full: a fingerprint may have been dropped
+    }
+  }
+
+  /**
+   * @brief Without a hasher the filter is never enabled.
+  */
+  void filter_insert(const T&, std::false_type) {}
+
+  /**
+   * @brief Removes an element of the array from the filter, if enabled.
+  */
+  void filter_erase(const T& value) {
+    filter_erase(value, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+  }
+
+  /**
+   * @brief filter_erase() with the hasher of HashTraits.
+  */
+  void filter_erase(const T& value, std::true_type) {
+    if (_filter != nullptr) {
+      _filter->erase(hash_of(value));
+    }
+  }
+
+  /**
+   * @brief Without a hasher the filter is never enabled.
+  */
+  void filter_erase(const T&, std::false_type) {}
+
+  /**
+   * @brief Rebuilds the filter, if enabled, from the elements of the array,
+   * for the current capacity.
+   *
+   * If the filter cannot be allocated, or the hashes of too many elements
+   * collide, it saturates: it lets every element pass until the next
+   * rebuild, so the Set stays correct.
+  */
+  void rebuild_filter() {
+    if (_filter != nullptr) {
+      rebuild_filter(std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+    }
+  }
+
+  /**
+   * @brief rebuild_filter() with the hasher of HashTraits.
+  */
+  void rebuild_filter(std::true_type) {
+    try {
+      std::vector<size_t> hashes(_num_elements);
+      for (size_t i = 0; i < _num_elements; ++i) {
+        hashes[i] = hash_of(_array[i]);
+      }
+      _filter->rebuild(hashes.data(), _num_elements, _size);
+    } catch (const std::exception& e) {
+      std::cerr << "Exception caught in rebuild_filter: " << e.what() << '\n';
+      _filter->saturate();
+    }
+  }
+
+  /**
+   * @brief Without a hasher the filter is never enabled.
+  */
+  void rebuild_filter(std::false_type) {}
+
+  /**
+   * @brief Number of elements in a range of forward iterators.
+  */
+  template <typename Iterator>
+  static size_t range_size(Iterator first, Iterator last, std::forward_iterator_tag) {
+    return static_cast<size_t>(std::distance(first, last));
+  }
+
+  /**
+   * @brief A range of input iterators can be traversed only once, so its
+   * number of elements is not known in advance.
+  */
+  template <typename Iterator>
+  static size_t range_size(Iterator, Iterator, std::input_iterator_tag) {
+    return 0;
+  }
+
+  /**
+   * @brief Adds the elements of a range, looking them up in a temporary
+   * hash index.
+   *
+   * The index holds the elements of the Set and the ones added so far, so
+   * both the duplicates already in the Set and the ones inside the range are
+   * detected in expected constant time.
+   *
+   * @param first Iterator pointing to the first element to add.
+   * @param last Iterator pointing past the last element to add.
+   *
+   * @return The number of elements added.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T. The elements added before are kept in that case.
+  */
+  template <typename Iterator>
+  size_t insert_range(Iterator first, Iterator last, std::true_type) {
+    typedef typename HashTraits<T, Equal>::hasher Hasher;
+    typedef typename std::iterator_traits<Iterator>::reference Reference;
+    Hasher hasher;
+
+    std::vector<size_t> hashes;
+    hashes.reserve(_size);
+    for (size_t i = 0; i < _num_elements; ++i) {
+      hashes.push_back(hasher(_array[i]));
+    }
+    ChainedIndex index;
+    index.rebuild(hashes.data(), _num_elements, _size);
+
+    size_t inserted = 0;
+    for (; first != last; ++first) {
+      Reference value = *first;
+      size_t hash = hasher(value);
+      if (index.find(hash, [&](size_t pos) { return _equal(_array[pos], value); }) != ChainedIndex::npos) {
+        continue;
+      }
+
+      if (_num_elements == _size) {
+        resize(true);
+        hashes.reserve(_size);
+        index.rebuild(hashes.data(), _num_elements, _size);
+      }
+
+      detail::construct(_alloc, _array + _num_elements, std::forward<Reference>(value));
+      hashes.push_back(hash); // Never reallocates: reserved up to _size
+      index.insert(hash, _num_elements);
+      ++_num_elements;
+      if (_filter != nullptr && !_filter->insert(hash)) {
+        rebuild_filter();
+      }
+      ++inserted;
+    }
+    return inserted;
+  }
+
+  /**
+   * @brief Adds the elements of a range one at a time, when no hasher
+   * consistent with Equal is known (see HashTraits).
+   *
+   * @param first Iterator pointing to the first element to add.
+   * @param last Iterator pointing past the last element to add.
+   *
+   * @return The number of elements added.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T. The elements added before are kept in that case.
+  */
+  template <typename Iterator>
+  size_t insert_range(Iterator first, Iterator last, std::false_type) {
+    size_t inserted = 0;
+    for (; first != last; ++first) {
+      if (insert(*first)) {
+        ++inserted;
+      }
+    }
+    return inserted;
+  }
+
+  /**
+   * @brief Removes the elements at the positions selected by a predicate, in
+   * a single pass.
+   *
+   * The remaining elements are moved towards the front of the array keeping
+   * their order, then the array is shrunk at most once, directly to the
+   * capacity the Policy would reach by shrinking repeatedly.
+   *
+   * @param selected Functor called once with every position, in increasing
+   * order, before the element at that position is moved: returns true if
+   * the element must be removed.
+   *
+   * @return The number of elements removed.
+   *
+   * @throw Any exception thrown by 'selected': the elements selected so far
+   * are removed and the others are kept. Allocation exceptions of the final
+   * shrink are not propagated, since the elements are removed already; the
+   * ones of the clone of a shared array are, with the Set unchanged.
+  */
+  template <typename Selected>
+  size_t compact(Selected selected) {
+    unshare(_size);
+
+    size_t kept = 0;
+    size_t i = 0;
+    try {
+      for (; i < _num_elements; ++i) {
+        if (selected(i)) continue;
+        if (i != kept) {
+          _array[kept] = std::move(_array[i]);
+        }
+        ++kept;
+      }
+    } catch (...) {
+      // Keep the elements that have not been tested yet
+      for (; i < _num_elements; ++i, ++kept) {
+        if (i != kept) {
+          _array[kept] = std::move(_array[i]);
+        }
+      }
+      detail::destroy(_alloc, _array + kept, _array + _num_elements);
+      _num_elements = kept;
+      rebuild_filter();
+      throw;
+    }
+
+    size_t removed = _num_elements - kept;
+    detail::destroy(_alloc, _array + kept, _array + _num_elements);
+    _num_elements = kept;
+
+    size_t new_size = _size;
+    while (Policy::should_shrink(_num_elements, new_size)) {
+      new_size = Policy::shrink(new_size);
+    }
+    if (new_size != _size) {
+      try {
+        reallocate(new_size);
+        return removed; // The filter has been rebuilt
+      } catch (const std::exception&) {
+        // The array is just left larger than needed
+      }
+    }
+    if (removed > 0) {
+      rebuild_filter();
+    }
+    return removed;
+  }
+
+  /**
+   * @brief Appends the elements of an array satisfying a predicate with the
+   * SIMD kernels, which write them directly into the spare capacity.
+   *
+   * @param data Pointer to the elements, known not to be in the Set.
+   * @param n Number of elements, not above the spare capacity.
+   * @param pred The predicate.
+   *
+   * @return The number of elements appended.
+  */
+  template <typename Predicate>
+  size_t append_selected(const T* data, size_t n, const Predicate& pred, std::true_type) {
+    size_t added = detail::simd_compress(data, n, pred, _array + _num_elements);
+    _num_elements += added;
+    for (size_t i = _num_elements - added; i < _num_elements; ++i) {
+      filter_insert(_array[i]);
+    }
+    return added;
+  }
+
+  /**
+   * @brief Appends the elements of an array satisfying a predicate, one at a
+   * time.
+  */
+  template <typename Predicate>
+  size_t append_selected(const T* data, size_t n, Predicate& pred, std::false_type) {
+    size_t added = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (pred(data[i])) {
+        append(data[i]);
+        ++added;
+      }
+    }
+    return added;
+  }
+
+  /**
+   * @brief Marks the positions of the elements of the Set that are equal to
+   * an element of a range, looking them up in a temporary hash index.
+   *
+   * @param first Iterator pointing to the first element of the range.
+   * @param last Iterator pointing past the last element of the range.
+   * @param marks One flag per element of the Set, set to 1 when found.
+  */
+  template <typename Iterator>
+  void mark_range(Iterator first, Iterator last, std::vector<char>& marks, std::true_type) const {
+    typedef typename HashTraits<T, Equal>::hasher Hasher;
+    Hasher hasher;
+
+    std::vector<size_t> hashes(_num_elements);
+    for (size_t i = 0; i < _num_elements; ++i) {
+      hashes[i] = hasher(_array[i]);
+    }
+    ChainedIndex index;
+    index.rebuild(hashes.data(), _num_elements, _num_elements);
+
+    for (; first != last; ++first) {
+      typename std::iterator_traits<Iterator>::reference value = *first;
+      size_t pos = index.find(hasher(value), [&](size_t p) { return _equal(_array[p], value); });
+      if (pos != ChainedIndex::npos) {
+        marks[pos] = 1;
+      }
+    }
+  }
+
+  /**
+   * @brief Marks the positions of the elements of the Set that are equal to
+   * an element of a range, searching them linearly when no hasher consistent
+   * with Equal is known (see HashTraits).
+   *
+   * @param first Iterator pointing to the first element of the range.
+   * @param last Iterator pointing past the last element of the range.
+   * @param marks One flag per element of the Set, set to 1 when found.
+  */
+  template <typename Iterator>
+  void mark_range(Iterator first, Iterator last, std::vector<char>& marks, std::false_type) const {
+    for (; first != last; ++first) {
+      size_t pos = find(*first);
+      if (pos != _num_elements) {
+        marks[pos] = 1;
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   * 
+   * Initializes a new, empty Set.
+   * 
+   * @post _array == nullptr
+   * @post _size == 0
+   * @post _num_elements == 0
+  */
+  Set() : _array(nullptr), _size(0), _num_elements(0), _filter(nullptr), _refs(nullptr) {}
+
+  /**
+   * @brief Allocator constructor.
+   * 
+   * Initializes a new, empty Set, whose array will be obtained from 'alloc'.
+   * 
+   * @param alloc The allocator of the array.
+  */
+  explicit Set(const Allocator& alloc)
+    : _array(nullptr), _size(0), _num_elements(0), _alloc(alloc), _filter(nullptr), _refs(nullptr) {}
+
+  /**
+   * @brief Copy constructor.
+   * 
+   * Creates a new Set by copying the elements from another Set. The
+   * allocator is obtained through select_on_container_copy_construction().
+   * If it is equal to the one of 'other', the array is shared, in O(1), until
+   * one of the Sets is changed; the filter of 'other', if enabled, is still
+   * rebuilt for the copy in O(n).
+   * 
+   * @param other Set from which to copy the elements.
+   * 
+   * @throw Allocation exception.
+  */
+  Set(const Set& other)
+    : _array(nullptr), _size(0), _num_elements(0), _equal(other._equal),
+      _alloc(alloc_traits::select_on_container_copy_construction(other._alloc)), _filter(nullptr),
+      _refs(nullptr) {
+    copy_from(other);
+  }
+
+  /**
+   * @brief Copy constructor with an allocator.
+   * 
+   * Creates a new Set by copying the elements from another Set into an array
+   * obtained from 'alloc', or by sharing the array of 'other' if 'alloc' is
+   * equal to its allocator.
+   * 
+   * @param other Set from which to copy the elements.
+   * @param alloc The allocator of the array.
+   * 
+   * @throw Allocation exception.
+  */
+  Set(const Set& other, const Allocator& alloc)
+    : _array(nullptr), _size(0), _num_elements(0), _equal(other._equal), _alloc(alloc),
+      _filter(nullptr), _refs(nullptr) {
+    copy_from(other);
+  }
+
+  /**
+   * @brief Assignment operator.
+   * 
+   * Assigns the content of the specified 'other' Set to this Set. It creates a
+   * copy of the 'other' Set and then swaps its contents with this Set.
+   * The allocator of 'other' is adopted only if it propagates on copy
+   * assignment; the array is shared if the allocators are then equal.
+   *
+   * @param other The Set object to be copied.
+   * 
+   * @return A reference to this Set after the assignment.
+   * 
+   * @throw Allocation exception.
+  */
+  Set& operator=(const Set& other) {
+    if (&other != this) {
+      typedef typename alloc_traits::propagate_on_container_copy_assignment propagate;
+      Set tmp(other, propagate::value ? other._alloc : _alloc);
+      this->swap_storage(tmp);
+      this->swap_allocators(tmp, propagate());
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new Set by taking over the array (and the allocator) of
+   * another Set, without copying any element.
+   *
+   * @param other Set from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  Set(Set&& other) noexcept
+    : _array(other._array), _size(other._size),
+      _num_elements(other._num_elements), _equal(std::move(other._equal)),
+      _alloc(std::move(other._alloc)), _filter(other._filter),
+      _refs(other._refs.load(std::memory_order_relaxed)) {
+    other._array = nullptr;
+    other._size = 0;
+    other._num_elements = 0;
+    other._filter = nullptr;
+    other._refs.store(nullptr, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Move constructor with an allocator.
+   *
+   * Takes over the array of 'other' if its allocator is equal to 'alloc';
+   * otherwise the elements are moved one by one into an array obtained from
+   * 'alloc' (after cloning the array of 'other', if it is shared).
+   *
+   * @param other Set from which to take the elements.
+   * @param alloc The allocator of the array.
+   *
+   * @throw Allocation exception, if the allocators are different.
+   *
+   * @post other is empty.
+  */
+  Set(Set&& other, const Allocator& alloc)
+    : _array(nullptr), _size(0), _num_elements(0), _equal(other._equal), _alloc(alloc),
+      _filter(nullptr), _refs(nullptr) {
+    if (_alloc == other._alloc) {
+      this->swap_storage(other);
+      return;
+    }
+
+    try {
+      other.unshare(other._size); // The elements of a shared array cannot be moved
+      _array = detail::allocate(_alloc, other._num_elements);
+      _size = other._num_elements;
+      for (; _num_elements < other._num_elements; ++_num_elements) {
+        detail::construct(_alloc, _array + _num_elements, std::move(other._array[_num_elements]));
+      }
+      if (other._filter != nullptr) {
+        _filter = new CuckooFilter;
+        rebuild_filter();
+      }
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in move constructor: " << e.what() << '\n';
+      empty(); // Clean up array in case of exception
+      throw;
+    }
+    other.empty();
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the elements of this Set and takes over the array of 'other',
+   * without copying any element. If the allocators are different and do not
+   * propagate on move assignment, the elements are moved one by one instead.
+   *
+   * @param other The Set from which to take the elements.
+   *
+   * @return A reference to this Set after the assignment.
+   *
+   * @post other is empty.
+  */
+  Set& operator=(Set&& other)
+    noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+             alloc_traits::is_always_equal::value) {
+    if (&other != this) {
+      typedef typename alloc_traits::propagate_on_container_move_assignment propagate;
+      if (propagate::value || _alloc == other._alloc) {
+        empty();
+        this->swap_storage(other);
+        this->swap_allocators(other, propagate());
+      } else {
+        Set tmp(std::move(other), _alloc);
+        this->swap_storage(tmp);
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   * 
+   * Safely deallocates the dynamic memory used by the Set, unless the array
+   * is shared with copies. Utilizes the empty() function to do so.
+   * 
+   * @post The internal array memory has been deallocated.
+   * @post _array == nullptr
+   * @post _num_elements = 0
+   * @post _size = 0
+  */
+  ~Set() {
+    empty();
+    delete _filter;
+  }
+
+  /**
+   * @brief Empties the Set.
+   * 
+   * Safely deallocates the dynamic memory used by the Set. An array shared
+   * with copies is left to them, without cloning it. The filter, if enabled,
+   * stays enabled.
+   * 
+   * @post The internal array memory has been deallocated.
+   * @post _array == nullptr
+   * @post _num_elements = 0
+   * @post _size = 0
+  */
+  void empty(void) {
+    release_array();
+    if (_filter != nullptr) {
+      _filter->clear();
+    }
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * Swaps the state between the current instance of Set and the instance
+   * provided as a parameter. The allocators are swapped only if they
+   * propagate on swap.
+   *
+   * @param other The Set instance to swap states with the current instance.
+   *
+   * @pre The allocators propagate on swap or are equal.
+  */
+  void swap(Set &other) {
+    this->swap_storage(other);
+    this->swap_allocators(other, typename alloc_traits::propagate_on_container_swap());
+  }
+
+  /**
+   * @brief Returns the allocator of the Set.
+   *
+   * @return A copy of the allocator owning the array.
+  */
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
+  /**
+   * @brief Adds a new element to the Set.
+   * 
+   * Inserts the value into the Set if it is not already present. 
+   * If the Set gets full, the _array gets resized (grown by the Policy).
+   * 
+   * @param value The element of type T to be added to the Set.
+   * 
+   * @return true if the element was added, false if it is already contained.
+   * 
+   * @note If an exception is thrown during resizing, the state of Set hasn't 
+   * been changed yet, mantaining the Set in a consistent state.
+  */
+  bool add(const T& value) {
+    return insert(value);
+  }
+
+  /**
+   * @brief Adds a new element to the Set, moving it.
+   * 
+   * Same as add(const T&), but the value is moved into the array instead of
+   * being copied. If the value is already contained, it is left untouched.
+   * 
+   * @param value The element of type T to be moved into the Set.
+   * 
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    return insert(std::move(value));
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the Set.
+   * 
+   * The element is constructed in place, through the allocator, in the first
+   * free slot of the array, and destroyed again if it turns out to be a
+   * duplicate. Since it must be compared with the elements of the Set, it is
+   * always constructed even in that case: see try_emplace() to avoid that.
+   * If the array is full or shared, the element is built in a temporary
+   * (still through the allocator) first, since 'args' may refer to elements
+   * of the array that growing or cloning it would release.
+   * 
+   * @param args Arguments forwarded to the constructor of T.
+   * 
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    if (_num_elements == _size || is_shared()) {
+      Temporary value(_alloc, std::forward<Args>(args)...);
+      return insert(std::move(*value.get()));
+    }
+
+    T* slot = _array + _num_elements;
+    detail::construct(_alloc, slot, std::forward<Args>(args)...);
+    if (find(*slot) != _num_elements) {
+      alloc_traits::destroy(_alloc, slot);
+      return false;
+    }
+    ++_num_elements;
+    filter_insert(*slot);
+    return true;
+  }
+
+  /**
+   * @brief Builds an element and adds it to the Set, only if it is absent.
+   * 
+   * The Set is searched for an element equal to 'key' first; the element is
+   * constructed from 'args' only if none is found, in place unless the array
+   * is full or shared (see emplace()). Equal must be callable as
+   * Equal(const T&, const K&).
+   * 
+   * @param key The key identifying the element.
+   * @param args Arguments forwarded to the constructor of T.
+   * 
+   * @return true if the element was built and added, false if an element
+   * equal to key is already contained.
+   * 
+   * @pre The element built from args is equal to key.
+  */
+  template <typename K, typename... Args>
+  bool try_emplace(const K& key, Args&&... args) {
+    if (find(key) != _num_elements) {
+      return false;
+    }
+
+    if (_num_elements == _size || is_shared()) {
+      Temporary value(_alloc, std::forward<Args>(args)...);
+      append(std::move(*value.get()));
+      return true;
+    }
+
+    detail::construct(_alloc, _array + _num_elements, std::forward<Args>(args)...);
+    ++_num_elements;
+    filter_insert(_array[_num_elements - 1]);
+    return true;
+  }
+
+  /**
+   * @brief Adds an element known not to be in the Set, copying it.
+   * 
+   * Skips the linear search of add(): the element is appended in amortized
+   * constant time. Meant for algorithms whose elements come from another
+   * Set, and are therefore already known to be unique.
+   * 
+   * @param value The element of type T to be added.
+   * 
+   * @throw Allocation exception.
+   * 
+   * @pre No element of the Set is equal to 'value'. Otherwise the Set would
+   * hold a duplicate.
+  */
+  void add_unchecked(const T& value) {
+    append(value);
+  }
+
+  /**
+   * @brief Adds an element known not to be in the Set, moving it.
+   * 
+   * @param value The element of type T to be moved into the Set.
+   * 
+   * @throw Allocation exception.
+   * 
+   * @pre No element of the Set is equal to 'value'.
+  */
+  void add_unchecked(T&& value) {
+    append(std::move(value));
+  }
+
+  /**
+   * @brief Adds the elements of another Set satisfying a predicate, known not
+   * to be in this Set.
+   * 
+   * The array is grown once for all the elements of 'other', which are
+   * appended in order without any search. For the predicates of simd.hpp
+   * (InRange, LessThan, GreaterThan, Modulo) over numeric elements stored by
+   * a ReallocAllocator (see SimdPredicate), the predicate is evaluated on a
+   * whole vector register at a time and the selected elements are stored
+   * directly into the array, without any branch.
+   * 
+   * @param other The Set whose elements are tested.
+   * @param pred Functor or function taking an element of type T and returning
+   * true if the element must be added. It is called once per element, in
+   * order, unless the SIMD kernels are used.
+   * 
+   * @return The number of elements added.
+   * 
+   * @throw Allocation exception, or any exception thrown by 'pred' or by the
+   * constructor of T. The elements added before are kept in that case.
+   * 
+   * @pre No element of 'other' is equal to an element of this Set.
+  */
+  template <typename Predicate>
+  size_t add_unchecked_if(const Set& other, Predicate pred) {
+    if (other._num_elements == 0) return 0;
+    unshare(grown_capacity(_num_elements + other._num_elements));
+    grow_to(_num_elements + other._num_elements);
+    return append_selected(other._array, other._num_elements, pred,
+      std::integral_constant<bool, SimdPredicate<T, Predicate>::value &&
+                                   std::is_same<Allocator, ReallocAllocator<T> >::value>());
+  }
+
+  /**
+   * @brief Builds a Set from a range of elements known to be unique.
+   * 
+   * The array is allocated once (for forward iterators) and every element
+   * is appended without any search, so the Set is built in O(n).
+   * 
+   * @param first Iterator pointing to the first element.
+   * @param last Iterator pointing past the last element.
+   * @param alloc The allocator of the array.
+   * 
+   * @return The new Set, holding the elements in the order of the range.
+   * 
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+   * 
+   * @pre No two elements of the range are equal.
+  */
+  template <typename Iterator>
+  static Set from_unique_range(Iterator first, Iterator last, const Allocator& alloc = Allocator()) {
+    typedef typename std::iterator_traits<Iterator>::iterator_category category;
+    Set set(alloc);
+    set.reserve(range_size(first, last, category()));
+    for (; first != last; ++first) {
+      set.append(*first);
+    }
+    return set;
+  }
+
+  /**
+   * @brief Adds the elements of a range to the Set.
+   * 
+   * The main bulk insertion path. The array is reserved once for the whole
+   * range (when its size can be computed, i.e. for forward iterators), then
+   * the range is deduplicated against the Set and against itself in a single
+   * pass. When HashTraits provides a hasher consistent with Equal, this pass
+   * uses a temporary hash index and costs O(n + m) instead of O(n * m).
+   * The elements are added in the order of the range.
+   * 
+   * @param first Iterator pointing to the first element to add.
+   * @param last Iterator pointing past the last element to add.
+   * 
+   * @return The number of elements actually added.
+   * 
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T. The elements added before are kept in that case.
+   * 
+   * @note The reservation counts the duplicates as well: use
+   * shrink_to_fit() to release the unused capacity if needed.
+  */
+  template <typename Iterator>
+  size_t add_range(Iterator first, Iterator last) {
+    typedef typename std::iterator_traits<Iterator>::iterator_category category;
+    size_t n = range_size(first, last, category());
+    unshare(grown_capacity(_num_elements + n));
+    if (n > 0) {
+      grow_to(_num_elements + n);
+    }
+    return insert_range(first, last, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+  }
+
+  /**
+   * @brief Removes an element from the Set.
+   * 
+   * If the value is present in the Set, it is removed. If the element is not
+   * found, the Set remains unchanged. The Set is resized if it becomes
+   * significantly underutilized as a result of the removal.
+   * 
+   * @param value The element of type T to be removed from the Set.
+   * 
+   * @return true if the element was removed, false if it is not contained.
+   * 
+   * @note If an exception is thrown during resizing, the element will still be
+   * removed, but the internal array may not be resized. By doing this, the Set 
+   * will mantain a consistent state.
+  */
+  bool remove(const T& value) {
+    if (_filter != nullptr && !filter_may_contain(value)) {
+      return false;
     }
+    for (size_t i = 0; i < _num_elements; ++i) {
+      if (_equal(_array[i], value)) {
+        // The positions are the same in the clone, which holds the element
+        // too, even when the Policy shrinks just to the remaining ones
+        unshare(Policy::should_shrink(_num_elements - 1, _size)
+                ? std::max(_num_elements, Policy::shrink(_size)) : _size);
+        filter_erase(_array[i]);
+        // Overwrite the removed element with the last element in the array
+        if (i != _num_elements - 1) {
+          _array[i] = std::move(_array[_num_elements - 1]);
+        }
+        --_num_elements;
+        alloc_traits::destroy(_alloc, _array + _num_elements);
 
-    T* new_array = nullptr;
-
-    try {
-      new_array = new T[new_size];
+        if (Policy::should_shrink(_num_elements, _size)) {
+          resize(false);
+        }
 
-      for (size_t i = 0; i < _num_elements; ++i) {
-        new_array[i] = _array[i];
+        return true; // Element found and removed
       }
-
-      delete[] _array;
-      _array = new_array;
-      _size = new_size;
-    } catch(const std::exception& e) {
-      std::cerr << "Exception caught in resize: " << e.what() << '\n';
-      delete[] new_array; // Clean up new array in case of exception
-      throw; // Re-throw the exception
     }
+    return false; // Element not found (and therefore not removed)
   }
 
-public:
   /**
-   * @brief Default constructor.
+   * @brief Removes all the elements satisfying a predicate.
    * 
-   * Initializes a new, empty Set.
+   * Unlike remove(), the remaining elements keep their order. The array is
+   * compacted in a single pass and shrunk at most once, so removing k
+   * elements costs O(n) instead of O(k * n).
    * 
-   * @post _array == nullptr
-   * @post _size == 0
-   * @post _num_elements == 0
+   * @param pred Functor or function taking an element of type T and returning
+   * true if the element must be removed. It is called once per element, in
+   * order.
+   * 
+   * @return The number of elements removed.
+   * 
+   * @throw Any exception thrown by 'pred'. The elements for which 'pred'
+   * returned true are removed, and the others are kept, in that case.
   */
-  Set() : _array(nullptr), _size(0), _num_elements(0) {}
+  template <typename Predicate>
+  size_t remove_if(Predicate pred) {
+    return compact([&](size_t pos) { return static_cast<bool>(pred(_array[pos])); });
+  }
 
   /**
-   * @brief Copy constructor.
+   * @brief Keeps only the elements satisfying a predicate.
    * 
-   * Creates a new Set by copying the elements from another Set.
+   * The complement of remove_if(), with the same costs and guarantees.
    * 
-   * @param other Set from which to copy the elements.
+   * @param pred Functor or function taking an element of type T and returning
+   * true if the element must be kept.
    * 
-   * @throw Allocation exception.
+   * @return The number of elements removed.
   */
-  Set(const Set& other) : _array(nullptr), _num_elements(0), _size(0) {
-    try {
-      _array = new T[other._size];
-      _size = other._size;
-
-      for (size_t i = 0; i < other._num_elements; ++i) {
-        _array[i] = other._array[i];
-        ++_num_elements;
-      }
-    } catch(const std::exception& e) {
-      std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
-      empty(); // Clean up array in case of exception
-      throw;
-    }
+  template <typename Predicate>
+  size_t retain(Predicate pred) {
+    return compact([&](size_t pos) { return !pred(_array[pos]); });
   }
 
   /**
-   * @brief Assignment operator.
+   * @brief Removes all the elements equal to an element of a range.
    * 
-   * Assigns the content of the specified 'other' Set to this Set. It creates a
-   * copy of the 'other' Set and then swaps its contents with this Set.
-   *
-   * @param other The Set object to be copied.
+   * The elements of the range are looked up in a temporary hash index of the
+   * Set when HashTraits provides a hasher consistent with Equal (O(n + m)),
+   * linearly otherwise (O(n * m)); then the array is compacted once, as by
+   * remove_if().
    * 
-   * @return A reference to this Set after the assignment.
+   * @param first Iterator pointing to the first element to remove.
+   * @param last Iterator pointing past the last element to remove.
    * 
-   * @throw Allocation exception.
+   * @return The number of elements removed.
+   * 
+   * @throw Allocation exception. The Set is unchanged in that case.
   */
-  Set& operator=(const Set& other) {
-    if (&other != this) {
-      Set tmp(other);
-      this->swap(tmp);
-    }
-    return *this;
+  template <typename Iterator>
+  size_t remove_all(Iterator first, Iterator last) {
+    std::vector<char> marks(_num_elements, 0);
+    mark_range(first, last, marks, std::integral_constant<bool, HashTraits<T, Equal>::enabled>());
+    return compact([&](size_t pos) { return marks[pos] != 0; });
   }
 
   /**
-   * @brief Destructor.
+   * @brief Adds in place the elements of another Set.
    * 
-   * Safely deallocates the dynamic memory used by the Set. Utilizes the empty()
-   * function to do so.
+   * The union is accumulated into the array of this Set: the elements of
+   * 'other' not already contained are appended, in their order. The array
+   * grows at most once, and at least by the growth factor of the Policy, so
+   * accumulating k Sets with += costs amortized appends, while
+   * acc = acc + next copies the accumulator at every step. The elements are
+   * found as by operator+ (see detail::match_flags()).
    * 
-   * @post The internal array memory has been deallocated.
-   * @post _array == nullptr
-   * @post _num_elements = 0
-   * @post _size = 0
+   * @param other The Set whose elements are added.
+   * 
+   * @return A reference to this Set.
+   * 
+   * @throw Allocation exception. The elements added before are kept in that
+   * case.
   */
-  ~Set() {
-    empty();
+  Set& operator+=(const Set& other) {
+    if (&other != this) {
+      std::vector<char> in_this;
+      detail::match_flags(other, *this, in_this);
+      grow_to(_num_elements + std::count(in_this.begin(), in_this.end(), 0));
+      detail::append_flagged(*this, other, in_this, 0);
+    }
+    return *this;
   }
 
   /**
-   * @brief Empties the Set.
+   * @brief Intersects in place this Set with another Set.
    * 
-   * Safely deallocates the dynamic memory used by the Set.
+   * Keeps the elements also contained in 'other', in their order, compacting
+   * the array in a single pass as remove_if() does.
    * 
-   * @post The internal array memory has been deallocated.
-   * @post _array == nullptr
-   * @post _num_elements = 0
-   * @post _size = 0
+   * @param other The Set to intersect with.
+   * 
+   * @return A reference to this Set.
+   * 
+   * @throw Allocation exception. The Set is unchanged in that case.
   */
-  void empty(void) {
-    delete[] _array;
-    _array = nullptr;
-    _num_elements = 0;
-    _size = 0;
+  Set& operator&=(const Set& other) {
+    if (&other != this) {
+      std::vector<char> in_other;
+      detail::match_flags(*this, other, in_other);
+      compact([&](size_t pos) { return in_other[pos] == 0; });
+    }
+    return *this;
   }
 
   /**
-   * @brief Swap function.
-   *
-   * Swaps the state between the current instance of Set and the instance
-   * provided as a parameter.
-   *
-   * @param other The Set instance to swap states with the current instance.
+   * @brief Intersects in place this Set with another Set.
+   * 
+   * Same as operator&=, so that a -= b is the same as a = a - b.
+   * 
+   * @param other The Set to intersect with.
+   * 
+   * @return A reference to this Set.
+   * 
+   * @note Despite the operator, this is not the set difference: see
+   * subtract().
   */
-  void swap(Set &other) {
-    std::swap(_num_elements, other._num_elements);
-    std::swap(_size, other._size);
-    std::swap(_array, other._array);
+  Set& operator-=(const Set& other) {
+    return *this &= other;
   }
 
   /**
-   * @brief Adds a new element to the Set.
+   * @brief Removes in place the elements contained in another Set.
    * 
-   * Inserts the value into the Set if it is not already present. 
-   * If the Set gets full, the _array gets resized (doubled in size).
+   * The in place version of difference(): keeps the elements not contained
+   * in 'other', in their order, compacting the array in a single pass.
    * 
-   * @param value The element of type T to be added to the Set.
+   * @param other The Set whose elements are removed.
    * 
-   * @return true if the element was added, false if it is already contained.
+   * @return A reference to this Set.
    * 
-   * @note If an exception is thrown during resizing, the state of Set hasn't 
-   * been changed yet, mantaining the Set in a consistent state.
+   * @throw Allocation exception. The Set is unchanged in that case.
   */
-  bool add(const T& value) {
-    // Check if the element already exists
-    if(this->contains(value)) {
-      return false;
-    }
-
-    // If the array is full, resize it
-    if (_num_elements == _size) {
-      resize(true);
+  Set& subtract(const Set& other) {
+    if (&other == this) {
+      compact([](size_t) { return true; });
+      return *this;
     }
-
-    // Add the new element at the end of the used part of the array
-    _array[_num_elements] = value;
-    ++_num_elements;
-    return true;
+    std::vector<char> in_other;
+    detail::match_flags(*this, other, in_other);
+    compact([&](size_t pos) { return in_other[pos] != 0; });
+    return *this;
   }
 
-
   /**
-   * @brief Removes an element from the Set.
+   * @brief Replaces in place this Set with its symmetric difference with
+   * another Set.
    * 
-   * If the value is present in the Set, it is removed. If the element is not
-   * found, the Set remains unchanged. The Set is resized if it becomes
-   * significantly underutilized as a result of the removal.
+   * The elements of 'other' not contained in this Set are appended first,
+   * then the elements contained in both are removed in a single compaction:
+   * the result has the order of symmetric_difference().
    * 
-   * @param value The element of type T to be removed from the Set.
+   * @param other The other Set.
    * 
-   * @return true if the element was removed, false if it is not contained.
+   * @return A reference to this Set.
    * 
-   * @note If an exception is thrown during resizing, the element will still be
-   * removed, but the internal array may not be resized. By doing this, the Set 
-   * will mantain a consistent state.
+   * @throw Allocation exception. The elements added before are kept in that
+   * case.
   */
-  bool remove(const T& value) {
-    for (size_t i = 0; i < _num_elements; ++i) {
-      if (_equal(_array[i], value)) {
-        // Overwrite the removed element with the last element in the array
-        _array[i] = _array[_num_elements - 1];
-        --_num_elements;
-
-        if (_num_elements <= _size / 4) {
-          resize(false);
-        }
-
-        return true; // Element found and removed
-      }
+  Set& operator^=(const Set& other) {
+    if (&other == this) {
+      compact([](size_t) { return true; });
+      return *this;
     }
-    return false; // Element not found (and therefore not removed)
+    std::vector<char> in_other, in_this;
+    detail::match_flags(*this, other, in_other, &in_this);
+    grow_to(_num_elements + std::count(in_this.begin(), in_this.end(), 0));
+    detail::append_flagged(*this, other, in_this, 0);
+    compact([&](size_t pos) { return pos < in_other.size() && in_other[pos] != 0; });
+    return *this;
   }
 
   /**
@@ -275,12 +1643,7 @@ public:
    * @return true if the element is found in the Set, false otherwise.
    */
   bool contains(const T& value) const {
-    for (size_t i = 0; i < _num_elements; ++i) {
-      if (_equal(_array[i], value)) {
-        return true; // Element found
-      }
-    }
-    return false; // Element not found
+    return find(value) != _num_elements;
   }
 
   /**
@@ -292,6 +1655,123 @@ public:
     return _num_elements;
   }
 
+  /**
+   * Returns a pointer to the elements of the Set, stored contiguously.
+   * 
+   * @return pointer to the first element, valid until the Set is modified
+   * (nullptr if the Set has never held any element).
+  */
+  const T* data() const {
+    return _array;
+  }
+
+  /**
+   * @brief Returns the capacity of the array.
+   * 
+   * @return number of elements the Set can hold before growing its array.
+  */
+  size_t capacity() const {
+    return _size;
+  }
+
+  /**
+   * @brief Reserves room for a number of elements.
+   * 
+   * Grows the array to hold at least 'n' elements with a single
+   * reallocation, so that adding up to 'n' elements does not resize it
+   * again. Does nothing if the capacity is already large enough.
+   * 
+   * @param n The number of elements to make room for.
+   * 
+   * @throw Allocation exception. The Set is unchanged in that case.
+   * 
+   * @note Removing elements may still shrink the array, as decided by the
+   * Policy (see NoShrinkPolicy).
+  */
+  void reserve(size_t n) {
+    if (n > _size) {
+      reallocate(n);
+    }
+  }
+
+  /**
+   * @brief Shrinks the array to the number of elements.
+   * 
+   * Releases the unused capacity with a single reallocation.
+   * 
+   * @throw Allocation exception. The Set is unchanged in that case.
+  */
+  void shrink_to_fit() {
+    if (_size > _num_elements) {
+      reallocate(_num_elements);
+    }
+  }
+
+  /**
+   * @brief Enables the approximate membership filter of the Set.
+   * 
+   * The filter (see CuckooFilter) is maintained alongside the array, and
+   * rebuilt whenever the array is reallocated. contains(), add() and
+   * remove() of an element it rejects return without scanning the array,
+   * which makes lookup misses O(1) instead of O(n) at the cost of 2 bytes
+   * per slot of the array, and of hashing every element added. Copies and
+   * moves of the Set keep the filter enabled: a copy rebuilds it, so it
+   * costs O(n) even when it shares the array.
+   * 
+   * Requires a hasher consistent with Equal (see HashTraits).
+   * 
+   * @note Hashing a key costs more than scanning a few elements: the filter
+   * pays off for Sets of hundreds of elements or more.
+   * 
+   * @note If the hashes of more than 8 elements are equal, e.g. with a
+   * hasher ignoring part of the key, the filter saturates: it lets every
+   * element pass until the array is reallocated, or enable_filter() is
+   * called again.
+   * 
+   * @post has_filter() == true
+   * 
+   * @throw Allocation exception. The filter is not enabled in that case.
+  */
+  void enable_filter() {
+    static_assert(HashTraits<T, Equal>::enabled, "enable_filter() requires a hasher consistent with Equal (see HashTraits)");
+    if (_filter == nullptr) {
+      _filter = new CuckooFilter;
+      rebuild_filter();
+    } else if (_filter->saturated()) {
+      rebuild_filter();
+    }
+  }
+
+  /**
+   * @brief Disables the approximate membership filter of the Set, releasing
+   * its memory.
+   * 
+   * @post has_filter() == false
+  */
+  void disable_filter() {
+    delete _filter;
+    _filter = nullptr;
+  }
+
+  /**
+   * @brief Tells if the approximate membership filter is enabled.
+   * 
+   * @return true if the filter is enabled.
+  */
+  bool has_filter() const {
+    return _filter != nullptr;
+  }
+
+  /**
+   * @brief Estimates the false positive rate of the filter.
+   * 
+   * @return The probability that an element not in the Set still costs a
+   * scan of the array: 1 if the filter is disabled.
+  */
+  double filter_false_positive_rate() const {
+    return _filter != nullptr ? _filter->false_positive_rate() : 1.0;
+  }
+
   /**
    * @brief Constant forward iterator for the Set class.
    * 
@@ -434,16 +1914,17 @@ public:
 
   /**
    * Constructor that creates a Set from a range defined by two iterators.
+   * The duplicates in the range are skipped (see add_range()).
    * 
    * @param begin Iterator pointing to the beginning of the range.
    * @param end Iterator pointing to the end of the range.
+   * @param alloc The allocator of the array.
   */
   template <typename IteratorQ>
-  Set(IteratorQ begin, IteratorQ end) : _array(nullptr), _size(0), _num_elements(0) {
+  Set(IteratorQ begin, IteratorQ end, const Allocator& alloc = Allocator())
+    : _array(nullptr), _size(0), _num_elements(0), _alloc(alloc), _filter(nullptr), _refs(nullptr) {
     try {
-      for (IteratorQ it = begin; it != end; ++it) {
-        add(*it);
-      }
+      add_range(begin, end);
     } catch (const std::exception& e) {
       empty();
       std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
@@ -500,11 +1981,17 @@ public:
  * @brief Filters elements of a set, based on a predicate.
  * 
  * This function creates a new Set containing elements from the original Set
- * that satisfy the given predicate.
+ * that satisfy the given predicate. The array of the result is reserved once
+ * for all the elements of S and trimmed at the end if the Policy would
+ * shrink it; the elements, unique in S, are appended without any search
+ * (see Set::add_unchecked_if(), which uses the SIMD kernels for the
+ * predicates of simd.hpp on numeric Sets).
  *
  * @tparam T The type of elements stored in the Set.
  * @tparam Equal A functor or function for comparing two elements of type T for 
  *         equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
  * @tparam Predicate A functor or function that takes an element of type T and 
  *         returns a boolean.
  * 
@@ -512,17 +1999,16 @@ public:
  * @param P The predicate function that decides whether an element should be 
  *          included in the new Set.
  * 
- * @return Set<T, Equal> A new Set containing elements that satisfy the 
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing elements that satisfy the 
  * predicate P.
 */
-template <typename T, typename Equal, typename Predicate>
-Set<T, Equal> filter_out(const Set<T, Equal>& S, Predicate P) {
-  Set<T, Equal> new_set;
+template <typename T, typename Equal, typename Policy, typename Allocator, typename Predicate>
+Set<T, Equal, Policy, Allocator> filter_out(const Set<T, Equal, Policy, Allocator>& S, Predicate P) {
+  Set<T, Equal, Policy, Allocator> new_set(S.get_allocator());
   try {
-    for (typename Set<T, Equal>::const_iterator it = S.begin(); it != S.end(); ++it) {
-      if (P(*it)) {
-        new_set.add(*it);
-      }
+    new_set.add_unchecked_if(S, P);
+    if (Policy::should_shrink(new_set.getNumElements(), new_set.capacity())) {
+      new_set.shrink_to_fit();
     }
   } catch (const std::exception& e) {
     std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
@@ -537,25 +2023,31 @@ Set<T, Equal> filter_out(const Set<T, Equal>& S, Predicate P) {
  * 
  * Creates a new Set that represents the union of two sets, 'a' and 'b'. 
  * The resulting Set contains all the elements from both 'a' and 'b', ensuring 
- * uniqueness of the elements (no duplicates).
+ * uniqueness of the elements (no duplicates): the elements of 'a', followed by
+ * the elements of 'b' not contained in 'a'. These are found with a hash join
+ * in O(|a| + |b|) when HashTraits provides a hasher consistent with Equal
+ * (see detail::match_flags()), by comparing every pair otherwise.
  * 
  * @tparam T The type of elements stored in the Set.
  * @tparam Equal A functor or function for comparing two elements of type T for 
  * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
  * 
  * @param a The first Set to be concatenated.
  * @param b The second Set to be concatenated.
  * 
- * @return Set<T, Equal> A new Set containing all elements from both 'a' and 
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing all elements from both 'a' and 
  * 'b', with duplicates removed.
 */
-template <typename T, typename Equal>
-Set<T, Equal> operator+(const Set<T, Equal>& a, const Set<T, Equal>& b) {
-  Set<T, Equal> new_set = a;
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> operator+(const Set<T, Equal, Policy, Allocator>& a, const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a, a.get_allocator());
   try {
-    for (typename Set<T, Equal>::const_iterator it = b.begin(); it != b.end(); ++it) {
-      new_set.add(*it);
-    }
+    std::vector<char> in_a;
+    detail::match_flags(b, a, in_a);
+    new_set.reserve(a.getNumElements() + std::count(in_a.begin(), in_a.end(), 0));
+    detail::append_flagged(new_set, b, in_a, 0);
   } catch (const std::exception& e) {
     std::cerr << "Exception caught in operator+: " << e.what() << '\n';
     new_set.empty();
@@ -565,33 +2057,130 @@ Set<T, Equal> operator+(const Set<T, Equal>& a, const Set<T, Equal>& b) {
 }
 
 /**
- * @brief Overloads the subtraction operator to calculate the intersection of 
- * two sets.
+ * @brief Computes the intersection of two sets.
  * 
  * This function creates a new Set representing the intersection between Sets 
  * 'a' and 'b'. The intersection contains all elements that are present in both 
- * 'a' and 'b'.
+ * 'a' and 'b', in the order of 'a'. They are found with a hash join in
+ * O(|a| + |b|) when HashTraits provides a hasher consistent with Equal (see
+ * detail::match_flags()), by comparing every pair otherwise.
  * 
  * @tparam T The type of elements stored in the Set.
  * @tparam Equal A functor or function for comparing two elements of type T for 
  * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
  * 
  * @param a The first Set to intersect.
  * @param b The second Set to intersect.
  * 
- * @return Set<T, Equal> A new Set containing the intersection of 'a' and 'b'.
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing the intersection of 'a' and 'b'.
 */
-template <typename T, typename Equal>
-Set<T, Equal> operator-(const Set<T, Equal>& a, const Set<T, Equal>& b) {
-  Set<T, Equal> new_set;
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> intersection(const Set<T, Equal, Policy, Allocator>& a, const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a.get_allocator());
   try {
-    for (typename Set<T, Equal>::const_iterator it = a.begin(); it != a.end(); ++it) {
-      if(b.contains(*it)) {
-        new_set.add(*it);
-      }
-    }
+    std::vector<char> in_b;
+    detail::match_flags(a, b, in_b);
+    new_set.reserve(std::count(in_b.begin(), in_b.end(), 1));
+    detail::append_flagged(new_set, a, in_b, 1);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of 
+ * two sets.
+ * 
+ * Same as intersection(a, b).
+ * 
+ * @tparam T The type of elements stored in the Set.
+ * @tparam Equal A functor or function for comparing two elements of type T for 
+ * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
+ * 
+ * @param a The first Set to intersect.
+ * @param b The second Set to intersect.
+ * 
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing the intersection of 'a' and 'b'.
+ * 
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> operator-(const Set<T, Equal, Policy, Allocator>& a, const Set<T, Equal, Policy, Allocator>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two sets.
+ * 
+ * Creates a new Set with the elements of 'a' that are not contained in 'b'
+ * ("what is gone" from 'a' to 'b'), in the order of 'a'. They are found as
+ * by intersection().
+ * 
+ * @tparam T The type of elements stored in the Set.
+ * @tparam Equal A functor or function for comparing two elements of type T for 
+ * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
+ * 
+ * @param a The Set whose elements are kept.
+ * @param b The Set whose elements are removed.
+ * 
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing a \ b.
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> difference(const Set<T, Equal, Policy, Allocator>& a, const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a.get_allocator());
+  try {
+    std::vector<char> in_b;
+    detail::match_flags(a, b, in_b);
+    new_set.reserve(std::count(in_b.begin(), in_b.end(), 0));
+    detail::append_flagged(new_set, a, in_b, 0);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the symmetric difference of two sets.
+ * 
+ * Creates a new Set with the elements contained in exactly one of 'a' and
+ * 'b': the elements of 'a' not contained in 'b', in the order of 'a',
+ * followed by the elements of 'b' not contained in 'a', in the order of 'b'.
+ * A single join flags both sides.
+ * 
+ * @tparam T The type of elements stored in the Set.
+ * @tparam Equal A functor or function for comparing two elements of type T for 
+ * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
+ * 
+ * @param a The first Set.
+ * @param b The second Set.
+ * 
+ * @return Set<T, Equal, Policy, Allocator> A new Set containing (a \ b) U (b \ a).
+*/
+template <typename T, typename Equal, typename Policy, typename Allocator>
+Set<T, Equal, Policy, Allocator> symmetric_difference(const Set<T, Equal, Policy, Allocator>& a, const Set<T, Equal, Policy, Allocator>& b) {
+  Set<T, Equal, Policy, Allocator> new_set(a.get_allocator());
+  try {
+    std::vector<char> in_b, in_a;
+    detail::match_flags(a, b, in_b, &in_a);
+    new_set.reserve(std::count(in_b.begin(), in_b.end(), 0) + std::count(in_a.begin(), in_a.end(), 0));
+    detail::append_flagged(new_set, a, in_b, 0);
+    detail::append_flagged(new_set, b, in_a, 0);
   } catch (const std::exception& e) {
-    std::cerr << "Exception caught in operator-: " << e.what() << '\n';
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
     new_set.empty();
     throw;
   }
@@ -606,6 +2195,8 @@ Set<T, Equal> operator-(const Set<T, Equal>& a, const Set<T, Equal>& b) {
  *
  * @tparam Equal A functor or function for comparing two elements of type T for 
  * equality.
+ * @tparam Policy Growth policy of the Set array.
+ * @tparam Allocator Allocator of the Set array.
  * 
  * @param set The Set to be saved to the file.
  * @param filename The name of the file to which the Set's contents will be
@@ -614,8 +2205,8 @@ Set<T, Equal> operator-(const Set<T, Equal>& a, const Set<T, Equal>& b) {
  * @note The function does not return a value or throw exceptions, but it 
  * reports to stderr if the file cannot be opened.
 */
-template <typename Equal>
-void save(const Set<std::string, Equal>& set, const std::string& filename) {
+template <typename Equal, typename Policy, typename Allocator>
+void save(const Set<std::string, Equal, Policy, Allocator>& set, const std::string& filename) {
   std::ofstream outFile(filename);
 
   if (!outFile.is_open()) {
@@ -628,4 +2219,22 @@ void save(const Set<std::string, Equal>& set, const std::string& filename) {
   outFile.close();
 }
 
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+/**
+ * @brief Set whose array is obtained from a std::pmr::memory_resource.
+ *
+ * The elements are constructed with uses-allocator construction, so that
+ * elements such as std::pmr::string draw from the same resource.
+ *
+ * @tparam T The type of elements stored in the Set.
+ * @tparam Equal A functor or function for comparing two elements of type T for 
+ * equality.
+ * @tparam Policy Growth policy of the Set array.
+*/
+template <typename T, typename Equal, typename Policy = DefaultGrowthPolicy>
+using PmrSet = Set<T, Equal, Policy, std::pmr::polymorphic_allocator<T> >;
+#endif
+#endif
+
 #endif // SET_HPP
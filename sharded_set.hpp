@@ -0,0 +1,703 @@
+/**
+ * @file sharded_set.hpp
+ *
+ * @brief Header file for the templated ShardedSet class.
+ *
+ * Declaration/Definition of the templated ShardedSet class, which partitions
+ * its elements by hash value across independent Set shards, and of its
+ * algorithms. Two ShardedSets with the same number of shards place equal
+ * elements in the same shard, so their algebra is computed shard by shard,
+ * each shard by a std::thread worker (see ParallelPolicy), without any
+ * deduplication across shards.
+ *
+ * Link with -pthread.
+*/
+
+#ifndef SHARDED_SET_HPP
+#define SHARDED_SET_HPP
+
+#include <iostream>
+#include <ostream> // std::ostream
+#include <fstream> // std::ofstream
+#include <stdexcept> // std::invalid_argument, std::out_of_range
+#include <iterator> // std::forward_iterator_tag, std::make_move_iterator
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <utility> // std::move
+#include <vector> // std::vector
+#include "set.hpp"
+#include "parallel.hpp"
+
+/**
+ * @brief ShardedSet Class
+ *
+ * Set of type T elements split into a power of two number of shards, each
+ * one a Set. The shard of an element is selected by its mixed hash value
+ * (see hash_mix()), so every shard holds about the same number of elements.
+ *
+ * add, remove and contains work on the shard of their element only, i.e. on
+ * a Set of n / shards elements. The bulk operations (add_range(), reserve(),
+ * shrink_to_fit(), for_each_shard() and the free algorithms) process the
+ * shards concurrently, as many at a time as the ParallelPolicy allows: its
+ * min_partition counts shards, not elements.
+ *
+ * The elements are iterated shard by shard.
+ *
+ * @tparam T Type of the elements in the ShardedSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam Hash Functor used for hashing an element. Two elements that are
+ * equal according to Equal must have the same hash value.
+*/
+template <typename T, typename Equal, typename Hash = DefaultHash<T> >
+class ShardedSet {
+public:
+  typedef Set<T, Equal> shard_type; ///< Type of the shards
+
+  enum {
+    DEFAULT_SHARDS = 16 ///< Number of shards of a default constructed ShardedSet
+  };
+
+private:
+  std::vector<shard_type> _shards; ///< Shards of the elements
+  Hash _hash; ///< Instance of the Hash functor
+
+  /**
+   * @brief Rounds a number of shards up to a power of two.
+  */
+  static size_t shard_count(size_t shards) {
+    size_t count = 1;
+    while (count < shards) {
+      count *= 2;
+    }
+    return count;
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty ShardedSet.
+   *
+   * @param shards Number of shards, rounded up to a power of two.
+   *
+   * @throw Allocation exception.
+  */
+  explicit ShardedSet(size_t shards = DEFAULT_SHARDS) : _shards(shard_count(shards)) {}
+
+  /**
+   * @brief Conversion constructor from a Set.
+   *
+   * @param set The Set whose elements are copied.
+   * @param shards Number of shards, rounded up to a power of two.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  template <typename Policy, typename Allocator>
+  explicit ShardedSet(const Set<T, Equal, Policy, Allocator>& set, size_t shards = DEFAULT_SHARDS)
+    : _shards(shard_count(shards)) {
+    for (typename Set<T, Equal, Policy, Allocator>::const_iterator it = set.begin(); it != set.end(); ++it) {
+      _shards[shard_of(*it)].add_unchecked(*it);
+    }
+  }
+
+  /**
+   * @brief Returns the shard of an element.
+   *
+   * @param value The element.
+   *
+   * @return The index of the shard that holds (or would hold) the element.
+  */
+  size_t shard_of(const T& value) const {
+    return hash_mix(_hash(value)) & (_shards.size() - 1);
+  }
+
+  /**
+   * @brief Returns the number of shards.
+  */
+  size_t shards() const {
+    return _shards.size();
+  }
+
+  /**
+   * @brief Accesses a shard.
+   *
+   * @param index The index of the shard.
+   *
+   * @return A const reference to the shard.
+   *
+   * @throw std::out_of_range If there is no such shard.
+  */
+  const shard_type& shard(size_t index) const {
+    if (index >= _shards.size()) {
+      throw std::out_of_range("Shard out of range");
+    }
+    return _shards[index];
+  }
+
+  /**
+   * @brief Empties the ShardedSet, keeping its shards.
+  */
+  void empty(void) {
+    for (size_t s = 0; s < _shards.size(); ++s) {
+      _shards[s].empty();
+    }
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The ShardedSet instance to swap states with.
+  */
+  void swap(ShardedSet& other) {
+    _shards.swap(other._shards);
+    std::swap(_hash, other._hash);
+  }
+
+  /**
+   * @brief Adds a new element to its shard.
+   *
+   * @param value The element of type T to be added.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(const T& value) {
+    return _shards[shard_of(value)].add(value);
+  }
+
+  /**
+   * @brief Adds a new element to its shard, moving it.
+   *
+   * @param value The element of type T to be moved into the ShardedSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    size_t s = shard_of(value);
+    return _shards[s].add(std::move(value));
+  }
+
+  /**
+   * @brief Removes an element from its shard.
+   *
+   * @param value The element of type T to be removed.
+   *
+   * @return true if the element was removed, false if it is not contained.
+  */
+  bool remove(const T& value) {
+    return _shards[shard_of(value)].remove(value);
+  }
+
+  /**
+   * @brief Checks if the ShardedSet contains a specific element.
+   *
+   * @param value The element to search for.
+   *
+   * @return true if the element is found in its shard, false otherwise.
+  */
+  bool contains(const T& value) const {
+    return _shards[shard_of(value)].contains(value);
+  }
+
+  /**
+   * @brief Returns the number of elements of all the shards.
+  */
+  size_t getNumElements() const {
+    size_t n = 0;
+    for (size_t s = 0; s < _shards.size(); ++s) {
+      n += _shards[s].getNumElements();
+    }
+    return n;
+  }
+
+  /**
+   * @brief Calls a function on every shard, in parallel.
+   *
+   * @param policy The execution policy.
+   * @param f Functor called as f(index, shard) once per shard, where shard
+   * is a shard_type&. It is called concurrently on different shards.
+   *
+   * @throw Any exception thrown by 'f' (see detail::parallel_for()).
+  */
+  template <typename Function>
+  void for_each_shard(const ParallelPolicy& policy, Function f) {
+    detail::parallel_for(policy, _shards.size(), [&](size_t begin, size_t end) {
+      for (size_t s = begin; s < end; ++s) {
+        f(s, _shards[s]);
+      }
+    });
+  }
+
+  /**
+   * @brief Calls a function on every shard of a constant ShardedSet, in
+   * parallel.
+   *
+   * @param policy The execution policy.
+   * @param f Functor called as f(index, shard) once per shard, where shard
+   * is a const shard_type&.
+  */
+  template <typename Function>
+  void for_each_shard(const ParallelPolicy& policy, Function f) const {
+    detail::parallel_for(policy, _shards.size(), [&](size_t begin, size_t end) {
+      for (size_t s = begin; s < end; ++s) {
+        f(s, static_cast<const shard_type&>(_shards[s]));
+      }
+    });
+  }
+
+  /**
+   * @brief Adds the elements of a range.
+   *
+   * The range is split by shard first, by the calling thread; then every
+   * shard adds its part with Set::add_range(), in parallel.
+   *
+   * @param policy The execution policy.
+   * @param first Iterator pointing to the first element to add.
+   * @param last Iterator pointing past the last element to add.
+   *
+   * @return The number of elements actually added.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T. The elements added before are kept in that case.
+  */
+  template <typename Iterator>
+  size_t add_range(const ParallelPolicy& policy, Iterator first, Iterator last) {
+    std::vector<std::vector<T> > parts(_shards.size());
+    for (; first != last; ++first) {
+      parts[shard_of(*first)].push_back(*first);
+    }
+
+    std::vector<size_t> added(_shards.size(), 0);
+    for_each_shard(policy, [&](size_t s, shard_type& shard) {
+      added[s] = shard.add_range(std::make_move_iterator(parts[s].begin()),
+                                 std::make_move_iterator(parts[s].end()));
+    });
+
+    size_t total = 0;
+    for (size_t s = 0; s < added.size(); ++s) {
+      total += added[s];
+    }
+    return total;
+  }
+
+  /**
+   * @brief Reserves room for a number of elements, split evenly among the
+   * shards, which are grown in parallel.
+   *
+   * @param policy The execution policy.
+   * @param n The number of elements to make room for.
+   *
+   * @throw Allocation exception.
+  */
+  void reserve(const ParallelPolicy& policy, size_t n) {
+    size_t per_shard = (n + _shards.size() - 1) / _shards.size();
+    for_each_shard(policy, [per_shard](size_t, shard_type& shard) { shard.reserve(per_shard); });
+  }
+
+  /**
+   * @brief Shrinks the array of every shard to its number of elements, in
+   * parallel.
+   *
+   * @param policy The execution policy.
+   *
+   * @throw Allocation exception.
+  */
+  void shrink_to_fit(const ParallelPolicy& policy) {
+    for_each_shard(policy, [](size_t, shard_type& shard) { shard.shrink_to_fit(); });
+  }
+
+  /**
+   * @brief Copies the elements into a plain Set, shard by shard.
+   *
+   * @return A Set with the elements, in the order of iteration.
+   *
+   * @throw Allocation exception, or any exception thrown by the constructor
+   * of T.
+  */
+  shard_type to_set() const {
+    shard_type set;
+    set.reserve(getNumElements());
+    for (size_t s = 0; s < _shards.size(); ++s) {
+      for (typename shard_type::const_iterator it = _shards[s].begin(); it != _shards[s].end(); ++it) {
+        set.add_unchecked(*it);
+      }
+    }
+    return set;
+  }
+
+  /**
+   * @brief Builds a ShardedSet from the shards of two ShardedSets, shard by
+   * shard, in parallel.
+   *
+   * @param policy The execution policy.
+   * @param a The first ShardedSet.
+   * @param b The second ShardedSet.
+   * @param op Functor called as op(a_shard, b_shard) once per shard,
+   * concurrently, returning the shard of the result.
+   *
+   * @return The ShardedSet made of the results of op.
+   *
+   * @throw std::invalid_argument If the ShardedSets have different numbers of
+   * shards. Any exception thrown by 'op'.
+  */
+  template <typename Operation>
+  static ShardedSet combine(const ParallelPolicy& policy, const ShardedSet& a, const ShardedSet& b, Operation op) {
+    if (a._shards.size() != b._shards.size()) {
+      throw std::invalid_argument("ShardedSets with different numbers of shards");
+    }
+    ShardedSet result(a._shards.size());
+    result.for_each_shard(policy, [&](size_t s, shard_type& shard) {
+      shard = op(a._shards[s], b._shards[s]);
+    });
+    return result;
+  }
+
+  /**
+   * @brief Constant forward iterator for the ShardedSet class.
+   *
+   * Visits the elements of every shard in turn.
+  */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef const T* pointer; ///< Pointer to the constant element type
+    typedef const T& reference; ///< Reference to the constant element type
+
+    /**
+     * @brief Default constructor.
+    */
+    const_iterator() : _set(nullptr), _shard(0), _index(0) {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return A constant reference to the element pointed to by the iterator.
+    */
+    reference operator*() const {
+      return _set->_shards[_shard].data()[_index];
+    }
+
+    /**
+     * @brief Member access operator.
+     *
+     * @return A constant pointer to the element pointed to by the iterator.
+    */
+    pointer operator->() const {
+      return &**this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return A copy of the iterator before it was incremented.
+    */
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return A reference to the incremented iterator.
+    */
+    const_iterator& operator++() {
+      ++_index;
+      settle();
+      return *this;
+    }
+
+    /**
+     * @brief Equality operator.
+     *
+     * @param other The iterator to compare with.
+     *
+     * @return true if both iterators point to the same element.
+    */
+    bool operator==(const const_iterator& other) const {
+      return _set == other._set && _shard == other._shard && _index == other._index;
+    }
+
+    /**
+     * @brief Inequality operator.
+     *
+     * @param other The iterator to compare with.
+     *
+     * @return true if the iterators point to different elements.
+    */
+    bool operator!=(const const_iterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    const ShardedSet* _set; ///< ShardedSet being iterated
+    size_t _shard; ///< Index of the current shard
+    size_t _index; ///< Position inside the current shard
+
+    friend class ShardedSet; ///< Allow ShardedSet class to access private constructor.
+
+    /**
+     * @brief Private constructor, used by begin() and end().
+    */
+    const_iterator(const ShardedSet* set, size_t shard, size_t index)
+      : _set(set), _shard(shard), _index(index) {
+      settle();
+    }
+
+    /**
+     * @brief Moves past the end of the exhausted shards.
+    */
+    void settle() {
+      while (_shard < _set->_shards.size() && _index == _set->_shards[_shard].getNumElements()) {
+        ++_shard;
+        _index = 0;
+      }
+    }
+  };
+
+  /**
+   * @brief Returns an iterator to the first element.
+  */
+  const_iterator begin() const {
+    return const_iterator(this, 0, 0);
+  }
+
+  /**
+   * @brief Returns an iterator past the last element.
+  */
+  const_iterator end() const {
+    return const_iterator(this, _shards.size(), 0);
+  }
+
+  /**
+   * @brief Stream operator for the ShardedSet class.
+   *
+   * The output format is the same of Set: the number of elements followed by
+   * each element between round brackets, shard by shard.
+   *
+   * @param os The output stream to which the ShardedSet data will be sent.
+   * @param set The ShardedSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the ShardedSet data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const ShardedSet& set) {
+    os << set.getNumElements();
+    for (const_iterator it = set.begin(); it != set.end(); ++it) {
+      os << " (" << *it << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for ShardedSet.
+   *
+   * Two ShardedSets with the same number of shards are equal if their
+   * shards are equal, one by one; otherwise their elements are compared
+   * through to_set().
+   *
+   * @param other The ShardedSet to compare with.
+   *
+   * @return True if the ShardedSets contain the same elements, false otherwise.
+  */
+  bool operator==(const ShardedSet& other) const {
+    if (_shards.size() != other._shards.size()) {
+      return to_set() == other.to_set();
+    }
+    for (size_t s = 0; s < _shards.size(); ++s) {
+      if (!(_shards[s] == other._shards[s])) return false;
+    }
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a ShardedSet based on a predicate, shard by
+ * shard in parallel.
+ *
+ * @tparam Predicate A functor or function that takes an element of type T and
+ *         returns a boolean. It is called concurrently: it must be thread safe.
+ *
+ * @param policy The execution policy.
+ * @param S The original ShardedSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new ShardedSet.
+ *
+ * @return A new ShardedSet, with the shards of S, containing the elements
+ * that satisfy the predicate P.
+*/
+template <typename T, typename Equal, typename Hash, typename Predicate>
+ShardedSet<T, Equal, Hash> filter_out(const ParallelPolicy& policy, const ShardedSet<T, Equal, Hash>& S, Predicate P) {
+  typedef ShardedSet<T, Equal, Hash> SetType;
+  return SetType::combine(policy, S, S, [&](const typename SetType::shard_type& a, const typename SetType::shard_type&) {
+    return filter_out(a, P);
+  });
+}
+
+/**
+ * @brief Filters elements of a ShardedSet based on a predicate, with every
+ * hardware thread.
+*/
+template <typename T, typename Equal, typename Hash, typename Predicate>
+ShardedSet<T, Equal, Hash> filter_out(const ShardedSet<T, Equal, Hash>& S, Predicate P) {
+  return filter_out(ParallelPolicy(0, 1), S, P);
+}
+
+/**
+ * @brief Computes the union of two ShardedSets, shard by shard in parallel.
+ *
+ * @param policy The execution policy.
+ * @param a The first ShardedSet.
+ * @param b The second ShardedSet, with the same number of shards.
+ *
+ * @return A new ShardedSet whose shards are the unions of the shards of a
+ * and b.
+ *
+ * @throw std::invalid_argument If the numbers of shards differ.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> unite(const ParallelPolicy& policy, const ShardedSet<T, Equal, Hash>& a,
+                                 const ShardedSet<T, Equal, Hash>& b) {
+  typedef typename ShardedSet<T, Equal, Hash>::shard_type Shard;
+  return ShardedSet<T, Equal, Hash>::combine(policy, a, b, [](const Shard& x, const Shard& y) { return x + y; });
+}
+
+/**
+ * @brief Computes the union of two ShardedSets, with every hardware thread.
+ *
+ * @param a The first ShardedSet.
+ * @param b The second ShardedSet, with the same number of shards.
+ *
+ * @return A new ShardedSet containing the elements of a and b.
+ *
+ * @throw std::invalid_argument If the numbers of shards differ.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> operator+(const ShardedSet<T, Equal, Hash>& a, const ShardedSet<T, Equal, Hash>& b) {
+  return unite(ParallelPolicy(0, 1), a, b);
+}
+
+/**
+ * @brief Computes the intersection of two ShardedSets, shard by shard in
+ * parallel.
+ *
+ * @param policy The execution policy.
+ * @param a The first ShardedSet.
+ * @param b The second ShardedSet, with the same number of shards.
+ *
+ * @return A new ShardedSet containing the elements of both a and b.
+ *
+ * @throw std::invalid_argument If the numbers of shards differ.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> intersection(const ParallelPolicy& policy, const ShardedSet<T, Equal, Hash>& a,
+                                        const ShardedSet<T, Equal, Hash>& b) {
+  typedef typename ShardedSet<T, Equal, Hash>::shard_type Shard;
+  return ShardedSet<T, Equal, Hash>::combine(policy, a, b,
+                                             [](const Shard& x, const Shard& y) { return intersection(x, y); });
+}
+
+/**
+ * @brief Computes the intersection of two ShardedSets, with every hardware
+ * thread.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> intersection(const ShardedSet<T, Equal, Hash>& a, const ShardedSet<T, Equal, Hash>& b) {
+  return intersection(ParallelPolicy(0, 1), a, b);
+}
+
+/**
+ * @brief Computes the intersection of two ShardedSets.
+ *
+ * Same as intersection(), as operator- of Set.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> operator-(const ShardedSet<T, Equal, Hash>& a, const ShardedSet<T, Equal, Hash>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two ShardedSets, shard by shard in
+ * parallel.
+ *
+ * @param policy The execution policy.
+ * @param a The ShardedSet whose elements are kept.
+ * @param b The ShardedSet whose elements are removed, with the same number
+ * of shards.
+ *
+ * @return A new ShardedSet containing a \ b.
+ *
+ * @throw std::invalid_argument If the numbers of shards differ.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> difference(const ParallelPolicy& policy, const ShardedSet<T, Equal, Hash>& a,
+                                      const ShardedSet<T, Equal, Hash>& b) {
+  typedef typename ShardedSet<T, Equal, Hash>::shard_type Shard;
+  return ShardedSet<T, Equal, Hash>::combine(policy, a, b,
+                                             [](const Shard& x, const Shard& y) { return difference(x, y); });
+}
+
+/**
+ * @brief Computes the difference of two ShardedSets, with every hardware
+ * thread.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> difference(const ShardedSet<T, Equal, Hash>& a, const ShardedSet<T, Equal, Hash>& b) {
+  return difference(ParallelPolicy(0, 1), a, b);
+}
+
+/**
+ * @brief Computes the symmetric difference of two ShardedSets, shard by shard
+ * in parallel.
+ *
+ * @param policy The execution policy.
+ * @param a The first ShardedSet.
+ * @param b The second ShardedSet, with the same number of shards.
+ *
+ * @return A new ShardedSet containing the elements of exactly one of a and b.
+ *
+ * @throw std::invalid_argument If the numbers of shards differ.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> symmetric_difference(const ParallelPolicy& policy, const ShardedSet<T, Equal, Hash>& a,
+                                                const ShardedSet<T, Equal, Hash>& b) {
+  typedef typename ShardedSet<T, Equal, Hash>::shard_type Shard;
+  return ShardedSet<T, Equal, Hash>::combine(policy, a, b,
+                                             [](const Shard& x, const Shard& y) { return symmetric_difference(x, y); });
+}
+
+/**
+ * @brief Computes the symmetric difference of two ShardedSets, with every
+ * hardware thread.
+*/
+template <typename T, typename Equal, typename Hash>
+ShardedSet<T, Equal, Hash> symmetric_difference(const ShardedSet<T, Equal, Hash>& a,
+                                                const ShardedSet<T, Equal, Hash>& b) {
+  return symmetric_difference(ParallelPolicy(0, 1), a, b);
+}
+
+/**
+ * @brief Saves a ShardedSet of strings to a file.
+ *
+ * The file has the format of save() for Set.
+ *
+ * @param set The ShardedSet to be saved.
+ * @param filename The name of the file.
+*/
+template <typename Equal, typename Hash>
+void save(const ShardedSet<std::string, Equal, Hash>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+#endif // SHARDED_SET_HPP
@@ -0,0 +1,599 @@
+/**
+ * @file simd.hpp
+ *
+ * @brief Header file for the vectorized kernels used by the Sets.
+ *
+ * Declaration/Definition of the SIMD kernels scanning arrays of arithmetic
+ * elements, and of the simple predicates they can evaluate. On x86 the
+ * kernels compare a whole vector register of elements per instruction: 32
+ * bytes with AVX2, when the CPU supports it (detected at run time), 16 bytes
+ * with SSE2 otherwise. Other targets, and compilers without the GCC target
+ * attribute, use the scalar loops.
+*/
+
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef> // size_t
+#include <functional> // std::equal_to
+#include <type_traits> // std::is_arithmetic, std::is_floating_point, std::is_signed
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SET_SIMD_X86 ///< The x86 kernels are available
+#include <immintrin.h> // SSE2 and AVX2 intrinsics
+#define SET_SIMD_AVX2 __attribute__((target("avx2"))) ///< Compiles a function for AVX2
+#endif
+
+/**
+ * @brief Tells if the Sets can scan their arrays with the SIMD kernels.
+ *
+ * True when Equal is std::equal_to over an arithmetic type of 1, 2, 4 or 8
+ * bytes: comparing the lanes of a vector register is then the same as
+ * calling Equal (floating point lanes are compared as floating point values,
+ * so 0.0 equals -0.0 and NaN equals nothing).
+ *
+ * @tparam T Type of the elements.
+ * @tparam Equal Equality functor of the elements.
+*/
+template <typename T, typename Equal>
+struct SimdEqual {
+  static const bool value = false; ///< The kernels do not apply
+};
+
+/**
+ * @brief SimdEqual of std::equal_to.
+*/
+template <typename T>
+struct SimdEqual<T, std::equal_to<T> > {
+  static const bool value = std::is_arithmetic<T>::value &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8); ///< The kernels apply
+};
+
+/**
+ * @brief Predicate selecting the values of a closed interval.
+ *
+ * @tparam T Type of the elements.
+*/
+template <typename T>
+struct InRange {
+  T lo; ///< Lowest value selected
+  T hi; ///< Highest value selected
+
+  /**
+   * @brief Constructor.
+   *
+   * @param low Lowest value selected.
+   * @param high Highest value selected.
+  */
+  InRange(T low, T high) : lo(low), hi(high) {}
+
+  /**
+   * @brief Tells if lo <= x <= hi.
+  */
+  bool operator()(const T& x) const { return lo <= x && x <= hi; }
+};
+
+/**
+ * @brief Predicate selecting the values below a threshold.
+ *
+ * @tparam T Type of the elements.
+*/
+template <typename T>
+struct LessThan {
+  T bound; ///< Threshold, not selected
+
+  /**
+   * @brief Constructor.
+   *
+   * @param threshold Threshold, not selected.
+  */
+  explicit LessThan(T threshold) : bound(threshold) {}
+
+  /**
+   * @brief Tells if x < bound.
+  */
+  bool operator()(const T& x) const { return x < bound; }
+};
+
+/**
+ * @brief Predicate selecting the values above a threshold.
+ *
+ * @tparam T Type of the elements.
+*/
+template <typename T>
+struct GreaterThan {
+  T bound; ///< Threshold, not selected
+
+  /**
+   * @brief Constructor.
+   *
+   * @param threshold Threshold, not selected.
+  */
+  explicit GreaterThan(T threshold) : bound(threshold) {}
+
+  /**
+   * @brief Tells if x > bound.
+  */
+  bool operator()(const T& x) const { return x > bound; }
+};
+
+/**
+ * @brief Predicate selecting the integers with a given remainder.
+ *
+ * @tparam T Integral type of the elements.
+*/
+template <typename T>
+struct Modulo {
+  static_assert(std::is_integral<T>::value, "Modulo requires an integral type");
+
+  T divisor; ///< Divisor, not 0
+  T remainder; ///< Remainder selected, as computed by %
+
+  /**
+   * @brief Constructor.
+   *
+   * @param d Divisor, not 0.
+   * @param r Remainder selected: negative values have a remainder of the
+   * sign of the value, as with %.
+  */
+  Modulo(T d, T r) : divisor(d), remainder(r) {}
+
+  /**
+   * @brief Tells if x % divisor == remainder.
+  */
+  bool operator()(const T& x) const { return x % divisor == remainder; }
+};
+
+/**
+ * @brief Tells if the Sets can evaluate a predicate with the SIMD kernels.
+ *
+ * True for InRange, LessThan and GreaterThan over arithmetic types of 4 or
+ * 8 bytes, and for Modulo over 4 byte signed integers. Floating point lanes
+ * are compared as floating point values, so NaN is never selected.
+ *
+ * @tparam T Type of the elements.
+ * @tparam Predicate Type of the predicate.
+*/
+template <typename T, typename Predicate>
+struct SimdPredicate {
+  static const bool value = false; ///< The kernels do not apply
+};
+
+/**
+ * @brief SimdPredicate of InRange.
+*/
+template <typename T>
+struct SimdPredicate<T, InRange<T> > {
+  static const bool value = std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8); ///< The kernels apply
+};
+
+/**
+ * @brief SimdPredicate of LessThan.
+*/
+template <typename T>
+struct SimdPredicate<T, LessThan<T> > {
+  static const bool value = std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8); ///< The kernels apply
+};
+
+/**
+ * @brief SimdPredicate of GreaterThan.
+*/
+template <typename T>
+struct SimdPredicate<T, GreaterThan<T> > {
+  static const bool value = std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8); ///< The kernels apply
+};
+
+/**
+ * @brief SimdPredicate of Modulo.
+*/
+template <typename T>
+struct SimdPredicate<T, Modulo<T> > {
+  static const bool value = std::is_signed<T>::value && sizeof(T) == 4; ///< The kernels apply
+};
+
+namespace detail {
+
+/**
+ * @brief Finds the first element equal to a value, one at a time.
+ *
+ * @param data Pointer to the elements.
+ * @param n Number of elements.
+ * @param value The searched value.
+ *
+ * @return The position of the first element equal to 'value', n if none.
+*/
+template <typename T>
+size_t scalar_find(const T* data, size_t n, T value) {
+  for (size_t i = 0; i < n; ++i) {
+    if (data[i] == value) return i;
+  }
+  return n;
+}
+
+/**
+ * @brief Copies the elements satisfying a predicate, one at a time.
+ *
+ * Every element is written at the next free position of the output, which
+ * only advances when the predicate holds: there is no branch to mispredict.
+ *
+ * @param data Pointer to the elements.
+ * @param n Number of elements.
+ * @param pred The predicate.
+ * @param out Pointer to the output, with room for n elements. It can be
+ * 'data' itself.
+ *
+ * @return The number of elements copied, in order, at the front of 'out'.
+*/
+template <typename T, typename Predicate>
+size_t scalar_compress(const T* data, size_t n, const Predicate& pred, T* out) {
+  size_t k = 0;
+  for (size_t i = 0; i < n; ++i) {
+    T value = data[i];
+    out[k] = value;
+    k += pred(value) ? 1 : 0;
+  }
+  return k;
+}
+
+#ifdef SET_SIMD_X86
+
+/**
+ * @brief Tells if the CPU supports AVX2.
+ *
+ * @return true if the AVX2 kernels can be used. Detected once.
+*/
+inline bool cpu_has_avx2() {
+  static const bool avx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+  return avx2;
+}
+
+/**
+ * @brief Lane operations of the SSE2 and AVX2 kernels, by element type.
+ *
+ * splat() broadcasts a value to every lane, eq() sets to all ones the lanes
+ * of two registers that are equal, lt() and le() the lanes where the first
+ * one is lower (or equal) than the second one. They return integer
+ * registers, so that _mm_movemask_epi8 gives one bit per byte of the
+ * matching lanes. Only the 4 and 8 byte lanes can be ordered.
+ *
+ * @tparam T Type of the elements.
+ * @tparam Size sizeof(T).
+ * @tparam Float Whether T is a floating point type.
+*/
+template <typename T, size_t Size = sizeof(T), bool Float = std::is_floating_point<T>::value>
+struct SimdLanes;
+
+/**
+ * @brief Lane operations of the 1 byte integers.
+*/
+template <typename T>
+struct SimdLanes<T, 1, false> {
+#ifdef __SSE2__
+  static __m128i splat128(T v) { return _mm_set1_epi8(static_cast<char>(v)); }
+  static __m128i eq128(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(T v) { return _mm256_set1_epi8(static_cast<char>(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+};
+
+/**
+ * @brief Lane operations of the 2 byte integers.
+*/
+template <typename T>
+struct SimdLanes<T, 2, false> {
+#ifdef __SSE2__
+  static __m128i splat128(T v) { return _mm_set1_epi16(static_cast<short>(v)); }
+  static __m128i eq128(__m128i a, __m128i b) { return _mm_cmpeq_epi16(a, b); }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(T v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) { return _mm256_cmpeq_epi16(a, b); }
+};
+
+/**
+ * @brief Lane operations of the 4 byte integers.
+*/
+template <typename T>
+struct SimdLanes<T, 4, false> {
+#ifdef __SSE2__
+  static __m128i splat128(T v) { return _mm_set1_epi32(static_cast<int>(v)); }
+  static __m128i eq128(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(T v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+  SET_SIMD_AVX2 static __m256i lt256(__m256i a, __m256i b) {
+    // Unsigned lanes are ordered as signed ones once their sign bit is flipped
+    __m256i bias = _mm256_slli_epi32(_mm256_set1_epi32(std::is_signed<T>::value ? 0 : 1), 31);
+    return _mm256_cmpgt_epi32(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+  }
+  SET_SIMD_AVX2 static __m256i le256(__m256i a, __m256i b) {
+    return _mm256_xor_si256(lt256(b, a), _mm256_set1_epi32(-1));
+  }
+};
+
+/**
+ * @brief Lane operations of the 8 byte integers.
+ *
+ * SSE2 has no 64 bit comparison: two 32 bit halves are equal when both
+ * halves are.
+*/
+template <typename T>
+struct SimdLanes<T, 8, false> {
+#ifdef __SSE2__
+  static __m128i splat128(T v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+  static __m128i eq128(__m128i a, __m128i b) {
+    __m128i halves = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(T v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+  SET_SIMD_AVX2 static __m256i lt256(__m256i a, __m256i b) {
+    __m256i bias = _mm256_slli_epi64(_mm256_set1_epi64x(std::is_signed<T>::value ? 0 : 1), 63);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, bias), _mm256_xor_si256(a, bias));
+  }
+  SET_SIMD_AVX2 static __m256i le256(__m256i a, __m256i b) {
+    return _mm256_xor_si256(lt256(b, a), _mm256_set1_epi64x(-1));
+  }
+};
+
+/**
+ * @brief Lane operations of float.
+*/
+template <>
+struct SimdLanes<float, 4, true> {
+#ifdef __SSE2__
+  static __m128i splat128(float v) { return _mm_castps_si128(_mm_set1_ps(v)); }
+  static __m128i eq128(__m128i a, __m128i b) {
+    return _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+  }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(float v) { return _mm256_castps_si256(_mm256_set1_ps(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+  }
+  SET_SIMD_AVX2 static __m256i lt256(__m256i a, __m256i b) {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_LT_OQ));
+  }
+  SET_SIMD_AVX2 static __m256i le256(__m256i a, __m256i b) {
+    return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_LE_OQ));
+  }
+};
+
+/**
+ * @brief Lane operations of double.
+*/
+template <>
+struct SimdLanes<double, 8, true> {
+#ifdef __SSE2__
+  static __m128i splat128(double v) { return _mm_castpd_si128(_mm_set1_pd(v)); }
+  static __m128i eq128(__m128i a, __m128i b) {
+    return _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+  }
+#endif
+  SET_SIMD_AVX2 static __m256i splat256(double v) { return _mm256_castpd_si256(_mm256_set1_pd(v)); }
+  SET_SIMD_AVX2 static __m256i eq256(__m256i a, __m256i b) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+  }
+  SET_SIMD_AVX2 static __m256i lt256(__m256i a, __m256i b) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_LT_OQ));
+  }
+  SET_SIMD_AVX2 static __m256i le256(__m256i a, __m256i b) {
+    return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_LE_OQ));
+  }
+};
+
+#ifdef __SSE2__
+/**
+ * @brief scalar_find() with SSE2: 16 bytes of elements per comparison, two
+ * registers per iteration.
+*/
+template <typename T>
+size_t sse2_find(const T* data, size_t n, T value) {
+  typedef SimdLanes<T> Lanes;
+  const size_t LANES = 16 / sizeof(T);
+  const __m128i needle = Lanes::splat128(value);
+  size_t i = 0;
+  for (; i + 2 * LANES <= n; i += 2 * LANES) {
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + LANES));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(Lanes::eq128(lo, needle))) |
+                    static_cast<unsigned>(_mm_movemask_epi8(Lanes::eq128(hi, needle))) << 16;
+    if (mask != 0) return i + __builtin_ctz(mask) / sizeof(T);
+  }
+  return i + detail::scalar_find(data + i, n - i, value);
+}
+#endif
+
+/**
+ * @brief scalar_find() with AVX2: 32 bytes of elements per comparison, two
+ * registers per iteration.
+*/
+template <typename T>
+SET_SIMD_AVX2 size_t avx2_find(const T* data, size_t n, T value) {
+  typedef SimdLanes<T> Lanes;
+  const size_t LANES = 32 / sizeof(T);
+  const __m256i needle = Lanes::splat256(value);
+  size_t i = 0;
+  for (; i + 2 * LANES <= n; i += 2 * LANES) {
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + LANES));
+    unsigned long long mask =
+      static_cast<unsigned>(_mm256_movemask_epi8(Lanes::eq256(lo, needle))) |
+      static_cast<unsigned long long>(static_cast<unsigned>(_mm256_movemask_epi8(Lanes::eq256(hi, needle)))) << 32;
+    if (mask != 0) return i + __builtin_ctzll(mask) / sizeof(T);
+  }
+  return i + detail::scalar_find(data + i, n - i, value);
+}
+
+/**
+ * @brief Evaluation of a predicate on every lane of an AVX2 register.
+ *
+ * The constructor broadcasts the operands of the predicate, operator() sets
+ * to all ones the lanes of the elements satisfying it.
+ *
+ * @tparam Predicate Type of the predicate, with SimdPredicate true.
+*/
+template <typename Predicate>
+struct SimdTest;
+
+/**
+ * @brief SimdTest of InRange.
+*/
+template <typename T>
+struct SimdTest<InRange<T> > {
+  typedef SimdLanes<T> Lanes; ///< Lane operations of T
+  __m256i lo; ///< Lowest value, in every lane
+  __m256i hi; ///< Highest value, in every lane
+  SET_SIMD_AVX2 explicit SimdTest(const InRange<T>& pred)
+    : lo(Lanes::splat256(pred.lo)), hi(Lanes::splat256(pred.hi)) {}
+  SET_SIMD_AVX2 __m256i operator()(__m256i x) const {
+    return _mm256_and_si256(Lanes::le256(lo, x), Lanes::le256(x, hi));
+  }
+};
+
+/**
+ * @brief SimdTest of LessThan.
+*/
+template <typename T>
+struct SimdTest<LessThan<T> > {
+  typedef SimdLanes<T> Lanes; ///< Lane operations of T
+  __m256i bound; ///< Threshold, in every lane
+  SET_SIMD_AVX2 explicit SimdTest(const LessThan<T>& pred) : bound(Lanes::splat256(pred.bound)) {}
+  SET_SIMD_AVX2 __m256i operator()(__m256i x) const { return Lanes::lt256(x, bound); }
+};
+
+/**
+ * @brief SimdTest of GreaterThan.
+*/
+template <typename T>
+struct SimdTest<GreaterThan<T> > {
+  typedef SimdLanes<T> Lanes; ///< Lane operations of T
+  __m256i bound; ///< Threshold, in every lane
+  SET_SIMD_AVX2 explicit SimdTest(const GreaterThan<T>& pred) : bound(Lanes::splat256(pred.bound)) {}
+  SET_SIMD_AVX2 __m256i operator()(__m256i x) const { return Lanes::lt256(bound, x); }
+};
+
+/**
+ * @brief SimdTest of Modulo, for 4 byte signed integers.
+ *
+ * There is no integer division instruction: the quotients are computed in
+ * double precision. Since the values and the divisor have at most 31 bits,
+ * the rounding error is far below the distance of a quotient from the
+ * nearest integer, so truncating gives the exact quotient of /.
+*/
+template <typename T>
+struct SimdTest<Modulo<T> > {
+  __m256d divisor; ///< Divisor, in every double lane
+  __m256i divisor32; ///< Divisor, in every lane
+  __m256i remainder; ///< Remainder, in every lane
+  SET_SIMD_AVX2 explicit SimdTest(const Modulo<T>& pred)
+    : divisor(_mm256_set1_pd(pred.divisor)), divisor32(_mm256_set1_epi32(pred.divisor)),
+      remainder(_mm256_set1_epi32(pred.remainder)) {}
+  SET_SIMD_AVX2 __m256i operator()(__m256i x) const {
+    __m128i lo = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(x)), divisor));
+    __m128i hi = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(x, 1)), divisor));
+    __m256i quotient = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    return _mm256_cmpeq_epi32(_mm256_sub_epi32(x, _mm256_mullo_epi32(quotient, divisor32)), remainder);
+  }
+};
+
+/**
+ * @brief Permutation moving the 4 byte lanes selected by a mask to the front
+ * of an AVX2 register, in order.
+ *
+ * @param mask One bit per lane, as given by _mm256_movemask_ps.
+ *
+ * @return The indexes for _mm256_permutevar8x32_epi32.
+*/
+SET_SIMD_AVX2 inline __m256i compress_permutation(unsigned mask) {
+  struct Table {
+    unsigned char index[256][8];
+    Table() {
+      for (unsigned m = 0; m < 256; ++m) {
+        unsigned k = 0;
+        for (unsigned lane = 0; lane < 8; ++lane) {
+          if (m & (1u << lane)) index[m][k++] = static_cast<unsigned char>(lane);
+        }
+        for (; k < 8; ++k) index[m][k] = 0;
+      }
+    }
+  };
+  static const Table table;
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.index[mask])));
+}
+
+/**
+ * @brief scalar_compress() with AVX2: the predicate is evaluated on 32 bytes
+ * of elements at a time, and the selected ones are packed to the front of
+ * the register and stored at once.
+ *
+ * The 8 byte lanes are moved as pairs of 4 byte lanes: their comparison
+ * sets both halves, so _mm256_movemask_ps gives two bits per element.
+*/
+template <typename T, typename Predicate>
+SET_SIMD_AVX2 size_t avx2_compress(const T* data, size_t n, const Predicate& pred, T* out) {
+  const size_t LANES = 32 / sizeof(T);
+  const SimdTest<Predicate> test(pred);
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + LANES <= n; i += LANES) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(test(x))));
+    // Writes a whole register, but k <= i: the extra lanes stay below data + n
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k),
+                        _mm256_permutevar8x32_epi32(x, detail::compress_permutation(mask)));
+    k += __builtin_popcount(mask) * 4 / sizeof(T);
+  }
+  return k + detail::scalar_compress(data + i, n - i, pred, out + k);
+}
+
+#endif // SET_SIMD_X86
+
+/**
+ * @brief Finds the first element equal to a value, with the widest kernel
+ * supported by the CPU.
+ *
+ * @param data Pointer to the elements.
+ * @param n Number of elements.
+ * @param value The searched value.
+ *
+ * @return The position of the first element equal to 'value', n if none.
+ *
+ * @pre SimdEqual<T, std::equal_to<T> >::value is true.
+*/
+template <typename T>
+size_t simd_find(const T* data, size_t n, T value) {
+#ifdef SET_SIMD_X86
+  if (detail::cpu_has_avx2()) return detail::avx2_find(data, n, value);
+#ifdef __SSE2__
+  return detail::sse2_find(data, n, value);
+#endif
+#endif
+  return detail::scalar_find(data, n, value);
+}
+
+/**
+ * @brief Copies the elements satisfying a predicate, with the widest kernel
+ * supported by the CPU.
+ *
+ * @param data Pointer to the elements.
+ * @param n Number of elements.
+ * @param pred The predicate.
+ * @param out Pointer to the output, with room for n elements. It can be
+ * 'data' itself.
+ *
+ * @return The number of elements copied, in order, at the front of 'out'.
+ *
+ * @pre SimdPredicate<T, Predicate>::value is true.
+*/
+template <typename T, typename Predicate>
+size_t simd_compress(const T* data, size_t n, const Predicate& pred, T* out) {
+#ifdef SET_SIMD_X86
+  if (detail::cpu_has_avx2()) return detail::avx2_compress(data, n, pred, out);
+#endif
+  return detail::scalar_compress(data, n, pred, out);
+}
+
+} // namespace detail
+
+#endif // SIMD_HPP
@@ -0,0 +1,891 @@
+/**
+ * @file small_set.hpp
+ *
+ * @brief Header file for the templated SmallSet class.
+ *
+ * Declaration/Definition of the templated SmallSet class, a sibling of Set
+ * storing its first elements inside the object.
+*/
+
+#ifndef SMALL_SET_HPP
+#define SMALL_SET_HPP
+
+#include <iostream>
+#include <algorithm> // std::swap
+#include <ostream> // std::ostream
+#include <stdexcept> // std::out_of_range
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <fstream> // std::ofstream
+#include <utility> // std::move, std::forward, std::move_if_noexcept
+#include <new> // placement new
+#include <type_traits> // std::integral_constant, std::is_nothrow_move_constructible
+#include "raw_storage.hpp"
+#include "simd.hpp"
+
+/**
+ * @brief SmallSet Class
+ *
+ * Generic Set of type T elements, with the same interface of Set. Up to N
+ * elements are stored in a buffer inside the object itself, so a SmallSet
+ * that never holds more than N elements does not allocate any memory, and
+ * its elements are next to its other members. When the (N + 1)-th element is
+ * added, the elements spill to a dynamic array twice as large; from then on
+ * the array is doubled in size when full and halved when only one quarter or
+ * less of its capacity is being used, going back to the inline buffer when N
+ * elements fit again.
+ *
+ * The elements are kept in insertion order (remove() moves the last element
+ * into the hole) and searched linearly, with the SIMD kernels of simd.hpp
+ * for the arithmetic types compared with std::equal_to.
+ *
+ * @tparam T Type of the elements in the SmallSet.
+ * @tparam Equal Functor used for comparing two elements for equality. Returns
+ * true if the elements passed are equal, false otherwhise.
+ * @tparam N Number of elements stored inline, greater than 0.
+ *
+ * @note Moving or swapping a SmallSet that is stored inline moves its
+ * elements one at a time, and iterators to them are invalidated, unlike Set.
+*/
+template <typename T, typename Equal, size_t N = 8>
+class SmallSet {
+  static_assert(N > 0, "SmallSet requires an inline capacity");
+
+private:
+  T* _array; ///< Pointer to the elements: the inline buffer or a dynamic array
+  size_t _size; ///< Capacity of the array (N while the inline buffer is used)
+  size_t _num_elements; ///< Number of elements currently in the SmallSet
+  Equal _equal; ///< Instance of the Equal functor
+  alignas(T) unsigned char _buffer[N * sizeof(T)]; ///< Inline storage (raw beyond _num_elements)
+
+  /**
+   * @brief Pointer to the inline buffer.
+  */
+  T* buffer() {
+    return reinterpret_cast<T*>(_buffer);
+  }
+
+  /**
+   * @brief Finds the position of an element.
+   *
+   * @param value The element to search for.
+   *
+   * @return The position of the element in the array, or _num_elements.
+  */
+  size_t find(const T& value) const {
+    return find(value, std::integral_constant<bool, SimdEqual<T, Equal>::value>());
+  }
+
+  /**
+   * @brief find() with the SIMD kernels.
+  */
+  size_t find(const T& value, std::true_type) const {
+    return detail::simd_find(_array, _num_elements, value);
+  }
+
+  /**
+   * @brief find() with the Equal functor.
+  */
+  size_t find(const T& value, std::false_type) const {
+    for (size_t i = 0; i < _num_elements; ++i) {
+      if (_equal(_array[i], value)) {
+        return i;
+      }
+    }
+    return _num_elements;
+  }
+
+  /**
+   * @brief Moves the elements into another storage, destroying the originals.
+   *
+   * The elements are moved if their move constructor does not throw (or if
+   * they cannot be copied), copied otherwise.
+   *
+   * @param storage Uninitialized storage for _num_elements elements.
+   *
+   * @throw Any exception thrown by the copy constructor of the elements. The
+   * elements are unchanged, and nothing is left in 'storage', in that case.
+  */
+  void transfer(T* storage) {
+    size_t i = 0;
+    try {
+      for (; i < _num_elements; ++i) {
+        ::new (static_cast<void*>(storage + i)) T(std::move_if_noexcept(_array[i]));
+      }
+    } catch (...) {
+      detail::destroy(storage, storage + i);
+      throw;
+    }
+    detail::destroy(_array, _array + _num_elements);
+  }
+
+  /**
+   * @brief Takes the elements of another SmallSet.
+   *
+   * A dynamic array is taken over without copying any element; the elements
+   * of an inline buffer are moved one at a time.
+   *
+   * @param other The SmallSet from which to take the elements.
+   *
+   * @pre This SmallSet is empty and uses its inline buffer.
+   * @post other is empty.
+  */
+  void take(SmallSet& other) {
+    if (other._array == other.buffer()) {
+      other.transfer(buffer());
+      _num_elements = other._num_elements;
+    } else {
+      _array = other._array;
+      _size = other._size;
+      _num_elements = other._num_elements;
+      other._array = other.buffer();
+      other._size = N;
+    }
+    other._num_elements = 0;
+  }
+
+  /**
+   * @brief Resizes the array used by the SmallSet.
+   *
+   * The elements are moved to a dynamic array twice as large, or half as
+   * large, or back to the inline buffer when the new capacity is N. The
+   * elements are relocated last, so that if anything throws the SmallSet is
+   * left unchanged.
+   *
+   * @param increase A boolean indicating whether to increase (true) or
+   * decrease (false) the array size.
+   *
+   * @throw Allocation exception.
+  */
+  void resize(bool increase) {
+    size_t new_size = increase ? _size * 2 : std::max(_size / 2, N);
+    if (new_size == _size) return;
+
+    T* storage = nullptr;
+    try {
+      if (new_size == N) {
+        transfer(buffer());
+        detail::deallocate(_array, _size);
+        _array = buffer();
+      } else if (_array == buffer()) {
+        storage = detail::allocate<T>(new_size);
+        transfer(storage);
+        _array = storage;
+      } else {
+        _array = detail::relocate(_array, _num_elements, _size, new_size);
+      }
+      _size = new_size;
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in resize: " << e.what() << '\n';
+      detail::deallocate(storage, new_size); // Clean up new array in case of exception
+      throw; // Re-throw the exception
+    }
+  }
+
+  /**
+   * @brief Adds a new element to the SmallSet, copying or moving it.
+   *
+   * @param value The element to be added, forwarded to the array.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename U>
+  bool insert(U&& value) {
+    if (find(value) != _num_elements) {
+      return false;
+    }
+
+    if (_num_elements == _size) {
+      resize(true);
+    }
+
+    ::new (static_cast<void*>(_array + _num_elements)) T(std::forward<U>(value));
+    ++_num_elements;
+    return true;
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty SmallSet using its inline buffer. No memory is
+   * allocated.
+   *
+   * @post capacity() == N
+   * @post _num_elements == 0
+  */
+  SmallSet() : _array(buffer()), _size(N), _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Creates a new SmallSet by copying the elements from another SmallSet. The
+   * copy uses its inline buffer if the elements fit.
+   *
+   * @param other SmallSet from which to copy the elements.
+   *
+   * @throw Allocation exception, or any exception thrown by the copy
+   * constructor of T.
+  */
+  SmallSet(const SmallSet& other)
+    : _array(buffer()), _size(N), _num_elements(0), _equal(other._equal) {
+    try {
+      if (other._num_elements > N) {
+        _array = detail::allocate<T>(other._size);
+        _size = other._size;
+      }
+      detail::copy_construct(other._array, other._array + other._num_elements, _array);
+      _num_elements = other._num_elements;
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
+      empty(); // Clean up array in case of exception
+      throw;
+    }
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * Assigns the content of the specified 'other' SmallSet to this SmallSet.
+   * It creates a copy of the 'other' SmallSet and then moves it into this
+   * SmallSet.
+   *
+   * @param other The SmallSet object to be copied.
+   *
+   * @return A reference to this SmallSet after the assignment.
+   *
+   * @throw Allocation exception, or any exception thrown by the copy
+   * constructor of T.
+  */
+  SmallSet& operator=(const SmallSet& other) {
+    if (&other != this) {
+      SmallSet tmp(other);
+      *this = std::move(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new SmallSet by taking over the dynamic array of another
+   * SmallSet, or by moving the elements of its inline buffer.
+   *
+   * @param other SmallSet from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  SmallSet(SmallSet&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    : _array(buffer()), _size(N), _num_elements(0), _equal(other._equal) {
+    take(other);
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the elements of this SmallSet and takes the ones of 'other', as
+   * the move constructor does.
+   *
+   * @param other The SmallSet from which to take the elements.
+   *
+   * @return A reference to this SmallSet after the assignment.
+   *
+   * @post other is empty.
+  */
+  SmallSet& operator=(SmallSet&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    if (&other != this) {
+      empty();
+      _equal = other._equal;
+      take(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   *
+   * Safely deallocates the dynamic memory used by the SmallSet, if any.
+   * Utilizes the empty() function to do so.
+   *
+   * @post The internal memory has been deallocated.
+  */
+  ~SmallSet() {
+    empty();
+  }
+
+  /**
+   * @brief Empties the SmallSet.
+   *
+   * Destroys the elements and deallocates the dynamic array, if any: the
+   * SmallSet goes back to its inline buffer.
+   *
+   * @post The internal memory has been deallocated.
+   * @post _num_elements = 0
+   * @post capacity() == N
+  */
+  void empty(void) {
+    detail::destroy(_array, _array + _num_elements);
+    if (_array != buffer()) {
+      detail::deallocate(_array, _size);
+    }
+    _array = buffer();
+    _num_elements = 0;
+    _size = N;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * Swaps the state between the current instance of SmallSet and the
+   * instance provided as a parameter. Two dynamic arrays are just exchanged;
+   * the elements of inline buffers are moved.
+   *
+   * @param other The SmallSet instance to swap states with the current
+   * instance.
+  */
+  void swap(SmallSet& other) {
+    if (&other == this) return;
+    std::swap(_equal, other._equal);
+    if (_array != buffer() && other._array != other.buffer()) {
+      std::swap(_num_elements, other._num_elements);
+      std::swap(_size, other._size);
+      std::swap(_array, other._array);
+      return;
+    }
+    SmallSet tmp(std::move(other));
+    other.take(*this);
+    take(tmp);
+  }
+
+  /**
+   * @brief Adds a new element to the SmallSet.
+   *
+   * Inserts the value into the SmallSet if it is not already present.
+   * If the array gets full, the elements spill to a dynamic array (doubled in
+   * size).
+   *
+   * @param value The element of type T to be added to the SmallSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @note If an exception is thrown during resizing, the state of SmallSet
+   * hasn't been changed yet, mantaining the SmallSet in a consistent state.
+  */
+  bool add(const T& value) {
+    return insert(value);
+  }
+
+  /**
+   * @brief Adds a new element to the SmallSet, moving it.
+   *
+   * Same as add(const T&), but the value is moved into the array instead of
+   * being copied. If the value is already contained, it is left untouched.
+   *
+   * @param value The element of type T to be moved into the SmallSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    return insert(std::move(value));
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the
+   * SmallSet.
+   *
+   * The element is constructed once, searched and then moved into the array.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  /**
+   * @brief Removes an element from the SmallSet.
+   *
+   * If the value is present in the SmallSet, it is removed. If the element is
+   * not found, the SmallSet remains unchanged. A dynamic array is shrunk if it
+   * becomes significantly underutilized as a result of the removal, down to
+   * the inline buffer.
+   *
+   * @param value The element of type T to be removed from the SmallSet.
+   *
+   * @return true if the element was removed, false if it is not contained.
+   *
+   * @note If an exception is thrown during resizing, the element will still
+   * be removed, but the internal array may not be resized. By doing this, the
+   * SmallSet will mantain a consistent state.
+  */
+  bool remove(const T& value) {
+    size_t pos = find(value);
+    if (pos == _num_elements) {
+      return false;
+    }
+
+    // Overwrite the removed element with the last element in the array
+    size_t last = _num_elements - 1;
+    if (pos != last) {
+      _array[pos] = std::move(_array[last]);
+    }
+    _array[last].~T();
+    --_num_elements;
+
+    if (_size > N && _num_elements <= _size / 4) {
+      resize(false);
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Accesses the element at the specified index.
+   *
+   * Provides read-only access to the element at the given index.
+   *
+   * @param index The index of the element to access.
+   *
+   * @return A const reference to the element at the specified index.
+   *
+   * @throw std::out_of_range If the index is out of the bounds of the
+   * SmallSet.
+  */
+  const T& operator[](int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= _num_elements) {
+      throw std::out_of_range("Index out of range");
+    }
+    return _array[index];
+  }
+
+  /**
+   * @brief Checks if the SmallSet contains a specific element.
+   *
+   * Scans the array, comparing each element with the given value using the
+   * custom equality functor (or the SIMD kernels, see SimdEqual).
+   *
+   * @param value The element to search for in the SmallSet.
+   *
+   * @return true if the element is found in the SmallSet, false otherwise.
+  */
+  bool contains(const T& value) const {
+    return find(value) != _num_elements;
+  }
+
+  /**
+   * Returns the number of elements stored inside of the SmallSet
+   *
+   * @return number of elements stored inside of the SmallSet
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Returns the capacity of the array.
+   *
+   * @return The number of elements the SmallSet can hold before resizing:
+   * N while the inline buffer is used.
+  */
+  size_t capacity() const {
+    return _size;
+  }
+
+  /**
+   * @brief Tells if the elements are stored in the inline buffer.
+   *
+   * @return true if the SmallSet does not own any dynamic memory.
+  */
+  bool is_inline() const {
+    return _array == reinterpret_cast<const T*>(_buffer);
+  }
+
+  /**
+   * @brief Constant forward iterator for the SmallSet class.
+   *
+   * This iterator provides read-only access to the elements of the SmallSet,
+   * in the order in which they are stored in the array.
+  */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef const T* pointer; ///< Pointer to the constant element type
+    typedef const T& reference; ///< Reference to the constant element type
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes the iterator to a null pointer.
+    */
+    const_iterator() : _ptr(nullptr) {}
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @param other Another const_iterator to be copied.
+    */
+    const_iterator(const const_iterator &other) : _ptr(other._ptr) {}
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @param other Another const_iterator to be assigned from.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator=(const const_iterator &other) {
+      _ptr = other._ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Destructor.
+    */
+    ~const_iterator() {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return A reference to the element pointed to by the iterator.
+    */
+    reference operator*() const { return *_ptr; }
+
+    /**
+     * @brief Arrow operator.
+     *
+     * @return A pointer to the element pointed to by the iterator.
+    */
+    pointer operator->() const { return _ptr; }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator++() {
+      ++_ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return Copy of the original iterator.
+    */
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if both iterators point to same element, false otherwise.
+    */
+    bool operator==(const const_iterator &other) const {
+      return _ptr == other._ptr;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if iterators point to different element, false otherwise.
+    */
+    bool operator!=(const const_iterator &other) const {
+      return _ptr != other._ptr;
+    }
+
+  private:
+    pointer _ptr; ///< Pointer to the current element in the SmallSet.
+
+    friend class SmallSet; ///< Allow SmallSet class to access private constructor.
+
+    /**
+     * @brief Constructor for internal use by the SmallSet class.
+     *
+     * @param ptr Pointer to the current element in the SmallSet.
+    */
+    const_iterator(pointer ptr) : _ptr(ptr) {}
+
+  }; //const_iterator class
+
+  /**
+   * @brief Returns an iterator to the beginning of the SmallSet.
+   *
+   * @return A const_iterator to the first element of the SmallSet.
+  */
+  const_iterator begin() const {
+    return const_iterator(_array);
+  }
+
+  /**
+   * @brief Returns an iterator to the end of the SmallSet.
+   *
+   * @return A const_iterator to the element following the last element of the
+   * SmallSet.
+  */
+  const_iterator end() const {
+    return const_iterator(_array + _num_elements);
+  }
+
+  /**
+   * Constructor that creates a SmallSet from a range defined by two iterators.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+  */
+  template <typename IteratorQ>
+  SmallSet(IteratorQ begin, IteratorQ end) : _array(buffer()), _size(N), _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        add(*it);
+      }
+    } catch (const std::exception& e) {
+      empty();
+      std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Stream operator for the SmallSet class.
+   *
+   * The output format is the same of Set: the number of elements followed by
+   * each element between round brackets.
+   *
+   * @param os The output stream to which the SmallSet data will be sent.
+   * @param set The SmallSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the SmallSet data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const SmallSet& set) {
+    os << set._num_elements;
+    for (size_t i = 0; i < set._num_elements; ++i) {
+      os << " (" << set._array[i] << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for SmallSet.
+   *
+   * Two SmallSets are considered equal if they contain the same elements,
+   * regardless of their order or of where they are stored.
+   *
+   * @param other The SmallSet to compare with.
+   *
+   * @return True if the SmallSets contain the same elements, false otherwise.
+  */
+  bool operator==(const SmallSet& other) const {
+    if (_num_elements != other._num_elements) return false;
+
+    for (size_t i = 0; i < other._num_elements; ++i) {
+      if (!contains(other._array[i])) return false;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a SmallSet, based on a predicate.
+ *
+ * This function creates a new SmallSet containing elements from the original
+ * SmallSet that satisfy the given predicate.
+ *
+ * @param S The original SmallSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new SmallSet.
+ *
+ * @return A new SmallSet containing elements that satisfy the predicate P.
+*/
+template <typename T, typename Equal, size_t N, typename Predicate>
+SmallSet<T, Equal, N> filter_out(const SmallSet<T, Equal, N>& S, Predicate P) {
+  SmallSet<T, Equal, N> new_set;
+  try {
+    for (typename SmallSet<T, Equal, N>::const_iterator it = S.begin(); it != S.end(); ++it) {
+      if (P(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the addition operator to concatenate two SmallSets.
+ *
+ * Creates a new SmallSet that represents the union of 'a' and 'b': a copy of
+ * 'a' followed by the elements of 'b' that are not in 'a'.
+ *
+ * @param a The first SmallSet to be concatenated.
+ * @param b The second SmallSet to be concatenated.
+ *
+ * @return A new SmallSet containing all elements from both 'a' and 'b', with
+ * duplicates removed.
+*/
+template <typename T, typename Equal, size_t N>
+SmallSet<T, Equal, N> operator+(const SmallSet<T, Equal, N>& a, const SmallSet<T, Equal, N>& b) {
+  SmallSet<T, Equal, N> new_set = a;
+  try {
+    for (typename SmallSet<T, Equal, N>::const_iterator it = b.begin(); it != b.end(); ++it) {
+      new_set.add(*it);
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in operator+: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the intersection of two SmallSets.
+ *
+ * This function creates a new SmallSet containing the elements of 'a' that
+ * are also present in 'b', in the order in which they are stored in 'a'.
+ *
+ * @param a The first SmallSet to intersect.
+ * @param b The second SmallSet to intersect.
+ *
+ * @return A new SmallSet containing the intersection of 'a' and 'b'.
+*/
+template <typename T, typename Equal, size_t N>
+SmallSet<T, Equal, N> intersection(const SmallSet<T, Equal, N>& a, const SmallSet<T, Equal, N>& b) {
+  SmallSet<T, Equal, N> new_set;
+  try {
+    for (typename SmallSet<T, Equal, N>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of
+ * two SmallSets.
+ *
+ * Same as intersection(a, b).
+ *
+ * @param a The first SmallSet to intersect.
+ * @param b The second SmallSet to intersect.
+ *
+ * @return A new SmallSet containing the intersection of 'a' and 'b'.
+ *
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <typename T, typename Equal, size_t N>
+SmallSet<T, Equal, N> operator-(const SmallSet<T, Equal, N>& a, const SmallSet<T, Equal, N>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two SmallSets.
+ *
+ * Creates a new SmallSet with the elements of 'a' that are not contained in
+ * 'b', in the order in which they are stored in 'a'.
+ *
+ * @param a The SmallSet whose elements are kept.
+ * @param b The SmallSet whose elements are removed.
+ *
+ * @return A new SmallSet containing a \ b.
+*/
+template <typename T, typename Equal, size_t N>
+SmallSet<T, Equal, N> difference(const SmallSet<T, Equal, N>& a, const SmallSet<T, Equal, N>& b) {
+  SmallSet<T, Equal, N> new_set;
+  try {
+    for (typename SmallSet<T, Equal, N>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (!b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the symmetric difference of two SmallSets.
+ *
+ * Creates a new SmallSet with the elements of 'a' not contained in 'b',
+ * followed by the elements of 'b' not contained in 'a'.
+ *
+ * @param a The first SmallSet.
+ * @param b The second SmallSet.
+ *
+ * @return A new SmallSet containing (a \ b) U (b \ a).
+*/
+template <typename T, typename Equal, size_t N>
+SmallSet<T, Equal, N> symmetric_difference(const SmallSet<T, Equal, N>& a, const SmallSet<T, Equal, N>& b) {
+  SmallSet<T, Equal, N> new_set;
+  try {
+    for (typename SmallSet<T, Equal, N>::const_iterator it = a.begin(); it != a.end(); ++it) {
+      if (!b.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+    for (typename SmallSet<T, Equal, N>::const_iterator it = b.begin(); it != b.end(); ++it) {
+      if (!a.contains(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Saves the contents of a SmallSet to a file.
+ *
+ * This function writes the contents of a given SmallSet to a file specified
+ * by 'filename'. The SmallSet is output using the overriden 'operator<<'.
+ *
+ * @param set The SmallSet to be saved to the file.
+ * @param filename The name of the file to which the SmallSet's contents will
+ *                 be saved.
+ *
+ * @note The function does not return a value or throw exceptions, but it
+ * reports to stderr if the file cannot be opened.
+*/
+template <typename Equal, size_t N>
+void save(const SmallSet<std::string, Equal, N>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+#endif // SMALL_SET_HPP
@@ -0,0 +1,833 @@
+/**
+ * @file sorted_set.hpp
+ *
+ * @brief Header file for the templated SortedSet class.
+ *
+ * Declaration/Definition of the templated SortedSet class, an ordered sibling
+ * of Set.
+*/
+
+#ifndef SORTED_SET_HPP
+#define SORTED_SET_HPP
+
+#include <iostream>
+#include <algorithm> // std::swap, std::lower_bound, std::stable_sort, std::move_backward
+#include <functional> // std::less
+#include <ostream> // std::ostream
+#include <stdexcept> // std::out_of_range
+#include <iterator> // std::forward_iterator_tag
+#include <cstddef> // std::ptrdiff_t, size_t
+#include <fstream> // std::ofstream
+#include <utility> // std::move, std::forward
+#include <new> // placement new
+#include "raw_storage.hpp"
+
+/**
+ * @brief SortedSet Class
+ *
+ * Generic Set of type T elements, with the same interface of Set. The
+ * elements are kept sorted in the dynamic array according to the Less
+ * comparator, and two elements are considered equal when neither is less
+ * than the other. Therefore:
+ * - contains is a binary search;
+ * - operator+, operator- and operator== are linear time merges;
+ * - iteration, operator<< and save always list the elements in ascending
+ *   order, independently of the order of insertion and removal.
+ * The array is doubled in size when full and halved when only one quarter or
+ * less of its capacity is being used.
+ *
+ * @tparam T Type of the elements in the SortedSet.
+ * @tparam Less Functor defining a strict weak ordering of the elements.
+ * Returns true if the first element passed precedes the second one.
+*/
+template <typename T, typename Less = std::less<T> >
+class SortedSet {
+private:
+  T* _array; ///< Pointer to the array, sorted by Less (raw storage beyond _num_elements)
+  size_t _size; ///< Capacity of the array (at a given moment)
+  size_t _num_elements; ///< Number of elements currently in the SortedSet
+  Less _less; ///< Instance of the Less functor
+
+  /**
+   * @brief Resizes the dynamic array used by the SortedSet.
+   *
+   * @param increase A boolean indicating whether to increase (true) or
+   * decrease (false) the array size.
+   *
+   * @throw Allocation exception.
+  */
+  void resize(bool increase) {
+    size_t new_size;
+    if (increase) {
+      new_size = _size > 0 ? _size * 2 : 1;
+    } else {
+      new_size = _size / 2;
+    }
+
+    try {
+      _array = detail::relocate(_array, _num_elements, _size, new_size);
+      _size = new_size;
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in resize: " << e.what() << '\n';
+      throw; // Re-throw the exception
+    }
+  }
+
+  /**
+   * @brief Finds the first element not less than a value.
+   *
+   * @param value The value to search for.
+   *
+   * @return The position of the first element not less than value, or the
+   * number of elements if there is none.
+  */
+  size_t lower_bound(const T& value) const {
+    return std::lower_bound(_array, _array + _num_elements, value, _less) - _array;
+  }
+
+  /**
+   * @brief Checks if the element at a position is equivalent to a value.
+   *
+   * @param pos A position returned by lower_bound(value).
+   * @param value The value to compare with.
+   *
+   * @return true if pos is a valid position holding an element equivalent to
+   * value.
+  */
+  bool found(size_t pos, const T& value) const {
+    return pos < _num_elements && !_less(value, _array[pos]);
+  }
+
+  /**
+   * @brief Adds a new element to the SortedSet, copying or moving it.
+   *
+   * @param value The element to be added, forwarded to the array.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename U>
+  bool insert(U&& value) {
+    size_t pos = _num_elements;
+    if (_num_elements > 0 && !_less(_array[_num_elements - 1], value)) {
+      pos = lower_bound(value);
+      if (found(pos, value)) {
+        return false;
+      }
+    }
+
+    if (_num_elements == _size) {
+      resize(true);
+    }
+
+    if (pos == _num_elements) {
+      ::new (static_cast<void*>(_array + pos)) T(std::forward<U>(value));
+    } else {
+      // Open a hole at pos by shifting the greater elements to the right
+      ::new (static_cast<void*>(_array + _num_elements)) T(std::move(_array[_num_elements - 1]));
+      std::move_backward(_array + pos, _array + _num_elements - 1, _array + _num_elements);
+      _array[pos] = std::forward<U>(value);
+    }
+    ++_num_elements;
+    return true;
+  }
+
+public:
+  /**
+   * @brief Default constructor.
+   *
+   * Initializes a new, empty SortedSet.
+   *
+   * @post _array == nullptr
+   * @post _size == 0
+   * @post _num_elements == 0
+  */
+  SortedSet() : _array(nullptr), _size(0), _num_elements(0) {}
+
+  /**
+   * @brief Copy constructor.
+   *
+   * Creates a new SortedSet by copying the elements from another SortedSet.
+   *
+   * @param other SortedSet from which to copy the elements.
+   *
+   * @throw Allocation exception.
+  */
+  SortedSet(const SortedSet& other)
+    : _array(nullptr), _size(0), _num_elements(0), _less(other._less) {
+    try {
+      _array = detail::allocate<T>(other._size);
+      _size = other._size;
+
+      detail::copy_construct(other._array, other._array + other._num_elements, _array);
+      _num_elements = other._num_elements;
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in copy constructor: " << e.what() << '\n';
+      empty(); // Clean up array in case of exception
+      throw;
+    }
+  }
+
+  /**
+   * @brief Assignment operator.
+   *
+   * Creates a copy of the 'other' SortedSet and then swaps its contents with
+   * this SortedSet.
+   *
+   * @param other The SortedSet object to be copied.
+   *
+   * @return A reference to this SortedSet after the assignment.
+   *
+   * @throw Allocation exception.
+  */
+  SortedSet& operator=(const SortedSet& other) {
+    if (&other != this) {
+      SortedSet tmp(other);
+      this->swap(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move constructor.
+   *
+   * Creates a new SortedSet by taking over the array of another SortedSet,
+   * without copying any element.
+   *
+   * @param other SortedSet from which to take the elements.
+   *
+   * @post other is empty.
+  */
+  SortedSet(SortedSet&& other) noexcept
+    : _array(nullptr), _size(0), _num_elements(0), _less(other._less) {
+    this->swap(other);
+  }
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * Releases the elements of this SortedSet and takes over the array of
+   * 'other', without copying any element.
+   *
+   * @param other The SortedSet from which to take the elements.
+   *
+   * @return A reference to this SortedSet after the assignment.
+   *
+   * @post other is empty.
+  */
+  SortedSet& operator=(SortedSet&& other) noexcept {
+    if (&other != this) {
+      empty();
+      this->swap(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Destructor.
+   *
+   * Safely deallocates the dynamic memory used by the SortedSet. Utilizes the
+   * empty() function to do so.
+  */
+  ~SortedSet() {
+    empty();
+  }
+
+  /**
+   * @brief Empties the SortedSet.
+   *
+   * Safely deallocates the dynamic memory used by the SortedSet.
+   *
+   * @post The internal array memory has been deallocated.
+   * @post _array == nullptr
+   * @post _num_elements = 0
+   * @post _size = 0
+  */
+  void empty(void) {
+    detail::destroy(_array, _array + _num_elements);
+    detail::deallocate(_array, _size);
+    _array = nullptr;
+    _num_elements = 0;
+    _size = 0;
+  }
+
+  /**
+   * @brief Swap function.
+   *
+   * @param other The SortedSet instance to swap states with the current
+   * instance.
+  */
+  void swap(SortedSet& other) {
+    std::swap(_num_elements, other._num_elements);
+    std::swap(_size, other._size);
+    std::swap(_array, other._array);
+    std::swap(_less, other._less);
+  }
+
+  /**
+   * @brief Adds a new element to the SortedSet.
+   *
+   * Inserts the value in its sorted position if it is not already present,
+   * shifting the greater elements one position to the right. Adding an
+   * element greater than every other one (as the merges do) only appends it.
+   *
+   * @param value The element of type T to be added to the SortedSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+   *
+   * @note If an exception is thrown during resizing, the state of SortedSet
+   * hasn't been changed yet, mantaining the SortedSet in a consistent state.
+  */
+  bool add(const T& value) {
+    return insert(value);
+  }
+
+  /**
+   * @brief Adds a new element to the SortedSet, moving it.
+   *
+   * Same as add(const T&), but the value is moved into the array instead of
+   * being copied. If the value is already contained, it is left untouched.
+   *
+   * @param value The element of type T to be moved into the SortedSet.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  bool add(T&& value) {
+    return insert(std::move(value));
+  }
+
+  /**
+   * @brief Builds an element from the given arguments and adds it to the
+   * SortedSet.
+   *
+   * @param args Arguments forwarded to the constructor of T.
+   *
+   * @return true if the element was added, false if it is already contained.
+  */
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    return insert(std::move(value));
+  }
+
+  /**
+   * @brief Removes an element from the SortedSet.
+   *
+   * If the value is present, the greater elements are shifted one position to
+   * the left, preserving the order. The SortedSet is resized if it becomes
+   * significantly underutilized as a result of the removal.
+   *
+   * @param value The element of type T to be removed from the SortedSet.
+   *
+   * @return true if the element was removed, false if it is not contained.
+   *
+   * @note If an exception is thrown during resizing, the element will still
+   * be removed, but the internal array may not be resized.
+  */
+  bool remove(const T& value) {
+    size_t pos = lower_bound(value);
+    if (!found(pos, value)) {
+      return false;
+    }
+
+    std::move(_array + pos + 1, _array + _num_elements, _array + pos);
+    --_num_elements;
+    _array[_num_elements].~T();
+
+    if (_num_elements <= _size / 4) {
+      resize(false);
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Accesses the element at the specified index.
+   *
+   * Elements are indexed in ascending order.
+   *
+   * @param index The index of the element to access.
+   *
+   * @return A const reference to the element at the specified index.
+   *
+   * @throw std::out_of_range If the index is out of the bounds of the
+   * SortedSet.
+  */
+  const T& operator[](int index) const {
+    if (index < 0 || static_cast<size_t>(index) >= _num_elements) {
+      throw std::out_of_range("Index out of range");
+    }
+    return _array[index];
+  }
+
+  /**
+   * @brief Checks if the SortedSet contains a specific element.
+   *
+   * Performs a binary search of the value in the sorted array.
+   *
+   * @param value The element to search for in the SortedSet.
+   *
+   * @return true if the element is found in the SortedSet, false otherwise.
+  */
+  bool contains(const T& value) const {
+    return found(lower_bound(value), value);
+  }
+
+  /**
+   * Returns the number of elements stored inside of the SortedSet
+   *
+   * @return number of elements stored inside of the SortedSet
+  */
+  size_t getNumElements() const {
+    return _num_elements;
+  }
+
+  /**
+   * @brief Returns the comparator of the SortedSet.
+   *
+   * @return A copy of the Less functor.
+  */
+  Less less() const {
+    return _less;
+  }
+
+  /**
+   * @brief Constant forward iterator for the SortedSet class.
+   *
+   * This iterator provides read-only access to the elements of the SortedSet,
+   * in ascending order.
+  */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category; ///< Category of the iterator
+    typedef T value_type; ///< Type of elements pointed to by the iterator
+    typedef ptrdiff_t difference_type; ///< Type to represent the difference between two iterators
+    typedef const T* pointer; ///< Pointer to the constant element type
+    typedef const T& reference; ///< Reference to the constant element type
+
+    /**
+     * @brief Default constructor.
+     *
+     * Initializes the iterator to a null pointer.
+    */
+    const_iterator() : _ptr(nullptr) {}
+
+    /**
+     * @brief Copy constructor.
+     *
+     * @param other Another const_iterator to be copied.
+    */
+    const_iterator(const const_iterator &other) : _ptr(other._ptr) {}
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @param other Another const_iterator to be assigned from.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator=(const const_iterator &other) {
+      _ptr = other._ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Destructor.
+    */
+    ~const_iterator() {}
+
+    /**
+     * @brief Dereference operator.
+     *
+     * @return A reference to the element pointed to by the iterator.
+    */
+    reference operator*() const { return *_ptr; }
+
+    /**
+     * @brief Arrow operator.
+     *
+     * @return A pointer to the element pointed to by the iterator.
+    */
+    pointer operator->() const { return _ptr; }
+
+    /**
+     * @brief Prefix increment operator.
+     *
+     * @return Reference to the updated iterator.
+    */
+    const_iterator& operator++() {
+      ++_ptr;
+      return *this;
+    }
+
+    /**
+     * @brief Postfix increment operator.
+     *
+     * @return Copy of the original iterator.
+    */
+    const_iterator operator++(int) {
+      const_iterator temp = *this;
+      ++(*this);
+      return temp;
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if both iterators point to same element, false otherwise.
+    */
+    bool operator==(const const_iterator &other) const {
+      return _ptr == other._ptr;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     *
+     * @param other Another const_iterator to compare with.
+     *
+     * @return True if iterators point to different element, false otherwise.
+    */
+    bool operator!=(const const_iterator &other) const {
+      return _ptr != other._ptr;
+    }
+
+  private:
+    pointer _ptr; ///< Pointer to the current element in the SortedSet.
+
+    friend class SortedSet; ///< Allow SortedSet class to access private constructor.
+
+    /**
+     * @brief Constructor for internal use by the SortedSet class.
+     *
+     * @param ptr Pointer to the current element in the SortedSet.
+    */
+    const_iterator(pointer ptr) : _ptr(ptr) {}
+
+  }; //const_iterator class
+
+  /**
+   * @brief Returns an iterator to the smallest element of the SortedSet.
+   *
+   * @return A const_iterator to the first element of the SortedSet.
+  */
+  const_iterator begin() const {
+    return const_iterator(_array);
+  }
+
+  /**
+   * @brief Returns an iterator to the end of the SortedSet.
+   *
+   * @return A const_iterator to the element following the last element of the
+   * SortedSet.
+  */
+  const_iterator end() const {
+    return const_iterator(_array + _num_elements);
+  }
+
+  /**
+   * Constructor that creates a SortedSet from a range defined by two
+   * iterators.
+   *
+   * The elements are appended unsorted, then sorted once and deduplicated
+   * (keeping the first occurrence), which takes O(n log n) instead of the
+   * O(n^2) of adding them one at a time in random order.
+   *
+   * @param begin Iterator pointing to the beginning of the range.
+   * @param end Iterator pointing to the end of the range.
+  */
+  template <typename IteratorQ>
+  SortedSet(IteratorQ begin, IteratorQ end) : _array(nullptr), _size(0), _num_elements(0) {
+    try {
+      for (IteratorQ it = begin; it != end; ++it) {
+        if (_num_elements == _size) {
+          resize(true);
+        }
+        ::new (static_cast<void*>(_array + _num_elements)) T(*it);
+        ++_num_elements;
+      }
+
+      std::stable_sort(_array, _array + _num_elements, _less);
+
+      size_t last = 0;
+      for (size_t i = 1; i < _num_elements; ++i) {
+        if (_less(_array[last], _array[i])) {
+          ++last;
+          if (last != i) _array[last] = std::move(_array[i]);
+        }
+      }
+      if (_num_elements > 0) {
+        detail::destroy(_array + last + 1, _array + _num_elements);
+        _num_elements = last + 1;
+      }
+    } catch (const std::exception& e) {
+      empty();
+      std::cerr << "Exception caught in range constructor: " << e.what() << '\n';
+      throw;
+    }
+  }
+
+  /**
+   * @brief Stream operator for the SortedSet class.
+   *
+   * The output format is the same of Set, with the elements in ascending
+   * order: the output of two equal SortedSets is always the same.
+   *
+   * @param os The output stream to which the SortedSet data will be sent.
+   * @param set The SortedSet object to be output.
+   *
+   * @return std::ostream& The modified output stream with the SortedSet data.
+  */
+  inline friend std::ostream& operator<<(std::ostream& os, const SortedSet& set) {
+    os << set._num_elements;
+    for (size_t i = 0; i < set._num_elements; ++i) {
+      os << " (" << set._array[i] << ")";
+    }
+    return os;
+  }
+
+  /**
+   * @brief Equality operator for SortedSet.
+   *
+   * Two SortedSets are equal if they contain the same elements. Since both
+   * arrays are sorted, the elements are compared pairwise in linear time.
+   *
+   * @param other The SortedSet to compare with.
+   *
+   * @return True if the SortedSets contain the same elements, false otherwise.
+  */
+  bool operator==(const SortedSet& other) const {
+    if (_num_elements != other._num_elements) return false;
+
+    for (size_t i = 0; i < _num_elements; ++i) {
+      if (_less(_array[i], other._array[i]) || _less(other._array[i], _array[i])) return false;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * @brief Filters elements of a SortedSet, based on a predicate.
+ *
+ * The elements are visited in ascending order, so each of them is appended
+ * to the new SortedSet without searching its position.
+ *
+ * @param S The original SortedSet from which elements are filtered.
+ * @param P The predicate function that decides whether an element should be
+ *          included in the new SortedSet.
+ *
+ * @return A new SortedSet containing elements that satisfy the predicate P.
+*/
+template <typename T, typename Less, typename Predicate>
+SortedSet<T, Less> filter_out(const SortedSet<T, Less>& S, Predicate P) {
+  SortedSet<T, Less> new_set;
+  try {
+    for (typename SortedSet<T, Less>::const_iterator it = S.begin(); it != S.end(); ++it) {
+      if (P(*it)) {
+        new_set.add(*it);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in filter_out: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the addition operator to concatenate two SortedSets.
+ *
+ * Computes the union of 'a' and 'b' by merging the two sorted arrays in
+ * O(|a| + |b|) time. Every element is appended to the result in ascending
+ * order, and an element present in both sets is taken from 'a'.
+ *
+ * @param a The first SortedSet to be concatenated.
+ * @param b The second SortedSet to be concatenated.
+ *
+ * @return A new SortedSet containing all elements from both 'a' and 'b', with
+ * duplicates removed.
+*/
+template <typename T, typename Less>
+SortedSet<T, Less> operator+(const SortedSet<T, Less>& a, const SortedSet<T, Less>& b) {
+  SortedSet<T, Less> new_set;
+  Less less = a.less();
+  try {
+    typename SortedSet<T, Less>::const_iterator ia = a.begin(), ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+      if (less(*ia, *ib)) {
+        new_set.add(*ia++);
+      } else if (less(*ib, *ia)) {
+        new_set.add(*ib++);
+      } else {
+        new_set.add(*ia++);
+        ++ib;
+      }
+    }
+    for (; ia != a.end(); ++ia) new_set.add(*ia);
+    for (; ib != b.end(); ++ib) new_set.add(*ib);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in operator+: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the intersection of two SortedSets.
+ *
+ * Computes the intersection of 'a' and 'b' by merging the two sorted arrays
+ * in O(|a| + |b|) time. The common elements are taken from 'a'.
+ *
+ * @param a The first SortedSet to intersect.
+ * @param b The second SortedSet to intersect.
+ *
+ * @return A new SortedSet containing the intersection of 'a' and 'b'.
+*/
+template <typename T, typename Less>
+SortedSet<T, Less> intersection(const SortedSet<T, Less>& a, const SortedSet<T, Less>& b) {
+  SortedSet<T, Less> new_set;
+  Less less = a.less();
+  try {
+    typename SortedSet<T, Less>::const_iterator ia = a.begin(), ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+      if (less(*ia, *ib)) {
+        ++ia;
+      } else if (less(*ib, *ia)) {
+        ++ib;
+      } else {
+        new_set.add(*ia++);
+        ++ib;
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in intersection: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Overloads the subtraction operator to calculate the intersection of
+ * two SortedSets.
+ *
+ * Same as intersection(a, b).
+ *
+ * @param a The first SortedSet to intersect.
+ * @param b The second SortedSet to intersect.
+ *
+ * @return A new SortedSet containing the intersection of 'a' and 'b'.
+ *
+ * @note Despite the operator, this is not the set difference: see
+ * difference().
+*/
+template <typename T, typename Less>
+SortedSet<T, Less> operator-(const SortedSet<T, Less>& a, const SortedSet<T, Less>& b) {
+  return intersection(a, b);
+}
+
+/**
+ * @brief Computes the difference of two SortedSets.
+ *
+ * Merges the two sorted arrays in O(|a| + |b|) time, keeping the elements of
+ * 'a' that are not contained in 'b'.
+ *
+ * @param a The SortedSet whose elements are kept.
+ * @param b The SortedSet whose elements are removed.
+ *
+ * @return A new SortedSet containing a \ b.
+*/
+template <typename T, typename Less>
+SortedSet<T, Less> difference(const SortedSet<T, Less>& a, const SortedSet<T, Less>& b) {
+  SortedSet<T, Less> new_set;
+  Less less = a.less();
+  try {
+    typename SortedSet<T, Less>::const_iterator ia = a.begin(), ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+      if (less(*ia, *ib)) {
+        new_set.add(*ia++);
+      } else if (less(*ib, *ia)) {
+        ++ib;
+      } else {
+        ++ia;
+        ++ib;
+      }
+    }
+    for (; ia != a.end(); ++ia) new_set.add(*ia);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Computes the symmetric difference of two SortedSets.
+ *
+ * Merges the two sorted arrays in O(|a| + |b|) time, keeping the elements
+ * contained in exactly one of them.
+ *
+ * @param a The first SortedSet.
+ * @param b The second SortedSet.
+ *
+ * @return A new SortedSet containing (a \ b) U (b \ a).
+*/
+template <typename T, typename Less>
+SortedSet<T, Less> symmetric_difference(const SortedSet<T, Less>& a, const SortedSet<T, Less>& b) {
+  SortedSet<T, Less> new_set;
+  Less less = a.less();
+  try {
+    typename SortedSet<T, Less>::const_iterator ia = a.begin(), ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+      if (less(*ia, *ib)) {
+        new_set.add(*ia++);
+      } else if (less(*ib, *ia)) {
+        new_set.add(*ib++);
+      } else {
+        ++ia;
+        ++ib;
+      }
+    }
+    for (; ia != a.end(); ++ia) new_set.add(*ia);
+    for (; ib != b.end(); ++ib) new_set.add(*ib);
+  } catch (const std::exception& e) {
+    std::cerr << "Exception caught in symmetric_difference: " << e.what() << '\n';
+    new_set.empty();
+    throw;
+  }
+  return new_set;
+}
+
+/**
+ * @brief Saves the contents of a SortedSet to a file.
+ *
+ * The SortedSet is output using the overriden 'operator<<', so the file
+ * lists the elements in ascending order and two saves of equal SortedSets
+ * produce identical files.
+ *
+ * @param set The SortedSet to be saved to the file.
+ * @param filename The name of the file to which the SortedSet's contents will
+ *                 be saved.
+ *
+ * @note The function does not return a value or throw exceptions, but it
+ * reports to stderr if the file cannot be opened.
+*/
+template <typename Less>
+void save(const SortedSet<std::string, Less>& set, const std::string& filename) {
+  std::ofstream outFile(filename);
+
+  if (!outFile.is_open()) {
+    std::cerr << "Failed to open file: " << filename << std::endl;
+    return;
+  }
+
+  outFile << set;
+
+  outFile.close();
+}
+
+#endif // SORTED_SET_HPP